@@ -0,0 +1,308 @@
+#pragma once
+
+// CPU encoder of the BCn block compressed formats: each 4x4 block of texels
+// is stored as two endpoint colors and an index per texel into the palette
+// interpolated between them.
+//   BC1: RGB, 8 bytes per block (1/8 of RGBA8)
+//   BC3: RGB as BC1 plus an 8 byte alpha block (1/4 of RGBA8)
+//   BC7: RGBA, 16 bytes per block; only mode 6 (one pair of RGBA
+//        endpoints, 16 palette entries), which suits smooth photographs
+// The endpoints are the extremes of the texels along their principal axis.
+// The nearest palette entry of the texels is searched 4 texels at a time
+// with SSE2, and the rows of blocks are encoded in parallel.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Parallel.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLOCK_COMPRESSION_SSE2 1
+#else
+#define BLOCK_COMPRESSION_SSE2 0
+#endif
+
+enum class BlockFormat { BC1, BC3, BC7 };
+
+inline size_t BlockBytes(BlockFormat format) {
+	return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+// the 16 texels of a block, one array per channel
+struct TexelBlock {
+	alignas(16) float c[4][16];
+};
+
+// Index of the nearest palette entry of each texel, the channels weighted
+// by weights (0 leaves a channel out)
+inline void SelectIndices(const TexelBlock &block, const float (*palette)[4], int paletteSize,
+						  const float weights[4], uint8_t indices[16]) {
+#if BLOCK_COMPRESSION_SSE2
+	for (int i = 0; i < 16; i += 4) {
+		__m128 best = _mm_set1_ps(3.4e38f);
+		__m128i bestIndex = _mm_setzero_si128();
+		for (int k = 0; k < paletteSize; k++) {
+			__m128 distance = _mm_setzero_ps();
+			for (int ch = 0; ch < 4; ch++) {
+				if (weights[ch] == 0.0f) continue;
+				__m128 d = _mm_sub_ps(_mm_load_ps(&block.c[ch][i]), _mm_set1_ps(palette[k][ch]));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_mul_ps(d, d), _mm_set1_ps(weights[ch])));
+			}
+			__m128 closer = _mm_cmplt_ps(distance, best);
+			best = _mm_min_ps(distance, best);
+			__m128i mask = _mm_castps_si128(closer);
+			bestIndex = _mm_or_si128(_mm_and_si128(mask, _mm_set1_epi32(k)), _mm_andnot_si128(mask, bestIndex));
+		}
+		alignas(16) int32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i *>(lanes), bestIndex);
+		for (int j = 0; j < 4; j++) {
+			indices[i + j] = static_cast<uint8_t>(lanes[j]);
+		}
+	}
+#else
+	for (int i = 0; i < 16; i++) {
+		float best = 3.4e38f;
+		for (int k = 0; k < paletteSize; k++) {
+			float distance = 0.0f;
+			for (int ch = 0; ch < 4; ch++) {
+				float d = block.c[ch][i] - palette[k][ch];
+				distance += d * d * weights[ch];
+			}
+			if (distance < best) {
+				best = distance;
+				indices[i] = static_cast<uint8_t>(k);
+			}
+		}
+	}
+#endif
+}
+
+// Extremes of the texels along their principal axis, over the first
+// channels channels
+inline void PrincipalEndpoints(const TexelBlock &block, int channels, float e0[4], float e1[4]) {
+	float mean[4] = {}, lo[4], hi[4];
+	for (int ch = 0; ch < channels; ch++) {
+		lo[ch] = hi[ch] = block.c[ch][0];
+		for (int i = 0; i < 16; i++) {
+			mean[ch] += block.c[ch][i];
+			lo[ch] = std::min(lo[ch], block.c[ch][i]);
+			hi[ch] = std::max(hi[ch], block.c[ch][i]);
+		}
+		mean[ch] /= 16.0f;
+	}
+
+	float covariance[4][4] = {};
+	for (int i = 0; i < 16; i++) {
+		for (int a = 0; a < channels; a++) {
+			for (int b = a; b < channels; b++) {
+				covariance[a][b] += (block.c[a][i] - mean[a]) * (block.c[b][i] - mean[b]);
+			}
+		}
+	}
+	for (int a = 0; a < channels; a++) {
+		for (int b = 0; b < a; b++) covariance[a][b] = covariance[b][a];
+	}
+
+	// power iteration, from the diagonal of the bounding box
+	float axis[4] = {};
+	for (int ch = 0; ch < channels; ch++) axis[ch] = hi[ch] - lo[ch];
+	for (int iteration = 0; iteration < 8; iteration++) {
+		float next[4] = {}, length = 0.0f;
+		for (int a = 0; a < channels; a++) {
+			for (int b = 0; b < channels; b++) next[a] += covariance[a][b] * axis[b];
+			length = std::max(length, std::abs(next[a]));
+		}
+		if (length == 0.0f) break;
+		for (int a = 0; a < channels; a++) axis[a] = next[a] / length;
+	}
+	float axisLength2 = 0.0f;
+	for (int ch = 0; ch < channels; ch++) axisLength2 += axis[ch] * axis[ch];
+	if (axisLength2 == 0.0f) {
+		for (int ch = 0; ch < channels; ch++) e0[ch] = e1[ch] = mean[ch];
+		return;
+	}
+
+	float tMin = 3.4e38f, tMax = -3.4e38f;
+	for (int i = 0; i < 16; i++) {
+		float t = 0.0f;
+		for (int ch = 0; ch < channels; ch++) t += (block.c[ch][i] - mean[ch]) * axis[ch];
+		tMin = std::min(tMin, t);
+		tMax = std::max(tMax, t);
+	}
+	for (int ch = 0; ch < channels; ch++) {
+		e0[ch] = std::min(std::max(mean[ch] + axis[ch] * tMax / axisLength2, 0.0f), 255.0f);
+		e1[ch] = std::min(std::max(mean[ch] + axis[ch] * tMin / axisLength2, 0.0f), 255.0f);
+	}
+}
+
+inline uint16_t PackRGB565(const float c[4]) {
+	int r = static_cast<int>(std::lround(c[0] * 31.0f / 255.0f));
+	int g = static_cast<int>(std::lround(c[1] * 63.0f / 255.0f));
+	int b = static_cast<int>(std::lround(c[2] * 31.0f / 255.0f));
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+inline void UnpackRGB565(uint16_t v, float c[4]) {
+	int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+	c[0] = static_cast<float>((r << 3) | (r >> 2));
+	c[1] = static_cast<float>((g << 2) | (g >> 4));
+	c[2] = static_cast<float>((b << 3) | (b >> 2));
+	c[3] = 255.0f;
+}
+
+// BC1 color block, always in the 4 color mode (the only one of BC3)
+inline void EncodeBC1Block(const TexelBlock &block, uint8_t out[8]) {
+	float e0[4], e1[4];
+	PrincipalEndpoints(block, 3, e0, e1);
+	uint16_t c0 = PackRGB565(e0), c1 = PackRGB565(e1);
+	uint32_t bits = 0;
+	if (c0 != c1) {
+		if (c0 < c1) std::swap(c0, c1);
+		// the palette order is c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+		float palette[4][4];
+		UnpackRGB565(c0, palette[0]);
+		UnpackRGB565(c1, palette[1]);
+		for (int ch = 0; ch < 4; ch++) {
+			palette[2][ch] = (2.0f * palette[0][ch] + palette[1][ch]) / 3.0f;
+			palette[3][ch] = (palette[0][ch] + 2.0f * palette[1][ch]) / 3.0f;
+		}
+		static const float RGB[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+		uint8_t indices[16];
+		SelectIndices(block, palette, 4, RGB, indices);
+		for (int i = 0; i < 16; i++) bits |= uint32_t(indices[i]) << (2 * i);
+	}
+	memcpy(out, &c0, 2);
+	memcpy(out + 2, &c1, 2);
+	memcpy(out + 4, &bits, 4);
+}
+
+// BC3 (BC4) alpha block in the 8 value mode: a0 > a1
+inline void EncodeAlphaBlock(const TexelBlock &block, uint8_t out[8]) {
+	float lo = 255.0f, hi = 0.0f;
+	for (int i = 0; i < 16; i++) {
+		lo = std::min(lo, block.c[3][i]);
+		hi = std::max(hi, block.c[3][i]);
+	}
+	uint8_t a0 = static_cast<uint8_t>(std::lround(hi)), a1 = static_cast<uint8_t>(std::lround(lo));
+	uint64_t bits = 0;
+	if (a0 != a1) {
+		float palette[8][4] = {};
+		palette[0][3] = a0;
+		palette[1][3] = a1;
+		for (int k = 1; k < 7; k++) {
+			palette[k + 1][3] = ((7 - k) * a0 + k * a1) / 7.0f;
+		}
+		static const float ALPHA[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		uint8_t indices[16];
+		SelectIndices(block, palette, 8, ALPHA, indices);
+		for (int i = 0; i < 16; i++) bits |= uint64_t(indices[i]) << (3 * i);
+	}
+	out[0] = a0;
+	out[1] = a1;
+	for (int i = 0; i < 6; i++) out[2 + i] = static_cast<uint8_t>(bits >> (8 * i));
+}
+
+inline void EncodeBC3Block(const TexelBlock &block, uint8_t out[16]) {
+	EncodeAlphaBlock(block, out);
+	EncodeBC1Block(block, out + 8);
+}
+
+// BC7 mode 6: RGBA endpoints of 7 bits plus a shared low bit each, 4 bit indices
+inline void EncodeBC7Block(const TexelBlock &block, uint8_t out[16]) {
+	float e[2][4];
+	PrincipalEndpoints(block, 4, e[0], e[1]);
+
+	// the low bit of each endpoint that reconstructs it best
+	int q[2][4], p[2];
+	for (int j = 0; j < 2; j++) {
+		float bestError = 3.4e38f;
+		for (int bit = 0; bit < 2; bit++) {
+			int c[4];
+			float error = 0.0f;
+			for (int ch = 0; ch < 4; ch++) {
+				c[ch] = std::min(std::max(static_cast<int>(std::lround((e[j][ch] - bit) / 2.0f)), 0), 127);
+				float d = static_cast<float>((c[ch] << 1) | bit) - e[j][ch];
+				error += d * d;
+			}
+			if (error < bestError) {
+				bestError = error;
+				p[j] = bit;
+				memcpy(q[j], c, sizeof(c));
+			}
+		}
+	}
+
+	static const int WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+	float palette[16][4];
+	for (int k = 0; k < 16; k++) {
+		for (int ch = 0; ch < 4; ch++) {
+			int v0 = (q[0][ch] << 1) | p[0], v1 = (q[1][ch] << 1) | p[1];
+			palette[k][ch] = static_cast<float>(((64 - WEIGHTS[k]) * v0 + WEIGHTS[k] * v1 + 32) >> 6);
+		}
+	}
+	static const float RGBA[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	uint8_t indices[16];
+	SelectIndices(block, palette, 16, RGBA, indices);
+
+	// the high bit of the first index is implicitly 0: swap the endpoints
+	if (indices[0] >= 8) {
+		std::swap(q[0], q[1]);
+		std::swap(p[0], p[1]);
+		for (int i = 0; i < 16; i++) indices[i] = static_cast<uint8_t>(15 - indices[i]);
+	}
+
+	uint8_t bytes[16] = {};
+	int position = 0;
+	auto put = [&](uint32_t value, int count) {
+		for (int b = 0; b < count; b++, position++) {
+			bytes[position >> 3] |= static_cast<uint8_t>(((value >> b) & 1) << (position & 7));
+		}
+	};
+	put(1 << 6, 7);
+	for (int ch = 0; ch < 4; ch++) {
+		put(q[0][ch], 7);
+		put(q[1][ch], 7);
+	}
+	put(p[0], 1);
+	put(p[1], 1);
+	put(indices[0], 3);
+	for (int i = 1; i < 16; i++) put(indices[i], 4);
+	memcpy(out, bytes, 16);
+}
+
+// An RGBA8 image as rows of blocks, the blocks past the right or bottom edge
+// filled by repeating the last column or row
+inline void CompressImage(const uint8_t *pixels, uint32_t width, uint32_t height, BlockFormat format, uint8_t *out) {
+	uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	size_t blockBytes = BlockBytes(format);
+
+	ParallelFor(blocksY, [&](size_t begin, size_t end) {
+		TexelBlock block;
+		for (size_t by = begin; by < end; by++) {
+			for (uint32_t bx = 0; bx < blocksX; bx++) {
+				for (int i = 0; i < 16; i++) {
+					uint32_t x = std::min(bx * 4 + (i & 3), width - 1);
+					uint32_t y = std::min(static_cast<uint32_t>(by) * 4 + (i >> 2), height - 1);
+					const uint8_t *texel = &pixels[(size_t(y) * width + x) * 4];
+					for (int ch = 0; ch < 4; ch++) block.c[ch][i] = texel[ch];
+				}
+				uint8_t *destination = &out[(by * blocksX + bx) * blockBytes];
+				switch (format) {
+				case BlockFormat::BC1: EncodeBC1Block(block, destination); break;
+				case BlockFormat::BC3: EncodeBC3Block(block, destination); break;
+				case BlockFormat::BC7: EncodeBC7Block(block, destination); break;
+				}
+			}
+		}
+	}, 4);
+}
+
+inline std::vector<uint8_t> CompressImage(const uint8_t *pixels, uint32_t width, uint32_t height, BlockFormat format) {
+	std::vector<uint8_t> out(size_t((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format));
+	CompressImage(pixels, width, height, format, out.data());
+	return out;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+// Clustered forward lighting: the view frustum is split in a grid of froxels
+// (screen tiles x exponential depth slices) and every froxel gets the list of
+// the lights whose sphere of influence touches it. The fragment shader then
+// loops only over the lights of its froxel (see shaders/shader.frag).
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Parallel.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLUSTER_SSE2 1
+#include <emmintrin.h>
+#else
+#define CLUSTER_SSE2 0
+#endif
+
+const uint32_t CLUSTER_GRID_X = 16;
+const uint32_t CLUSTER_GRID_Y = 9;
+const uint32_t CLUSTER_GRID_Z = 24;
+const uint32_t CLUSTER_COUNT = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+const uint32_t MAX_LIGHTS = 1024;
+const uint32_t MAX_CLUSTER_LIGHT_INDICES = 1 << 18;
+
+enum LightType { LIGHT_POINT = 0, LIGHT_SPOT = 1 };
+
+// std430 layout of the lights storage buffer
+struct GpuLight {
+	glm::vec4 positionRange;		// world position, range (no contribution beyond it)
+	glm::vec4 colorType;			// color, LightType
+	glm::vec4 directionCosOuter;	// spot only: direction, cosine of the outer cone
+	glm::vec4 params;				// spot only: cosine of the inner cone; g, decay, 1 if shadowed by the shadow map
+};
+
+// lights of cluster i: indices[offset, offset + count)
+struct ClusterRange {
+	uint32_t offset;
+	uint32_t count;
+};
+
+struct LightClusters {
+	std::vector<ClusterRange> ranges;
+	std::vector<uint32_t> indices;
+	double buildMs = 0.0;			// time taken by the last build()
+	uint64_t droppedIndices = 0;	// over MAX_CLUSTER_LIGHT_INDICES, in the last build()
+
+	float nearPlane = 0.0f;
+	float farPlane = 0.0f;
+
+	// froxel bounds in view space, cluster i = (z * CLUSTER_GRID_Y + y) * CLUSTER_GRID_X + x
+	std::vector<glm::vec3> boundsMin;
+	std::vector<glm::vec3> boundsMax;
+
+	// lights touching the depth slice, as structure of arrays padded to 4
+	struct Slice {
+		std::vector<float> x, y, z, radius2;
+		std::vector<uint32_t> light;
+		std::vector<uint32_t> indices;
+		std::vector<uint32_t> counts;
+	};
+	std::vector<Slice> slices;
+
+	float fovY = 0.0f, aspect = 0.0f;
+
+	// recomputes the froxels only if the projection changed
+	void setProjection(float fovy, float aspectRatio, float znear, float zfar) {
+		if (fovy == fovY && aspectRatio == aspect && znear == nearPlane && zfar == farPlane) return;
+		fovY = fovy;
+		aspect = aspectRatio;
+		nearPlane = znear;
+		farPlane = zfar;
+
+		float tanY = tan(fovy * 0.5f);
+		float tanX = tanY * aspectRatio;
+		boundsMin.resize(CLUSTER_COUNT);
+		boundsMax.resize(CLUSTER_COUNT);
+		for (uint32_t z = 0; z < CLUSTER_GRID_Z; z++) {
+			float d0 = sliceDepth(z), d1 = sliceDepth(z + 1);
+			for (uint32_t y = 0; y < CLUSTER_GRID_Y; y++) {
+				for (uint32_t x = 0; x < CLUSTER_GRID_X; x++) {
+					glm::vec3 mn(INFINITY), mx(-INFINITY);
+					for (int corner = 0; corner < 8; corner++) {
+						float ndcX = 2.0f * (x + (corner & 1)) / CLUSTER_GRID_X - 1.0f;
+						float ndcY = 2.0f * (y + ((corner >> 1) & 1)) / CLUSTER_GRID_Y - 1.0f;
+						float d = corner & 4 ? d1 : d0;
+						// the projection is flipped for Vulkan: +y in NDC is down
+						glm::vec3 p(ndcX * d * tanX, -ndcY * d * tanY, -d);
+						mn = glm::min(mn, p);
+						mx = glm::max(mx, p);
+					}
+					uint32_t i = (z * CLUSTER_GRID_Y + y) * CLUSTER_GRID_X + x;
+					boundsMin[i] = mn;
+					boundsMax[i] = mx;
+				}
+			}
+		}
+	}
+
+	float sliceDepth(uint32_t z) const {
+		return nearPlane * pow(farPlane / nearPlane, float(z) / CLUSTER_GRID_Z);
+	}
+
+	// multiplies log(depth / near) to get the slice, in the shader
+	float depthSliceScale() const {
+		return CLUSTER_GRID_Z / log(farPlane / nearPlane);
+	}
+
+	void build(const std::vector<GpuLight> &lights, const glm::mat4 &view) {
+		auto start = std::chrono::high_resolution_clock::now();
+		slices.resize(CLUSTER_GRID_Z);
+
+		std::vector<glm::vec3> centers(lights.size());
+		for (size_t l = 0; l < lights.size(); l++) {
+			centers[l] = glm::vec3(view * glm::vec4(glm::vec3(lights[l].positionRange), 1.0f));
+		}
+
+		// one depth slice per task: the slices write disjoint clusters
+		ParallelFor(CLUSTER_GRID_Z, [&](size_t begin, size_t end) {
+			for (size_t z = begin; z < end; z++) {
+				buildSlice(static_cast<uint32_t>(z), lights, centers);
+			}
+		});
+
+		// the clusters of a slice are contiguous, so are their index lists
+		ranges.resize(CLUSTER_COUNT);
+		indices.clear();
+		droppedIndices = 0;
+		uint32_t cluster = 0;
+		for (const Slice &s : slices) {
+			size_t next = 0;
+			for (uint32_t count : s.counts) {
+				uint32_t kept = static_cast<uint32_t>(std::min<size_t>(count,
+						MAX_CLUSTER_LIGHT_INDICES - indices.size()));
+				ranges[cluster++] = { static_cast<uint32_t>(indices.size()), kept };
+				indices.insert(indices.end(), s.indices.begin() + next, s.indices.begin() + next + kept);
+				droppedIndices += count - kept;
+				next += count;
+			}
+		}
+
+		buildMs = std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void buildSlice(uint32_t z, const std::vector<GpuLight> &lights, const std::vector<glm::vec3> &centers) {
+		Slice &s = slices[z];
+		s.x.clear(); s.y.clear(); s.z.clear(); s.radius2.clear(); s.light.clear();
+		s.indices.clear();
+		s.counts.assign(CLUSTER_GRID_X * CLUSTER_GRID_Y, 0);
+
+		float d0 = sliceDepth(z), d1 = sliceDepth(z + 1);
+		for (size_t l = 0; l < lights.size(); l++) {
+			float r = lights[l].positionRange.w;
+			float depth = -centers[l].z;
+			if (depth + r < d0 || depth - r > d1) continue;
+			s.x.push_back(centers[l].x);
+			s.y.push_back(centers[l].y);
+			s.z.push_back(centers[l].z);
+			s.radius2.push_back(r * r);
+			s.light.push_back(static_cast<uint32_t>(l));
+		}
+		if (s.light.empty()) return;
+		// padding that never passes the test, only in x, y, z and radius2
+		while (s.x.size() % 4 != 0) {
+			s.x.push_back(0.0f); s.y.push_back(0.0f); s.z.push_back(0.0f);
+			s.radius2.push_back(-1.0f);
+		}
+
+		uint32_t first = z * CLUSTER_GRID_X * CLUSTER_GRID_Y;
+		for (uint32_t t = 0; t < CLUSTER_GRID_X * CLUSTER_GRID_Y; t++) {
+			size_t before = s.indices.size();
+			intersect(s, boundsMin[first + t], boundsMax[first + t]);
+			s.counts[t] = static_cast<uint32_t>(s.indices.size() - before);
+		}
+	}
+
+	// appends to s.indices the candidates whose sphere touches the box
+	static void intersect(Slice &s, const glm::vec3 &mn, const glm::vec3 &mx) {
+#if CLUSTER_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 minX = _mm_set1_ps(mn.x), minY = _mm_set1_ps(mn.y), minZ = _mm_set1_ps(mn.z);
+		const __m128 maxX = _mm_set1_ps(mx.x), maxY = _mm_set1_ps(mx.y), maxZ = _mm_set1_ps(mx.z);
+		for (size_t i = 0; i < s.x.size(); i += 4) {
+			__m128 cx = _mm_loadu_ps(&s.x[i]);
+			__m128 cy = _mm_loadu_ps(&s.y[i]);
+			__m128 cz = _mm_loadu_ps(&s.z[i]);
+			// distance from the box along each axis, 0 inside
+			__m128 dx = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minX, cx), _mm_sub_ps(cx, maxX)));
+			__m128 dy = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minY, cy), _mm_sub_ps(cy, maxY)));
+			__m128 dz = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minZ, cz), _mm_sub_ps(cz, maxZ)));
+			__m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			int mask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_loadu_ps(&s.radius2[i])));
+			while (mask != 0) {
+				int lane = 0;
+				while (!(mask & (1 << lane))) lane++;
+				mask &= ~(1 << lane);
+				s.indices.push_back(s.light[i + lane]);
+			}
+		}
+#else
+		for (size_t i = 0; i < s.light.size(); i++) {
+			float dx = std::max(0.0f, std::max(mn.x - s.x[i], s.x[i] - mx.x));
+			float dy = std::max(0.0f, std::max(mn.y - s.y[i], s.y[i] - mx.y));
+			float dz = std::max(0.0f, std::max(mn.z - s.z[i], s.z[i] - mx.z));
+			if (dx * dx + dy * dy + dz * dz <= s.radius2[i]) {
+				s.indices.push_back(s.light[i]);
+			}
+		}
+#endif
+	}
+};
@@ -0,0 +1,277 @@
+#pragma once
+
+// CPU generator of the mip levels of RGBA8 images, used when a texture
+// container is baked (offline with --bake-texture or into the cache on the
+// first load), so it works for every format and needs no blit support.
+// Each level is filtered from the one above it, the colors in linear space
+// when the image is sRGB:
+//   box:    the average of the 2x2 texels above
+//   kaiser: a 6x6 Kaiser windowed sinc, sharper and with less aliasing
+// The filter is separable: the rows of the level above are decoded to
+// linear floats and filtered horizontally (a texel per SSE register), then
+// combined vertically 8 floats at a time with AVX when the CPU has it (4
+// with SSE2). Bands of rows are filtered in parallel.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Parallel.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIP_GENERATOR_SSE2 1
+#else
+#define MIP_GENERATOR_SSE2 0
+#endif
+
+// the default x64 build is SSE2 only: the AVX path is compiled anyway and
+// picked at run time from CPUID
+#if MIP_GENERATOR_SSE2
+#include <immintrin.h>
+#define MIP_GENERATOR_AVX 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MIP_GENERATOR_TARGET_AVX
+#else
+#define MIP_GENERATOR_TARGET_AVX __attribute__((target("avx")))
+#endif
+#else
+#define MIP_GENERATOR_AVX 0
+#endif
+
+enum class MipFilter { Box, Kaiser };
+
+// Parses --mip-filter
+inline bool ParseMipFilter(const std::string &name, MipFilter &filter) {
+	if (name == "box") filter = MipFilter::Box;
+	else if (name == "kaiser") filter = MipFilter::Kaiser;
+	else return false;
+	return true;
+}
+
+inline const char *MipFilterName(MipFilter filter) {
+	return filter == MipFilter::Box ? "box" : "kaiser";
+}
+
+#if MIP_GENERATOR_AVX
+// AVX needs the OS to save the ymm registers too
+inline bool CpuHasAVX() {
+	static const bool supported = [] {
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+		return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#else
+		return __builtin_cpu_supports("avx") != 0;
+#endif
+	}();
+	return supported;
+}
+
+// row[i] += weight * in[i], 8 floats at a time; returns how many it added
+MIP_GENERATOR_TARGET_AVX
+inline size_t MipAccumulateAVX(float *row, const float *in, float weight, size_t floats) {
+	const __m256 w8 = _mm256_set1_ps(weight);
+	size_t i = 0;
+	for (; i + 8 <= floats; i += 8) {
+		_mm256_storeu_ps(&row[i], _mm256_add_ps(_mm256_loadu_ps(&row[i]), _mm256_mul_ps(w8, _mm256_loadu_ps(&in[i]))));
+	}
+	return i;
+}
+#endif
+
+inline const char *MipGeneratorInstructions() {
+#if MIP_GENERATOR_AVX
+	if (CpuHasAVX()) return "AVX";
+#endif
+	return MIP_GENERATOR_SSE2 ? "SSE2" : "scalar";
+}
+
+// sRGB <-> linear, to filter the texels in linear space
+inline float SrgbToLinear(float c) {
+	return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+inline float LinearToSrgb(float c) {
+	return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+// Weights of the filter taps along one axis, for a level half the size: the
+// texel x of the new level covers the texels 2x and 2x + 1 above, and takes
+// the taps from 2x - first on.
+struct MipKernel {
+	int first;
+	std::vector<float> weights;
+
+	static const MipKernel &get(MipFilter filter) {
+		static const MipKernel box{ 0, { 0.5f, 0.5f } };
+		static const MipKernel kaiser = makeKaiser(3.0f, 4.0f);
+		return filter == MipFilter::Box ? box : kaiser;
+	}
+
+	// sinc with the cutoff of the new level, in a Kaiser window of the given
+	// half width (in texels of the level above) and shape
+	static MipKernel makeKaiser(float width, float alpha) {
+		auto besselI0 = [](float x) {
+			float sum = 1.0f, term = 1.0f;
+			for (int k = 1; k < 20; k++) {
+				term *= (x / (2.0f * k)) * (x / (2.0f * k));
+				sum += term;
+			}
+			return sum;
+		};
+		const float PI = 3.14159265358979f;
+		MipKernel kernel{ static_cast<int>(width) - 1, {} };
+		float total = 0.0f;
+		for (int tap = 0; tap < 2 * static_cast<int>(width); tap++) {
+			// distance from the center of the new texel
+			float d = tap - width + 0.5f;
+			float x = PI * d * 0.5f;
+			float sinc = x == 0.0f ? 1.0f : std::sin(x) / x;
+			float window = besselI0(alpha * std::sqrt(std::max(0.0f, 1.0f - (d / width) * (d / width)))) / besselI0(alpha);
+			kernel.weights.push_back(sinc * window);
+			total += sinc * window;
+		}
+		for (float &w : kernel.weights) w /= total;
+		return kernel;
+	}
+};
+
+// 8 bit <-> float, the colors through the sRGB curve when needed
+struct MipConversion {
+	float toLinear[256];
+	float toFloat[256];
+	uint8_t toSrgb[65536];	// by the linear value * 65535
+
+	static const MipConversion &get() {
+		static const MipConversion conversion;
+		return conversion;
+	}
+
+	MipConversion() {
+		for (int i = 0; i < 256; i++) {
+			toLinear[i] = SrgbToLinear(i / 255.0f);
+			toFloat[i] = i / 255.0f;
+		}
+		for (int i = 0; i < 65536; i++) {
+			toSrgb[i] = static_cast<uint8_t>(std::lround(LinearToSrgb(i / 65535.0f) * 255.0f));
+		}
+	}
+};
+
+// The next mip level of an RGBA8 image, max(1, width / 2) x max(1, height / 2),
+// the texels past the edges clamped. Alpha is always linear.
+inline void GenerateMipLevel(const uint8_t *source, uint32_t width, uint32_t height, uint8_t *destination,
+							 bool srgb, MipFilter filter, bool multithreaded = true) {
+	const MipKernel &kernel = MipKernel::get(filter);
+	const MipConversion &conversion = MipConversion::get();
+	const float *colorToFloat = srgb ? conversion.toLinear : conversion.toFloat;
+	const int taps = static_cast<int>(kernel.weights.size());
+	const uint32_t w = std::max(1u, width / 2), h = std::max(1u, height / 2);
+#if MIP_GENERATOR_AVX
+	const bool avx = CpuHasAVX();
+#endif
+
+	// the texels above each tap of each column
+	std::vector<uint32_t> columns(size_t(w) * taps);
+	for (uint32_t x = 0; x < w; x++) {
+		for (int t = 0; t < taps; t++) {
+			int64_t c = int64_t(2) * x - kernel.first + t;
+			columns[size_t(x) * taps + t] = static_cast<uint32_t>(std::min<int64_t>(std::max<int64_t>(c, 0), width - 1));
+		}
+	}
+
+	ParallelFor(h, [&](size_t begin, size_t end) {
+		// the rows above filtered horizontally, by row modulo the ring size
+		const int RING = 8;
+		std::vector<float> decoded(size_t(width) * 4), ring(size_t(RING) * w * 4), row(size_t(w) * 4);
+		int64_t ringRows[RING];
+		std::fill(ringRows, ringRows + RING, -1);
+
+		auto filterRow = [&](uint32_t y) -> const float * {
+			float *out = &ring[size_t(y % RING) * w * 4];
+			if (ringRows[y % RING] == y) return out;
+			ringRows[y % RING] = y;
+
+			const uint8_t *in = &source[size_t(y) * width * 4];
+			for (uint32_t x = 0; x < width; x++) {
+				decoded[4 * x + 0] = colorToFloat[in[4 * x + 0]];
+				decoded[4 * x + 1] = colorToFloat[in[4 * x + 1]];
+				decoded[4 * x + 2] = colorToFloat[in[4 * x + 2]];
+				decoded[4 * x + 3] = conversion.toFloat[in[4 * x + 3]];
+			}
+			for (uint32_t x = 0; x < w; x++) {
+				const uint32_t *c = &columns[size_t(x) * taps];
+#if MIP_GENERATOR_SSE2
+				__m128 sum = _mm_setzero_ps();
+				for (int t = 0; t < taps; t++) {
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(kernel.weights[t]), _mm_loadu_ps(&decoded[4 * size_t(c[t])])));
+				}
+				_mm_storeu_ps(&out[4 * size_t(x)], sum);
+#else
+				for (int ch = 0; ch < 4; ch++) {
+					float sum = 0.0f;
+					for (int t = 0; t < taps; t++) sum += kernel.weights[t] * decoded[4 * size_t(c[t]) + ch];
+					out[4 * size_t(x) + ch] = sum;
+				}
+#endif
+			}
+			return out;
+		};
+
+		const size_t floats = size_t(w) * 4;
+		for (size_t y = begin; y < end; y++) {
+			std::fill(row.begin(), row.end(), 0.0f);
+			for (int t = 0; t < taps; t++) {
+				int64_t r = int64_t(2) * y - kernel.first + t;
+				const float *in = filterRow(static_cast<uint32_t>(std::min<int64_t>(std::max<int64_t>(r, 0), height - 1)));
+				const float weight = kernel.weights[t];
+				size_t i = 0;
+#if MIP_GENERATOR_AVX
+				if (avx) i = MipAccumulateAVX(row.data(), in, weight, floats);
+#endif
+#if MIP_GENERATOR_SSE2
+				const __m128 w4 = _mm_set1_ps(weight);
+				for (; i + 4 <= floats; i += 4) {
+					_mm_storeu_ps(&row[i], _mm_add_ps(_mm_loadu_ps(&row[i]), _mm_mul_ps(w4, _mm_loadu_ps(&in[i]))));
+				}
+#endif
+				for (; i < floats; i++) row[i] += weight * in[i];
+			}
+
+			// back to 8 bit, clamped (the negative lobes of the Kaiser filter
+			// overshoot near sharp edges)
+			uint8_t *out = &destination[y * w * 4];
+			for (uint32_t x = 0; x < w; x++) {
+				int32_t q[4];
+#if MIP_GENERATOR_SSE2
+				__m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&row[4 * size_t(x)]), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(q), _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(srgb ? 65535.0f : 255.0f))));
+				q[3] = static_cast<int32_t>(std::lround(std::min(std::max(row[4 * size_t(x) + 3], 0.0f), 1.0f) * 255.0f));
+#else
+				for (int ch = 0; ch < 4; ch++) {
+					float v = std::min(std::max(row[4 * size_t(x) + ch], 0.0f), 1.0f);
+					q[ch] = static_cast<int32_t>(std::lround(v * (srgb && ch < 3 ? 65535.0f : 255.0f)));
+				}
+#endif
+				for (int ch = 0; ch < 3; ch++) {
+					out[4 * x + ch] = srgb ? conversion.toSrgb[q[ch]] : static_cast<uint8_t>(q[ch]);
+				}
+				out[4 * x + 3] = static_cast<uint8_t>(q[3]);
+			}
+		}
+	}, multithreaded ? 32 : h);
+}
+
+// Every level of a chain from level 0; levels[i] is where level i goes
+inline void GenerateMipChain(const std::vector<uint8_t *> &levels, uint32_t width, uint32_t height, bool srgb,
+							 MipFilter filter, bool multithreaded = true) {
+	for (size_t level = 1; level < levels.size(); level++) {
+		GenerateMipLevel(levels[level - 1], std::max(1u, width >> (level - 1)), std::max(1u, height >> (level - 1)),
+						 levels[level], srgb, filter, multithreaded);
+	}
+}
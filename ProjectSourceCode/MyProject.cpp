@@ -30,7 +30,13 @@ const float OFFSET_COMPOSITION_Z = 0.0f;
 
 const float FAR_PLANE = 100.0f;
 const float NEAR_PLANE = 0.1f;
+const uint32_t SHADOW_MAP_SIZE = 2048;
+const glm::vec3 SPOTLIGHT_COLOR = glm::vec3(0.9f, 0.9f, 0.9f);
 const float PLANE_SCALE = 15.0f;
+// --boards: copies of the board stacked in columns around the table
+const int MAX_STRESS_BOARDS = 100;		// each object has its own uniform buffers
+const float STRESS_GRID_SPACING = 5.0f;
+const float STRESS_STACK_SPACING = 0.35f;
 
 
 const ModelPreInfo TRAY_MODEL_PRE_INFO = { "models/tray.obj", glm::vec3(-2 - -2.001980, 0 - -0.030329, -2 - -2.116832), glm::vec3(0)};
@@ -216,6 +222,39 @@ const std::string BACKGROUND_TEXTURE_PATH = "textures/background-plane.jpg";
 const std::string WHITE_TEXTURE_PATH = "textures/white.png";
 const std::string SKTBOX_TEXTURE_PATH[6] = { "textures/sky/posx.jpg", "textures/sky/negx.jpg", "textures/sky/posy.jpg", "textures/sky/negy.jpg", "textures/sky/posz.jpg", "textures/sky/negz.jpg" };
 
+// The lighting terms an object uses: it is drawn with the lit variant
+// selected with G, without the terms it does not use
+struct LitMaterial {
+	bool textured = true;
+	bool specular = true;
+};
+
+// the large background plane is matte
+const LitMaterial BACKGROUND_MATERIAL = { true, false };
+
+// Variants of the lit pipeline, selected with the specialization constants
+// of shader.frag (constant_id order): the lighting terms it evaluates and the
+// specular power
+struct LitVariant {
+	std::string name;
+	bool textured;
+	bool lights;		// the spotlight and the other lights of the clusters
+	bool specular;
+	bool hemisphericAmbient;
+
+	std::vector<uint32_t> constants(const LitMaterial &material = LitMaterial()) const {
+		return { textured && material.textured, lights, specular && material.specular, hemisphericAmbient,
+				 SpecializationFloat(150.0f) };
+	}
+};
+
+const std::vector<LitVariant> LIT_VARIANTS = {
+	{ "lit", true, true, true, true },
+	{ "lit untextured", false, true, true, true },
+	{ "lit no specular", true, true, false, true },
+	{ "lit ambient only", true, false, false, false },
+};
+
 const std::vector<Vertex> planeVertices = {
 	{
 		glm::vec3(-1, 0, -1),
@@ -327,8 +366,9 @@ struct GlobalUniformBufferObject {
 	alignas(16) glm::mat4 proj;
 	alignas(16) glm::vec3 ambientLight;
 	alignas(16) glm::vec3 eyePos;
-	alignas(16) glm::vec4 paramDecay;
-	alignas(16) glm::vec3 spotlight_pos;
+	alignas(16) glm::mat4 lightViewProj;	// spotlight shadow map
+	alignas(16) glm::uvec4 clusterGrid;		// clusters along x, y, z; number of lights
+	alignas(16) glm::vec4 clusterParams;	// near plane, depth slice scale, framebuffer size
 };
 
 struct UniformBufferObject {
@@ -336,6 +376,7 @@ struct UniformBufferObject {
 	alignas(16) glm::mat4 normalMatrix;
 	alignas(16) glm::vec4 color;
 	alignas(4) float selected;
+	alignas(4) uint32_t textureIndex;	// slot of the texture in the texture table
 };
 
 struct WireframeGlobalUniformBufferObject {
@@ -354,6 +395,60 @@ struct SkyBoxUniformBufferObject {
 
 
 
+// Mesh for the wireframe pipeline: every triangle gets its own vertices,
+// with their barycentric coordinates in norm, so WireframeShader.frag can draw
+// the edges on filled triangles. The edges between two coplanar triangles
+// (e.g. the diagonal of a square face) are hidden by adding 1 to the
+// coordinate that is 0 along them, so only the outlines are left.
+void MakeWireframeMesh(const std::vector<Vertex> &sourceVertices, const std::vector<uint32_t> &sourceIndices,
+					   std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+	// the loader splits vertices by normal and uv: edges are matched by position
+	auto key = [](const glm::vec3 &p) {
+		return std::make_tuple(std::lround(p.x * 1e4f), std::lround(p.y * 1e4f), std::lround(p.z * 1e4f));
+	};
+	using PositionKey = decltype(key(glm::vec3()));
+	std::map<std::pair<PositionKey, PositionKey>, std::vector<glm::vec3>> edgeNormals;
+
+	size_t triangles = sourceIndices.size() / 3;
+	std::vector<glm::vec3> normals(triangles);
+	for (size_t t = 0; t < triangles; t++) {
+		const glm::vec3 &p0 = sourceVertices[sourceIndices[3 * t]].pos;
+		const glm::vec3 &p1 = sourceVertices[sourceIndices[3 * t + 1]].pos;
+		const glm::vec3 &p2 = sourceVertices[sourceIndices[3 * t + 2]].pos;
+		glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+		// zero area: no normal, its edges are never taken as coplanar
+		if (glm::length(cross) < 1e-12f) continue;
+		normals[t] = glm::normalize(cross);
+		for (int e = 0; e < 3; e++) {
+			PositionKey a = key(sourceVertices[sourceIndices[3 * t + (e + 1) % 3]].pos);
+			PositionKey b = key(sourceVertices[sourceIndices[3 * t + (e + 2) % 3]].pos);
+			edgeNormals[std::minmax(a, b)].push_back(normals[t]);
+		}
+	}
+
+	vertices.clear();
+	indices.clear();
+	for (size_t t = 0; t < triangles; t++) {
+		// edge e is opposite to vertex e
+		glm::vec3 hidden(0.0f);
+		for (int e = 0; e < 3; e++) {
+			PositionKey a = key(sourceVertices[sourceIndices[3 * t + (e + 1) % 3]].pos);
+			PositionKey b = key(sourceVertices[sourceIndices[3 * t + (e + 2) % 3]].pos);
+			const std::vector<glm::vec3> &shared = edgeNormals[std::minmax(a, b)];
+			if (shared.size() == 2 && std::abs(glm::dot(shared[0], shared[1])) > 0.999f) {
+				hidden[e] = 1.0f;
+			}
+		}
+		for (int v = 0; v < 3; v++) {
+			Vertex vertex = sourceVertices[sourceIndices[3 * t + v]];
+			vertex.norm = hidden;
+			vertex.norm[v] += 1.0f;
+			indices.push_back(static_cast<uint32_t>(vertices.size()));
+			vertices.push_back(vertex);
+		}
+	}
+}
+
 // class containing the informations for each model
 class ModelInfo {
 protected:
@@ -368,6 +463,12 @@ public:
 	glm::vec4 color;
 	glm::vec3 offset;
 	glm::vec3 baricenterOffset;
+	uint32_t textureIndex = 0;	// Texture::index of the texture to sample
+	LitMaterial material;
+
+	// bounding box of the vertices, computed on the first use
+	bool localBoundsReady = false;
+	glm::vec3 localMin, localMax;
 
 	ModelInfo() {
 		position = position = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -440,12 +541,54 @@ public:
 			static_cast<uint32_t>(model.indices.size()), 1, 0, 0, 0);
 	}
 
+	// as drawModel, but the instance count comes from the occlusion culling
+	const void drawModelCulled(Pipeline P, VkCommandBuffer commandBuffer, int currentImage, int DSSetIndex,
+							   OcclusionCuller &culler, uint32_t object, bool late) {
+		VkBuffer vertexBuffers[] = { model.vertexBuffer };
+		VkDeviceSize offsets[] = { 0 };
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+		vkCmdBindIndexBuffer(commandBuffer, model.indexBuffer, 0,
+			VK_INDEX_TYPE_UINT32);
+
+		vkCmdBindDescriptorSets(commandBuffer,
+			VK_PIPELINE_BIND_POINT_GRAPHICS,
+			P.pipelineLayout, DSSetIndex, 1, &(DS.descriptorSets[currentImage]),
+			0, nullptr);
+
+		culler.drawIndexed(commandBuffer, currentImage, object, late);
+	}
+
+	// axis aligned box containing the model in world space
+	void worldBounds(glm::vec3 &boundsMin, glm::vec3 &boundsMax) {
+		if (!localBoundsReady) {
+			localMin = glm::vec3(INFINITY);
+			localMax = glm::vec3(-INFINITY);
+			for (const Vertex &v : model.vertices) {
+				localMin = glm::min(localMin, v.pos);
+				localMax = glm::max(localMax, v.pos);
+			}
+			localBoundsReady = true;
+		}
+		glm::mat4 world = makeWorldMatrixEuler();
+		boundsMin = glm::vec3(INFINITY);
+		boundsMax = glm::vec3(-INFINITY);
+		for (int corner = 0; corner < 8; corner++) {
+			glm::vec3 p(corner & 1 ? localMax.x : localMin.x,
+						corner & 2 ? localMax.y : localMin.y,
+						corner & 4 ? localMax.z : localMin.z);
+			glm::vec3 w = glm::vec3(world * glm::vec4(p, 1.0f));
+			boundsMin = glm::min(boundsMin, w);
+			boundsMax = glm::max(boundsMax, w);
+		}
+	}
+
 	const void updateUBO(VkDevice device, uint32_t currentImage) {
 		UniformBufferObject ubo;
 
 		ubo.model = makeWorldMatrixEuler();
 		ubo.color = color;
 		ubo.selected = 0.0f;
+		ubo.textureIndex = textureIndex;
 
 		ubo.normalMatrix = glm::inverse(glm::transpose(glm::mat3(ubo.model)));
 
@@ -498,8 +641,13 @@ public:
 		selected = false;
 	}
 
-	const void drawModel(Pipeline P, VkCommandBuffer commandBuffer, int currentImage, int DSSetIndex) {
-		ModelInfo::drawModel(P, commandBuffer, currentImage, DSSetIndex);
+	// draws the semi-transparent ghost showing where the piece will be placed
+	const void drawPreview(Pipeline P, VkCommandBuffer commandBuffer, int currentImage, int DSSetIndex) {
+		VkBuffer vertexBuffers[] = { model.vertexBuffer };
+		VkDeviceSize offsets[] = { 0 };
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+		vkCmdBindIndexBuffer(commandBuffer, model.indexBuffer, 0,
+			VK_INDEX_TYPE_UINT32);
 
 		vkCmdBindDescriptorSets(commandBuffer,
 			VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -516,6 +664,7 @@ public:
 		ubo.model = makeWorldMatrixEuler();
 		ubo.color = color;
 		ubo.selected = selected ? 1.0f : 0.0f;
+		ubo.textureIndex = textureIndex;
 
 		ubo.normalMatrix = glm::inverse(glm::transpose(glm::mat3(ubo.model)));
 
@@ -536,6 +685,7 @@ public:
 		ubo.color = color;
 		ubo.color.a *= selected && visible ? 0.5f : 0.0f;
 		ubo.selected = 0.0f;
+		ubo.textureIndex = textureIndex;
 
 		ubo.normalMatrix = glm::inverse(glm::transpose(glm::mat3(ubo.model)));
 
@@ -553,6 +703,19 @@ public:
 	}
 };
 
+// State owned by the fixed-rate simulation. Rendering interpolates between
+// the last two ticks, so piece and camera motion do not depend on the frame rate.
+struct PieceState {
+	glm::vec3 position;
+	glm::vec3 eulerRotation;
+};
+
+struct SimulationState {
+	std::vector<PieceState> pieces;
+	glm::vec3 cameraPos;
+	glm::quat cameraQuat;
+};
+
 enum class SelectionState {
 	SELECTION_MODE,
 	TRANSITION,
@@ -576,11 +739,17 @@ class MyProject : public BaseProject {
 	SelectionState selectionMode = SelectionState::SELECTION_MODE;
 	SelectionState nextSelectionMode = SelectionState::SELECTION_MODE;
 
+	// simulation state after the last two ticks
+	SimulationState previousState;
+	SimulationState currentState;
+
+	// camera as seen by the renderer, interpolated between the ticks
 	glm::vec3 cameraPos = glm::vec3(0.0f, 8.0f, 0.0f);
 	// glm::vec3 cameraYPR = glm::vec3(0.0f, -90.0f, 0.0f);
 	glm::quat cameraQuat = glm::rotate(glm::quat(1, 0, 0, 0), glm::radians(90.0f), glm::vec3(1, 0, 0));
 
 	static void pieceMovementKey_callback(MyProject* that, int key, int scancode, int action, int mods) {
+		PROFILE_ZONE("pieceMovementKey_callback");
 		static std::vector<int> modelToSkipIndexes = {};
 
 		if (that->selectionMode == SelectionState::TRANSITION) return;
@@ -590,10 +759,10 @@ class MyProject : public BaseProject {
 				that->setSelectionMode(true);
 			}
 			if (key == GLFW_KEY_R && action == GLFW_RELEASE) {
-				that->piecesModelInfo[that->selectedPieceIndex].eulerRotation.z = 180 - that->piecesModelInfo[that->selectedPieceIndex].eulerRotation.z;
+				that->currentState.pieces[that->selectedPieceIndex].eulerRotation.z = 180 - that->currentState.pieces[that->selectedPieceIndex].eulerRotation.z;
 			}
 			if (key == GLFW_KEY_T && action == GLFW_RELEASE) {
-				that->piecesModelInfo[that->selectedPieceIndex].eulerRotation.y = 180 - that->piecesModelInfo[that->selectedPieceIndex].eulerRotation.y;
+				that->currentState.pieces[that->selectedPieceIndex].eulerRotation.y = 180 - that->currentState.pieces[that->selectedPieceIndex].eulerRotation.y;
 			}
 			return;
 		}
@@ -625,16 +794,15 @@ class MyProject : public BaseProject {
 		}
 
 		int selectedPieceIndex = that->selectedPieceIndex;
-		std::vector<PieceModelInfo> piecesModelInfo = that->piecesModelInfo;
+		const std::vector<PieceState>& pieces = that->currentState.pieces;
 
 		int newSelectedModelIndex = selectedPieceIndex;
 		std::optional<float> minDistance = std::nullopt;
 
-		glm::vec3 selectedModelPosition = piecesModelInfo[selectedPieceIndex].position;
+		glm::vec3 selectedModelPosition = pieces[selectedPieceIndex].position;
 
-		for (int i = 0; i < piecesModelInfo.size(); i++) {
-			PieceModelInfo model = piecesModelInfo[i];
-			glm::vec3 modelPos = model.position;
+		for (int i = 0; i < pieces.size(); i++) {
+			glm::vec3 modelPos = pieces[i].position;
 
 			float angle = atan2(modelPos.z - selectedModelPosition.z, modelPos.x - selectedModelPosition.x);
 
@@ -677,9 +845,12 @@ class MyProject : public BaseProject {
 	DescriptorSetLayout DSLGlobalWireframe;
 
 	// Pipelines [Shader couples]
-	Pipeline P1;
+	PipelineVariants P1;		// see LIT_VARIANTS
+	PipelineVariants PGhost;	// the same variants with blending, for the ghost previews
+	size_t litVariant = 0;
 	Pipeline PSkyBox;
 	Pipeline PWireframe;
+	Pipeline PShadow;
 
 	// Models, textures and Descriptors (values assigned to the uniforms)
 	ModelInfo trayModelInfo;
@@ -696,6 +867,46 @@ class MyProject : public BaseProject {
 	DescriptorSet globalDS;
 	DescriptorSet globalWireframeDS;
 
+	// --boards: they share the models of the board, with their own descriptor sets
+	std::vector<ModelInfo> stressModelInfo;
+	// occlusion culling objects: the pieces, the tray, then stressModelInfo
+	uint32_t trayCullObject() const { return static_cast<uint32_t>(piecesModelInfo.size()); }
+	uint32_t stressFirstCullObject() const { return trayCullObject() + 1; }
+
+	// --cpu-occlusion: result of the last test of each culling object
+	SoftwareOcclusion softwareOcclusion;
+	std::vector<bool> cpuVisible;
+	std::vector<std::pair<uint64_t, double>> softwareOcclusionTimes;	// benchmark only
+
+	// indexes into piecesModelInfo, recomputed every frame in updateDrawOrder
+	struct DrawOrder {
+		std::vector<size_t> opaquePieces;		// front to back
+		std::vector<size_t> previews;			// visible ghosts only, back to front
+
+		bool operator==(const DrawOrder &o) const {
+			return opaquePieces == o.opaquePieces && previews == o.previews;
+		}
+	};
+	DrawOrder drawOrder;
+	bool naiveDrawOrder = false;	// skybox first, unsorted, every ghost drawn (for comparison)
+
+	// what the shadow map depends on: it is rendered again only when this changes
+	struct ShadowKey {
+		std::vector<glm::mat4> casters;
+		glm::mat4 lightViewProj;
+		VisualizationMode mode;
+
+		bool operator==(const ShadowKey &o) const {
+			return casters == o.casters && lightViewProj == o.lightViewProj && mode == o.mode;
+		}
+	};
+	ShadowKey shadowKey;
+
+	// lights[0] is the spotlight, the others are added with --lights
+	std::vector<GpuLight> lights;
+	LightClusters lightClusters;
+	std::vector<std::pair<uint64_t, double>> lightAssignmentTimes;	// benchmark only
+
 
 
 	//DEFAULT FUNCTIONS
@@ -707,48 +918,58 @@ class MyProject : public BaseProject {
 		windowHeight = 600;
 		windowTitle = "Tangram";
 		initialBackgroundColor = {0.0f, 0.0f, 0.0f, 1.0f};
-		
-		// Descriptor pool sizes
-		uniformBlocksInPool = 2 + 1 + 3 * PIECES_MODEL_PRE_INFO.size() + 1 + 1; //2 global + 1 per model (tray, pieces, background, wireframe) and another for each piece + skybox
-		texturesInPool = 4;
-		setsInPool = 2 + 1 + 3 * PIECES_MODEL_PRE_INFO.size() + 1 + 1;
 	}
 
 	// Here you load and setup all your Vulkan objects
 	void localInit() {
 		// Descriptor Layouts [what will be passed to the shaders]
-		DSLglobal.init(this, {
-					// this array contains the binding:
-					// first  element : the binding number
-					// second element : the time of element (buffer or texture)
-					// third  element : the pipeline stage where it will be used
-					{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS}
-				  });
-
-		DSLobj.init(this, {
-					{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS},
-					{1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT}
-			});
-
-		DSLSkyBox.init(this, {
-					{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT},
-					{1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT}
-			});
-
-		DSLWireframe.init(this, {
-					{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS},
-			});
-
-		DSLGlobalWireframe.init(this, {
-					{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS},
-			});
+		// They are read from the SPIR-V of the pipelines that use them:
+		// the set number is the one in the layout(set = ...) of the shaders
+		ShaderReflection litShaders = ShaderReflection::fromFiles("shaders/vert.spv", "shaders/frag.spv");
+		ShaderReflection skyBoxShaders = ShaderReflection::fromFiles("shaders/SkyBoxVert.spv", "shaders/SkyBoxFrag.spv");
+		ShaderReflection wireframeShaders = ShaderReflection::fromFiles("shaders/WireframeVert.spv", "shaders/WireframeFrag.spv");
+
+		DSLglobal.init(this, litShaders, 0);
+		DSLobj.init(this, litShaders, 1);
+		DSLSkyBox.init(this, skyBoxShaders, 0);
+		DSLGlobalWireframe.init(this, wireframeShaders, 0);
+		DSLWireframe.init(this, wireframeShaders, 1);
 
 		// Pipelines [Shader couples]
 		// The last array, is a vector of pointer to the layouts of the sets that will
 		// be used in this pipeline. The first element will be set 0, and so on..
-		P1.init(this, "shaders/vert.spv", "shaders/frag.spv", { &DSLglobal, &DSLobj });
-		PSkyBox.init(this, "shaders/SkyBoxVert.spv", "shaders/SkyBoxFrag.spv", { &DSLSkyBox }, VK_COMPARE_OP_LESS_OR_EQUAL);
-		PWireframe.init(this, "shaders/WireframeVert.spv", "shaders/WireframeFrag.spv", { &DSLGlobalWireframe, &DSLWireframe }, true);
+		PipelineDescription litDescription;
+		litDescription.vertShader = "shaders/vert.spv";
+		litDescription.fragShader = "shaders/frag.spv";
+		litDescription.D = { &DSLglobal, &DSLobj };
+		P1.init(this, litDescription);
+		// the ghosts are blended over the scene and must not hide what is behind them
+		PipelineDescription ghostDescription = litDescription;
+		ghostDescription.blendEnable = true;
+		ghostDescription.depthWrite = false;
+		PGhost.init(this, ghostDescription);
+		for (const LitVariant &v : LIT_VARIANTS) {
+			P1.describe(v.constants());
+			P1.describe(v.constants(BACKGROUND_MATERIAL));
+			PGhost.describe(v.constants());
+		}
+		// drawn last at the far plane, it only shades the pixels nothing else covered
+		PSkyBox.describe(this, "shaders/SkyBoxVert.spv", "shaders/SkyBoxFrag.spv", { &DSLSkyBox }, VK_COMPARE_OP_LESS_OR_EQUAL);
+		PSkyBox.description.depthWrite = false;
+		PWireframe.describe(this, "shaders/WireframeVert.spv", "shaders/WireframeFrag.spv", { &DSLGlobalWireframe, &DSLWireframe }, VK_COMPARE_OP_LESS, true);
+		shadowMap.init(this, SHADOW_MAP_SIZE);
+		PShadow.describe(this, "shaders/ShadowVert.spv", "shaders/ShadowFrag.spv", { &DSLglobal, &DSLobj });
+		PShadow.description.renderPass = shadowMap.renderPass;
+		PShadow.description.depthOnly = true;
+
+		std::vector<Pipeline *> pipelines = P1.all();
+		std::vector<Pipeline *> ghostPipelines = PGhost.all();
+		pipelines.insert(pipelines.end(), ghostPipelines.begin(), ghostPipelines.end());
+		pipelines.push_back(&PSkyBox);
+		pipelines.push_back(&PWireframe);
+		pipelines.push_back(&PShadow);
+		Pipeline::buildAll(this, pipelines);
+		watchShaders(pipelines);
 
 
 		// Models, textures and Descriptors (values assigned to the uniforms)
@@ -766,12 +987,18 @@ class MyProject : public BaseProject {
 
 
 		trayModelInfo = ModelInfo(this, TRAY_MODEL_PRE_INFO);
-		trayModelInfo.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr},
-								{1, TEXTURE, 0, &trayTexture, nullptr} });
+		trayModelInfo.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr} });
+		trayModelInfo.textureIndex = trayTexture.index;
 
 		for (ModelPreInfo mpi : PIECES_MODEL_PRE_INFO)
 		{
-			ModelInfo mi = ModelInfo(this, mpi);
+			Model source;
+			source.loadModel(mpi.path);
+			std::vector<Vertex> vertices;
+			std::vector<uint32_t> indices;
+			MakeWireframeMesh(source.vertices, source.indices, vertices, indices);
+			ModelInfo mi = ModelInfo(this, vertices, indices, mpi.baricenterOffset);
+			mi.offset = mpi.offset;
 			mi.DS.init(this, &DSLWireframe, { {0, UNIFORM, sizeof(WireframeUniformBufferObject), nullptr, nullptr }});
 			piecesWireframeModelInfo.push_back(mi);
 		}
@@ -779,17 +1006,17 @@ class MyProject : public BaseProject {
 		for (ModelPreInfo mpi : PIECES_MODEL_PRE_INFO)
 		{
 			PieceModelInfo mi = PieceModelInfo(this, mpi);
-			mi.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr,nullptr},
-									{1, TEXTURE, 0, &pieceTexture, nullptr} });
-			mi.previewDS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr},
-									{1, TEXTURE, 0, &pieceTexture, nullptr} });
+			mi.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr,nullptr} });
+			mi.previewDS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr} });
+			mi.textureIndex = pieceTexture.index;
 			piecesModelInfo.push_back(mi);
 		}
 
 		//background plane initialization
 		backgroundModelInfo = ModelInfo(this, planeVertices, planeIndices);
-		backgroundModelInfo.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr},
-									{1, TEXTURE, 0, &backgroundTexture, nullptr} });
+		backgroundModelInfo.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr} });
+		backgroundModelInfo.textureIndex = backgroundTexture.index;
+		backgroundModelInfo.material = BACKGROUND_MATERIAL;
 		backgroundModelInfo.position = glm::vec3(0.0f, 0.0f, 0.0f);
 		backgroundModelInfo.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
 		backgroundModelInfo.scale =  PLANE_SCALE * glm::vec3(1.0f, 1.0f, 1.0f);
@@ -811,6 +1038,15 @@ class MyProject : public BaseProject {
 		piecesModelInfo[5].position = glm::vec3(-1.0f, PIECES_BASE_Y, -2.0f);
 		piecesModelInfo[6].position = glm::vec3(0.0f, PIECES_BASE_Y, 1.0f);
 
+		//the simulation starts from the initial positions
+		currentState.pieces.resize(piecesModelInfo.size());
+		for (int i = 0; i < piecesModelInfo.size(); i++) {
+			currentState.pieces[i] = { piecesModelInfo[i].position, piecesModelInfo[i].eulerRotation };
+		}
+		currentState.cameraPos = cameraPos;
+		currentState.cameraQuat = cameraQuat;
+		previousState = currentState;
+
 		/*piecesModelInfo[0].color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
 		piecesModelInfo[1].color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
 		piecesModelInfo[2].color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
@@ -837,6 +1073,17 @@ class MyProject : public BaseProject {
 
 		selectPiece(3);
 
+		createStressBoards(options.stressBoards);
+		if (options.occlusionCulling) {
+			occlusionCuller.init(this, stressFirstCullObject() + static_cast<uint32_t>(stressModelInfo.size()));
+			for (size_t i = 0; i < stressModelInfo.size(); i++) {
+				setCullObject(stressFirstCullObject() + static_cast<uint32_t>(i), stressModelInfo[i]);
+			}
+		}
+		if (options.cpuOcclusion) {
+			cpuVisible.assign(stressFirstCullObject() + stressModelInfo.size(), true);
+		}
+
 
 		globalDS.init(this, &DSLglobal, {
 		// the second parameter, is a pointer to the Uniform Set Layout of this set
@@ -845,9 +1092,15 @@ class MyProject : public BaseProject {
 		// second element : UNIFORM or TEXTURE (an enum) depending on the type
 		// third  element : only for UNIFORMs, the size of the corresponding C++ object
 		// fourth element : only for TEXTUREs, the pointer to the corresponding texture object
-					{0, UNIFORM, sizeof(GlobalUniformBufferObject), nullptr, nullptr}
+					{0, UNIFORM, sizeof(GlobalUniformBufferObject), nullptr, nullptr},
+					{1, SHADOW_MAP, 0, nullptr, nullptr, &shadowMap},
+					{2, STORAGE, sizeof(GpuLight) * MAX_LIGHTS, nullptr, nullptr},
+					{3, STORAGE, sizeof(ClusterRange) * CLUSTER_COUNT, nullptr, nullptr},
+					{4, STORAGE, sizeof(uint32_t) * MAX_CLUSTER_LIGHT_INDICES, nullptr, nullptr},
+					{5, TEXTURE_ARRAY, 0, nullptr, nullptr, nullptr, textureTable}
 				});
-		globalWireframeDS.init(this, &DSLglobal, {
+		createLights(options.extraLights);
+		globalWireframeDS.init(this, &DSLGlobalWireframe, {
 			// the second parameter, is a pointer to the Uniform Set Layout of this set
 			// the last parameter is an array, with one element per binding of the set.
 			// first  elmenet : the binding number
@@ -857,8 +1110,10 @@ class MyProject : public BaseProject {
 						{0, UNIFORM, sizeof(WireframeGlobalUniformBufferObject), nullptr, nullptr}
 			});
 
-		glfwSetWindowUserPointer(window, this);
-		glfwSetKeyCallback(window, key_callback);
+		if (window != nullptr) {
+			glfwSetWindowUserPointer(window, this);
+			glfwSetKeyCallback(window, key_callback);
+		}
 	}
 
 	// Here you destroy all the objects you created!		
@@ -883,10 +1138,17 @@ class MyProject : public BaseProject {
 		}
 
 		backgroundModelInfo.cleanup();
+		for (ModelInfo mi : stressModelInfo)
+		{
+			mi.DS.cleanup(); // the models belong to the board
+		}
 
 		P1.cleanup();
+		PGhost.cleanup();
 		PSkyBox.cleanup();
 		PWireframe.cleanup();
+		PShadow.cleanup();
+		shadowMap.cleanup();
 
 		DSLglobal.cleanup();
 		DSLobj.cleanup();
@@ -894,57 +1156,396 @@ class MyProject : public BaseProject {
 		DSLWireframe.cleanup();
 		DSLGlobalWireframe.cleanup();
 	}
+
+	void recreateDescriptorSets() {
+		globalDS.recreate();
+		globalWireframeDS.recreate();
+
+		skyBoxModelInfo.DS.recreate();
+		trayModelInfo.DS.recreate();
+		for (PieceModelInfo &mi : piecesModelInfo) {
+			mi.DS.recreate();
+			mi.previewDS.recreate();
+		}
+		for (ModelInfo &mi : piecesWireframeModelInfo) {
+			mi.DS.recreate();
+		}
+		backgroundModelInfo.DS.recreate();
+
+		// the stress boards do not move: their buffers are written only here
+		for (ModelInfo &mi : stressModelInfo) {
+			mi.DS.recreate();
+			for (size_t i = 0; i < swapChainImages.size(); i++) {
+				mi.updateUBO(device, static_cast<uint32_t>(i));
+			}
+		}
+	}
 	
+	// the variant of P for the object (see LitMaterial), bound if it is not
+	// the bound one already
+	Pipeline &bindLit(PipelineVariants &P, const ModelInfo &mi, VkCommandBuffer commandBuffer, Pipeline *&bound) {
+		Pipeline &lit = P.get(LIT_VARIANTS[litVariant].constants(mi.material));
+		if (&lit != bound) {
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+					lit.graphicsPipeline);
+			bound = &lit;
+		}
+		return lit;
+	}
+
 	// Here it is the creation of the command buffer:
 	// You send to the GPU all the objects you want to draw,
 	// with their buffers and textures
 	void populateCommandBuffer(VkCommandBuffer commandBuffer, int currentImage) {
-		
-		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-			PSkyBox.graphicsPipeline);
-		skyBoxModelInfo.drawModel(PSkyBox, commandBuffer, currentImage, 0);
+		PROFILE_ZONE("populateCommandBuffer");
 
+		if (naiveDrawOrder) {
+			drawSkyBox(commandBuffer, currentImage);
+		}
 
+		// the GPU scope is named after the variant, to compare their timings
+		const LitVariant &variant = LIT_VARIANTS[litVariant];
+		// with occlusion culling the opaque objects are drawn by populateOccluders
+		if (!occlusionCuller.enabled()) {
+			Pipeline *bound = nullptr;
+			gpuProfiler.beginScope(commandBuffer, currentImage, variant.name);
+			// the variants have the same layout: set 0 stays bound when they change
+			vkCmdBindDescriptorSets(commandBuffer,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				P1.get(variant.constants()).pipelineLayout, 0, 1, &globalDS.descriptorSets[currentImage],
+				0, nullptr);
+
+			// front to back: the pieces in front of the camera fill the depth buffer
+			// first, then the large tray and background only shade what is left
+			for (size_t i : drawOrder.opaquePieces)
+			{
+				if (culledOnCpu(static_cast<uint32_t>(i))) continue;
+				piecesModelInfo[i].drawModel(bindLit(P1, piecesModelInfo[i], commandBuffer, bound), commandBuffer, currentImage, 1);
+			}
+			if (!culledOnCpu(trayCullObject())) {
+				trayModelInfo.drawModel(bindLit(P1, trayModelInfo, commandBuffer, bound), commandBuffer, currentImage, 1);
+			}
+			for (size_t i = 0; i < stressModelInfo.size(); i++)
+			{
+				if (culledOnCpu(stressFirstCullObject() + static_cast<uint32_t>(i))) continue;
+				stressModelInfo[i].drawModel(bindLit(P1, stressModelInfo[i], commandBuffer, bound), commandBuffer, currentImage, 1);
+			}
+			backgroundModelInfo.drawModel(bindLit(P1, backgroundModelInfo, commandBuffer, bound), commandBuffer, currentImage, 1);
+			gpuProfiler.endScope(commandBuffer, currentImage);
+		}
+
+		gpuProfiler.beginScope(commandBuffer, currentImage, "wireframe");
 		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-				P1.graphicsPipeline);
+			PWireframe.graphicsPipeline);
+
 		vkCmdBindDescriptorSets(commandBuffer,
 			VK_PIPELINE_BIND_POINT_GRAPHICS,
-			P1.pipelineLayout, 0, 1, &globalDS.descriptorSets[currentImage],
+			PWireframe.pipelineLayout, 0, 1, &globalWireframeDS.descriptorSets[currentImage],
 			0, nullptr);
+		for (ModelInfo mi : piecesWireframeModelInfo)
+		{
+			mi.drawModel(PWireframe, commandBuffer, currentImage, 1);
+		}
+		gpuProfiler.endScope(commandBuffer, currentImage);
 
-		backgroundModelInfo.drawModel(P1, commandBuffer, currentImage, 1);
-		
-		trayModelInfo.drawModel(P1, commandBuffer, currentImage, 1);
-		for (PieceModelInfo mi : piecesModelInfo)
+		if (!naiveDrawOrder) {
+			drawSkyBox(commandBuffer, currentImage);
+		}
+
+		// transparent pass, after everything opaque, blended back to front
+		Pipeline *boundGhost = nullptr;
+		gpuProfiler.beginScope(commandBuffer, currentImage, "ghost previews");
+		vkCmdBindDescriptorSets(commandBuffer,
+			VK_PIPELINE_BIND_POINT_GRAPHICS,
+			PGhost.get(variant.constants()).pipelineLayout, 0, 1, &globalDS.descriptorSets[currentImage],
+			0, nullptr);
+		for (size_t i : drawOrder.previews)
 		{
-			mi.drawModel(P1, commandBuffer, currentImage, 1);
+			piecesModelInfo[i].drawPreview(bindLit(PGhost, piecesModelInfo[i], commandBuffer, boundGhost), commandBuffer, currentImage, 1);
 		}
+		gpuProfiler.endScope(commandBuffer, currentImage);
+	}
 
-		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-			PWireframe.graphicsPipeline);
+	// Early pass: what was visible in the last frame, and the background, that
+	// is never culled. Late pass: what the Hi-Z test found visible since.
+	void populateOccluders(VkCommandBuffer commandBuffer, int currentImage, bool late) {
+		const LitVariant &variant = LIT_VARIANTS[litVariant];
+		Pipeline *bound = nullptr;
+		gpuProfiler.beginScope(commandBuffer, currentImage, variant.name + (late ? " (late)" : " (early)"));
+		vkCmdBindDescriptorSets(commandBuffer,
+			VK_PIPELINE_BIND_POINT_GRAPHICS,
+			P1.get(variant.constants()).pipelineLayout, 0, 1, &globalDS.descriptorSets[currentImage],
+			0, nullptr);
 
+		for (size_t i : drawOrder.opaquePieces)
+		{
+			piecesModelInfo[i].drawModelCulled(bindLit(P1, piecesModelInfo[i], commandBuffer, bound), commandBuffer, currentImage, 1,
+				occlusionCuller, static_cast<uint32_t>(i), late);
+		}
+		trayModelInfo.drawModelCulled(bindLit(P1, trayModelInfo, commandBuffer, bound), commandBuffer, currentImage, 1,
+			occlusionCuller, trayCullObject(), late);
+		for (size_t i = 0; i < stressModelInfo.size(); i++)
+		{
+			stressModelInfo[i].drawModelCulled(bindLit(P1, stressModelInfo[i], commandBuffer, bound), commandBuffer, currentImage, 1,
+				occlusionCuller, stressFirstCullObject() + static_cast<uint32_t>(i), late);
+		}
+		if (!late) {
+			backgroundModelInfo.drawModel(bindLit(P1, backgroundModelInfo, commandBuffer, bound), commandBuffer, currentImage, 1);
+		}
+		gpuProfiler.endScope(commandBuffer, currentImage);
+	}
+
+	// the pieces and the tray cast the spotlight shadows, the background only receives them
+	void populateShadowCommandBuffer(VkCommandBuffer commandBuffer, int currentImage) {
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+			PShadow.graphicsPipeline);
 		vkCmdBindDescriptorSets(commandBuffer,
 			VK_PIPELINE_BIND_POINT_GRAPHICS,
-			PWireframe.pipelineLayout, 0, 1, &globalDS.descriptorSets[currentImage],
+			PShadow.pipelineLayout, 0, 1, &globalDS.descriptorSets[currentImage],
 			0, nullptr);
-		for (ModelInfo mi : piecesWireframeModelInfo)
+		for (PieceModelInfo mi : piecesModelInfo)
 		{
-			mi.drawModel(PWireframe, commandBuffer, currentImage, 1);
+			mi.drawModel(PShadow, commandBuffer, currentImage, 1);
+		}
+		trayModelInfo.drawModel(PShadow, commandBuffer, currentImage, 1);
+	}
+
+	void drawSkyBox(VkCommandBuffer commandBuffer, int currentImage) {
+		gpuProfiler.beginScope(commandBuffer, currentImage, "skybox");
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+			PSkyBox.graphicsPipeline);
+		skyBoxModelInfo.drawModel(PSkyBox, commandBuffer, currentImage, 0);
+		gpuProfiler.endScope(commandBuffer, currentImage);
+	}
+
+	// Columns of boards (a tray and the seven pieces) on a grid around the
+	// table, for a scene where most objects hide behind others. They do not
+	// move, so their uniform buffers are written once.
+	void createStressBoards(int boards) {
+		std::vector<glm::vec2> cells;
+		for (float x = -2.0f; x <= 2.0f; x++) {
+			for (float z = -2.0f; z <= 2.0f; z++) {
+				glm::vec2 cell = STRESS_GRID_SPACING * glm::vec2(x, z);
+				// leaves the table and the composition free
+				if (glm::length(cell) < 1.0f || glm::length(cell - glm::vec2(OFFSET_COMPOSITION_X, OFFSET_COMPOSITION_Z)) < 2.0f) continue;
+				cells.push_back(cell);
+			}
+		}
+
+		int count = std::min(boards, MAX_STRESS_BOARDS);
+		for (int b = 0; b < count; b++) {
+			glm::vec2 cell = cells[b % cells.size()];
+			glm::vec3 base(cell.x, STRESS_STACK_SPACING * (b / cells.size()), cell.y);
+
+			ModelInfo tray = trayModelInfo;
+			tray.DS = DescriptorSet();
+			tray.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr} });
+			tray.position = base;
+			stressModelInfo.push_back(tray);
+
+			for (PieceModelInfo &piece : piecesModelInfo) {
+				ModelInfo mi = piece;
+				mi.DS = DescriptorSet();
+				mi.DS.init(this, &DSLobj, { {0, UNIFORM, sizeof(UniformBufferObject), nullptr, nullptr} });
+				mi.position = base + piece.position;
+				stressModelInfo.push_back(mi);
+			}
+		}
+
+		for (ModelInfo &mi : stressModelInfo) {
+			for (size_t i = 0; i < swapChainImages.size(); i++) {
+				mi.updateUBO(device, static_cast<uint32_t>(i));
+			}
+		}
+		if (count > 0) {
+			std::cout << "Stress boards: " << count << " (" << stressModelInfo.size() << " objects)\n";
+		}
+	}
+
+	ModelInfo &cullObjectModel(uint32_t object) {
+		if (object < piecesModelInfo.size()) return piecesModelInfo[object];
+		if (object == trayCullObject()) return trayModelInfo;
+		return stressModelInfo[object - stressFirstCullObject()];
+	}
+
+	bool culledOnCpu(uint32_t object) const {
+		return options.cpuOcclusion && !cpuVisible[object];
+	}
+
+	// The background and the trays are rasterized on the CPU, then every
+	// culling object is tested against their depth. The command buffers are
+	// recorded again only when the visible set changes.
+	void updateSoftwareOcclusion(const glm::mat4 &viewProj) {
+		PROFILE_ZONE("updateSoftwareOcclusion");
+		softwareOcclusion.begin(viewProj);
+		softwareOcclusion.addOccluder(backgroundModelInfo.getModel().vertices, backgroundModelInfo.getModel().indices,
+			backgroundModelInfo.makeWorldMatrixEuler());
+		softwareOcclusion.addOccluder(trayModelInfo.getModel().vertices, trayModelInfo.getModel().indices,
+			trayModelInfo.makeWorldMatrixEuler());
+		// every stress board starts with its tray
+		for (size_t i = 0; i < stressModelInfo.size(); i += 1 + piecesModelInfo.size()) {
+			softwareOcclusion.addOccluder(stressModelInfo[i].getModel().vertices, stressModelInfo[i].getModel().indices,
+				stressModelInfo[i].makeWorldMatrixEuler());
+		}
+		softwareOcclusion.rasterize();
+
+		std::vector<bool> visible(cpuVisible.size());
+		for (uint32_t o = 0; o < visible.size(); o++) {
+			glm::vec3 boundsMin, boundsMax;
+			cullObjectModel(o).worldBounds(boundsMin, boundsMax);
+			visible[o] = softwareOcclusion.test(boundsMin, boundsMax) == OcclusionResult::VISIBLE;
+		}
+		if (benchmarkMode) {
+			softwareOcclusionTimes.push_back({ frameCount, softwareOcclusion.rasterizeMs + softwareOcclusion.testMs });
+		}
+
+		if (visible != cpuVisible) {
+			cpuVisible = visible;
+			invalidateCommandBuffers();
+		}
+	}
+
+	void printSoftwareOcclusion() {
+		if (!options.cpuOcclusion) return;
+		std::cout << "CPU occlusion: " << softwareOcclusion.occludedPercent() << "% of "
+				  << softwareOcclusion.tested << " tested objects occluded, "
+				  << softwareOcclusion.outsideView << " outside the view, last frame "
+				  << softwareOcclusion.rasterizeMs << " ms rasterizing, "
+				  << softwareOcclusion.testMs << " ms testing\n";
+	}
+
+	void setCullObject(uint32_t object, ModelInfo &mi) {
+		glm::vec3 boundsMin, boundsMax;
+		mi.worldBounds(boundsMin, boundsMax);
+		occlusionCuller.setObject(object, boundsMin, boundsMax,
+			static_cast<uint32_t>(mi.getModel().indices.size()));
+	}
+
+	// the spotlight (filled every frame by updateUniformBuffer), then extraLights
+	// point lights spread over the table with the colors of the pieces
+	void createLights(int extraLights) {
+		lights.assign(1, GpuLight{});
+		int count = std::min<int>(extraLights, MAX_LIGHTS - 1);
+		for (int i = 0; i < count; i++) {
+			// golden angle spiral
+			float angle = i * 2.39996f;
+			float radius = std::min(1.0f + 0.8f * sqrt((float) i), PLANE_SCALE * 0.9f);
+			glm::vec4 color = piecesModelInfo[i % piecesModelInfo.size()].color;
+
+			GpuLight light{};
+			light.positionRange = glm::vec4(radius * cos(angle), 1.0f + 0.5f * (i % 3), radius * sin(angle), 3.0f);
+			light.colorType = glm::vec4(glm::vec3(color), LIGHT_POINT);
+			light.params = glm::vec4(0.0f, 1.0f, 2.0f, 0.0f);	// -, g, decay, no shadow
+			lights.push_back(light);
+		}
+		std::cout << "Lights: " << lights.size() << "\n";
+	}
+
+	// assigns the lights to the clusters of this frame's view and copies
+	// everything to the storage buffers of the image
+	void updateLightClusters(uint32_t currentImage, GlobalUniformBufferObject &gubo) {
+		PROFILE_ZONE("updateLightClusters");
+		float aspect = swapChainExtent.width / (float)swapChainExtent.height;
+		lightClusters.setProjection(glm::radians(45.0f), aspect, NEAR_PLANE, FAR_PLANE);
+		lightClusters.build(lights, gubo.view);
+		if (benchmarkMode) {
+			lightAssignmentTimes.push_back({ frameCount, lightClusters.buildMs });
+		}
+
+		gubo.clusterGrid = glm::uvec4(CLUSTER_GRID_X, CLUSTER_GRID_Y, CLUSTER_GRID_Z, lights.size());
+		gubo.clusterParams = glm::vec4(NEAR_PLANE, lightClusters.depthSliceScale(),
+			swapChainExtent.width, swapChainExtent.height);
+
+		void* data;
+		vkMapMemory(device, globalDS.uniformBuffersMemory[2][currentImage], 0,
+			sizeof(GpuLight) * lights.size(), 0, &data);
+		memcpy(data, lights.data(), sizeof(GpuLight) * lights.size());
+		vkUnmapMemory(device, globalDS.uniformBuffersMemory[2][currentImage]);
+
+		vkMapMemory(device, globalDS.uniformBuffersMemory[3][currentImage], 0,
+			sizeof(ClusterRange) * CLUSTER_COUNT, 0, &data);
+		memcpy(data, lightClusters.ranges.data(), sizeof(ClusterRange) * CLUSTER_COUNT);
+		vkUnmapMemory(device, globalDS.uniformBuffersMemory[3][currentImage]);
+
+		if (!lightClusters.indices.empty()) {
+			vkMapMemory(device, globalDS.uniformBuffersMemory[4][currentImage], 0,
+				sizeof(uint32_t) * lightClusters.indices.size(), 0, &data);
+			memcpy(data, lightClusters.indices.data(), sizeof(uint32_t) * lightClusters.indices.size());
+			vkUnmapMemory(device, globalDS.uniformBuffersMemory[4][currentImage]);
+		}
+	}
+
+	void addBenchmarkResults(nlohmann::json &results) {
+		std::vector<double> assignment;
+		for (const auto &sample : lightAssignmentTimes) {
+			if (sample.first >= benchmark.warmupFrames) assignment.push_back(sample.second);
+		}
+		results["lights"] = lights.size();
+		results["lightAssignmentMs"] = SummarizeTimes(assignment);
+		results["droppedClusterLightIndices"] = lightClusters.droppedIndices;
+		if (options.cpuOcclusion) {
+			std::vector<double> occlusion;
+			for (const auto &sample : softwareOcclusionTimes) {
+				if (sample.first >= benchmark.warmupFrames) occlusion.push_back(sample.second);
+			}
+			results["softwareOcclusion"] = {
+				{"tested", softwareOcclusion.tested},
+				{"occluded", softwareOcclusion.occluded},
+				{"occludedPercent", softwareOcclusion.occludedPercent()},
+				{"outsideView", softwareOcclusion.outsideView},
+				{"cpuMs", SummarizeTimes(occlusion)}
+			};
+		}
+	}
+
+	void updateShadowKey(const glm::mat4 &lightViewProj) {
+		ShadowKey key;
+		for (PieceModelInfo &mi : piecesModelInfo) {
+			key.casters.push_back(mi.makeWorldMatrixEuler());
+		}
+		key.casters.push_back(trayModelInfo.makeWorldMatrixEuler());
+		key.lightViewProj = lightViewProj;
+		key.mode = visualizationMode;
+
+		if (!(key == shadowKey)) {
+			shadowKey = key;
+			shadowMap.invalidate();
+		}
+	}
+
+	// Sorts the pieces by distance from the camera. The command buffers only
+	// need to be recorded again when the order changes.
+	void updateDrawOrder() {
+		DrawOrder order;
+		bool previewsVisible = selectionMode == SelectionState::TRANSLATION_MODE || selectionMode == SelectionState::TRANSITION;
+		std::vector<float> distance(piecesModelInfo.size());
+		for (size_t i = 0; i < piecesModelInfo.size(); i++) {
+			distance[i] = glm::length(piecesModelInfo[i].baricenterPosition() - cameraPos);
+			order.opaquePieces.push_back(i);
+			if (naiveDrawOrder || (previewsVisible && piecesModelInfo[i].selected)) {
+				order.previews.push_back(i);
+			}
+		}
+		if (!naiveDrawOrder) {
+			std::sort(order.opaquePieces.begin(), order.opaquePieces.end(),
+				[&distance](size_t a, size_t b) { return distance[a] < distance[b]; });
+			std::sort(order.previews.begin(), order.previews.end(),
+				[&distance](size_t a, size_t b) { return distance[a] > distance[b]; });
+		}
+
+		if (!(order == drawOrder)) {
+			drawOrder = order;
+			invalidateCommandBuffers();
 		}
 	}
 
 	// Here is where you update the uniforms.
 	// Very likely this will be where you will be writing the logic of your application.
 	void updateUniformBuffer(uint32_t currentImage) {
-		static auto lastTime = std::chrono::high_resolution_clock::now();
-
-		auto currentTime = std::chrono::high_resolution_clock::now();
-		float dt = std::chrono::duration<float, std::chrono::seconds::period>
-			(currentTime - lastTime).count();
-		lastTime = currentTime;
-
-		if (selectionMode == SelectionState::TRANSLATION_MODE) updateSelectedModelPosition(dt);
-		if (selectionMode == SelectionState::TRANSITION) selectedModelTransition(dt);
+		PROFILE_ZONE("updateUniformBuffer");
+		float alpha = advanceSimulation();
+		applyInterpolatedState(alpha);
+		updateDrawOrder();
 
 		trayModelInfo.updateUBO(device, currentImage);
 		for (PieceModelInfo mi : piecesModelInfo) {
@@ -957,8 +1558,6 @@ class MyProject : public BaseProject {
 		}
 		backgroundModelInfo.updateUBO(device, currentImage);
 
-		updateCameraPos(dt);
-
 		void* data;
 		GlobalUniformBufferObject gubo{};
 		gubo.view = lookIn(cameraPos, cameraQuat);
@@ -975,9 +1574,11 @@ class MyProject : public BaseProject {
 		static const float SPCin = spotlightY / sqrt(spotlightY * spotlightY + 2.3 * 2.3);
 		static const float SPCout = spotlightY / sqrt(spotlightY * spotlightY + 2.8 * 2.8);
 
+		glm::vec4 paramDecay;
+		glm::vec3 spotlightPos;
 		switch (visualizationMode) {
-		case VisualizationMode::SPOTLIGHT_ON_COMPOSITION:
-			gubo.paramDecay = glm::vec4(15.0f, 1.0f, CCin, CCout); //g, decay, Cin, Cout
+		case VisualizationMode::SPOTLIGHT_ON_COMPOSITION: {
+			paramDecay = glm::vec4(15.0f, 1.0f, CCin, CCout); //g, decay, Cin, Cout
 
 			glm::vec3 compositionBaricenterPosition = glm::vec3(0);
 			for (PieceModelInfo pmi : piecesModelInfo) {
@@ -985,16 +1586,34 @@ class MyProject : public BaseProject {
 			}
 			compositionBaricenterPosition /= piecesModelInfo.size();
 
-			gubo.spotlight_pos = glm::vec3(compositionBaricenterPosition.x, spotlightY, compositionBaricenterPosition.z);
+			spotlightPos = glm::vec3(compositionBaricenterPosition.x, spotlightY, compositionBaricenterPosition.z);
 			break;
-		case VisualizationMode::SPOTLIGHT_ON_SELECTED_PIECE:
+		}
+		case VisualizationMode::SPOTLIGHT_ON_SELECTED_PIECE: {
 			glm::vec3 selectedPieceBaricenterPosition = piecesModelInfo[selectedPieceIndex].baricenterPosition();
-			gubo.spotlight_pos = glm::vec3(selectedPieceBaricenterPosition.x, spotlightY, selectedPieceBaricenterPosition.z);
+			spotlightPos = glm::vec3(selectedPieceBaricenterPosition.x, spotlightY, selectedPieceBaricenterPosition.z);
 
-			gubo.paramDecay = glm::vec4(17.0f, 1.0f, SPCin, SPCout); //g, decay, Cin, Cout
+			paramDecay = glm::vec4(17.0f, 1.0f, SPCin, SPCout); //g, decay, Cin, Cout
 
 			break;
 		}
+		}
+
+		// the spotlight points straight down, its frustum just contains the outer cone
+		glm::mat4 lightView = glm::lookAt(spotlightPos, spotlightPos + glm::vec3(0.0f, -1.0f, 0.0f),
+			glm::vec3(0.0f, 0.0f, -1.0f));
+		glm::mat4 lightProj = glm::perspective(2.0f * acos(paramDecay.w) * 1.1f, 1.0f,
+			1.0f, spotlightY + 5.0f);
+		lightProj[1][1] *= -1;
+		gubo.lightViewProj = lightProj * lightView;
+		updateShadowKey(gubo.lightViewProj);
+
+		// the range only has to reach the floor below the spotlight
+		lights[0].positionRange = glm::vec4(spotlightPos, 3.0f * spotlightY);
+		lights[0].colorType = glm::vec4(SPOTLIGHT_COLOR, LIGHT_SPOT);
+		lights[0].directionCosOuter = glm::vec4(0.0f, -1.0f, 0.0f, paramDecay.w);
+		lights[0].params = glm::vec4(paramDecay.z, paramDecay.x, paramDecay.y, 1.0f);
+		updateLightClusters(currentImage, gubo);
 
 
 		vkMapMemory(device, globalDS.uniformBuffersMemory[0][currentImage], 0,
@@ -1002,10 +1621,20 @@ class MyProject : public BaseProject {
 		memcpy(data, &gubo, sizeof(gubo));
 		vkUnmapMemory(device, globalDS.uniformBuffersMemory[0][currentImage]);
 
+		if (occlusionCuller.enabled()) {
+			for (uint32_t o = 0; o < stressFirstCullObject(); o++) {
+				setCullObject(o, cullObjectModel(o));
+			}
+			occlusionCuller.upload(currentImage, gubo.proj * gubo.view);
+		}
+		if (options.cpuOcclusion) {
+			updateSoftwareOcclusion(gubo.proj * gubo.view);
+		}
+
 
 		WireframeGlobalUniformBufferObject wgubo{};
 		wgubo.view = gubo.view;
-		wgubo.proj = gubo.view;
+		wgubo.proj = gubo.proj;
 
 		vkMapMemory(device, globalWireframeDS.uniformBuffersMemory[0][currentImage], 0,
 			sizeof(wgubo), 0, &data);
@@ -1027,32 +1656,101 @@ class MyProject : public BaseProject {
 
 	static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 	{
+		PROFILE_ZONE("key_callback");
 		MyProject* that = static_cast<MyProject*>(glfwGetWindowUserPointer(window));
 
+		// diagnostics, always from the live keyboard
+		if (key == GLFW_KEY_P && action == GLFW_RELEASE) {
+			that->dumpGpuProfile();
+			that->printSoftwareOcclusion();
+		}
+		if (key == GLFW_KEY_F11 && action == GLFW_RELEASE) {
+			cpuTraceEnabled = !cpuTraceEnabled;
+			std::cout << "CPU trace " << (cpuTraceEnabled ? "enabled" : "disabled") << "\n";
+		}
+		if (key == GLFW_KEY_F12 && action == GLFW_RELEASE)
+			CpuTraceDump("cpu_trace.json");
+
+		that->onLiveKeyEvent(key, scancode, action, mods);
+	}
+
+	// game controls, called for live and scripted key events
+	void handleKeyEvent(int key, int scancode, int action, int mods) {
 		if (key == GLFW_KEY_M && action == GLFW_RELEASE) {
-			switch (that->visualizationMode) {
+			switch (visualizationMode) {
 			case VisualizationMode::SPOTLIGHT_ON_COMPOSITION:
-				that->visualizationMode = VisualizationMode::SPOTLIGHT_ON_SELECTED_PIECE;
+				visualizationMode = VisualizationMode::SPOTLIGHT_ON_SELECTED_PIECE;
 				break;
 			case VisualizationMode::SPOTLIGHT_ON_SELECTED_PIECE:
-				that->visualizationMode = VisualizationMode::SPOTLIGHT_ON_COMPOSITION;
+				visualizationMode = VisualizationMode::SPOTLIGHT_ON_COMPOSITION;
 				break;
 			default:
-				that->visualizationMode = VisualizationMode::SPOTLIGHT_ON_COMPOSITION;
+				visualizationMode = VisualizationMode::SPOTLIGHT_ON_COMPOSITION;
 			}
 		}
 
-		pieceMovementKey_callback(that, key, scancode, action, mods);
+		if (key == GLFW_KEY_G && action == GLFW_RELEASE) {
+			litVariant = (litVariant + 1) % LIT_VARIANTS.size();
+			std::cout << "Lit pipeline variant: " << LIT_VARIANTS[litVariant].name << "\n";
+			invalidateCommandBuffers();
+		}
+
+		if (key == GLFW_KEY_N && action == GLFW_RELEASE) {
+			naiveDrawOrder = !naiveDrawOrder;
+			std::cout << "Draw order: " << (naiveDrawOrder ? "naive" : "sorted") << "\n";
+			updateDrawOrder();
+			invalidateCommandBuffers();
+		}
+
+		pieceMovementKey_callback(this, key, scancode, action, mods);
 
 		if (key == GLFW_KEY_0 && action == GLFW_RELEASE)
-			that->selectCompositionWireframe(0);
+			selectCompositionWireframe(0);
 		if (key == GLFW_KEY_1 && action == GLFW_RELEASE)
-			that->selectCompositionWireframe(1);
+			selectCompositionWireframe(1);
 		if (key == GLFW_KEY_2 && action == GLFW_RELEASE)
-			that->selectCompositionWireframe(2);
+			selectCompositionWireframe(2);
 		if (key == GLFW_KEY_3 && action == GLFW_RELEASE)
-			that->selectCompositionWireframe(3);
+			selectCompositionWireframe(3);
+	}
+
+	nlohmann::json benchmarkSceneState() {
+		nlohmann::json pieces = nlohmann::json::array();
+		for (const PieceState& ps : currentState.pieces) {
+			pieces.push_back({
+				{"position", {ps.position.x, ps.position.y, ps.position.z}},
+				{"rotation", {ps.eulerRotation.x, ps.eulerRotation.y, ps.eulerRotation.z}}
+			});
+		}
+		const glm::vec3& camPos = currentState.cameraPos;
+		const glm::quat& camQuat = currentState.cameraQuat;
+		return {
+			{"pieces", pieces},
+			{"selectedPiece", selectedPieceIndex},
+			{"cameraPosition", {camPos.x, camPos.y, camPos.z}},
+			{"cameraRotation", {camQuat.w, camQuat.x, camQuat.y, camQuat.z}}
+		};
+	}
+
+	// one step of the game logic, at the fixed simulation rate
+	void simulationTick(float dt) {
+		previousState = currentState;
+
+		if (selectionMode == SelectionState::TRANSLATION_MODE) updateSelectedModelPosition(dt);
+		if (selectionMode == SelectionState::TRANSITION) selectedModelTransition(dt);
+		updateCameraPos(dt);
+	}
 
+	// moves the rendered pieces and camera between the last two ticks
+	void applyInterpolatedState(float alpha) {
+		for (int i = 0; i < piecesModelInfo.size(); i++) {
+			const PieceState& from = previousState.pieces[i];
+			const PieceState& to = currentState.pieces[i];
+			piecesModelInfo[i].position = glm::mix(from.position, to.position, alpha);
+			piecesModelInfo[i].eulerRotation = glm::mix(from.eulerRotation, to.eulerRotation, alpha);
+		}
+		cameraPos = glm::mix(previousState.cameraPos, currentState.cameraPos, alpha);
+		cameraQuat = glm::slerp(previousState.cameraQuat, currentState.cameraQuat, alpha);
 	}
 
 	void selectCompositionWireframe(int index) {
@@ -1067,7 +1765,7 @@ class MyProject : public BaseProject {
 	void selectPiece(int index) {
 		piecesModelInfo[selectedPieceIndex].selected = false;
 		piecesModelInfo[index].selected = true;
-		selectedModelTargetY = piecesModelInfo[index].position.y;
+		selectedModelTargetY = currentState.pieces[index].position.y;
 		// std::cerr << index;
 		selectedPieceIndex = index;
 	}
@@ -1095,55 +1793,55 @@ class MyProject : public BaseProject {
 		glm::vec3 rot = glm::vec3(0, 0, 0);
 
 		// camera movements controlls
-		if (glfwGetKey(window, GLFW_KEY_LEFT)) {
+		if (isKeyDown(GLFW_KEY_LEFT)) {
 			mov.x -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_RIGHT)) {
+		if (isKeyDown(GLFW_KEY_RIGHT)) {
 			mov.x += 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_DOWN)) {
+		if (isKeyDown(GLFW_KEY_DOWN)) {
 			mov.y -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_UP)) {
+		if (isKeyDown(GLFW_KEY_UP)) {
 			mov.y += 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_Z)) {
+		if (isKeyDown(GLFW_KEY_Z)) {
 			mov.z -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_X)) {
+		if (isKeyDown(GLFW_KEY_X)) {
 			mov.z += 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_J)) {
+		if (isKeyDown(GLFW_KEY_J)) {
 			rot.y -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_L)) {
+		if (isKeyDown(GLFW_KEY_L)) {
 			rot.y += 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_K)) {
+		if (isKeyDown(GLFW_KEY_K)) {
 			rot.x += 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_I)) {
+		if (isKeyDown(GLFW_KEY_I)) {
 			rot.x -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_U)) {
+		if (isKeyDown(GLFW_KEY_U)) {
 			rot.z -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_O)) {
+		if (isKeyDown(GLFW_KEY_O)) {
 			rot.z += 1;
 		}
 
-		glm::mat4 rotMat = glm::inverse(glm::mat4(cameraQuat));
+		glm::mat4 rotMat = glm::inverse(glm::mat4(currentState.cameraQuat));
 		glm::vec3 ux = glm::vec3(rotMat * glm::vec4(1, 0, 0, 1));
 		glm::vec3 uy = glm::vec3(rotMat * glm::vec4(0, 1, 0, 1));
 		glm::vec3 uz = glm::vec3(rotMat * glm::vec4(0, 0, 1, 1));
@@ -1159,9 +1857,12 @@ class MyProject : public BaseProject {
 		//}
 
 
-		if (rot.x != 0) cameraQuat *= glm::rotate(glm::quat(1, 0, 0, 0), angularSpeed * deltaTime * rot.x, ux);
-		if (rot.y != 0) cameraQuat *= glm::rotate(glm::quat(1, 0, 0, 0), angularSpeed * deltaTime * rot.y, uy);
-		if (rot.z != 0) cameraQuat *= glm::rotate(glm::quat(1, 0, 0, 0), angularSpeed * deltaTime * rot.z, uz);
+		glm::quat& simCameraQuat = currentState.cameraQuat;
+		glm::vec3& simCameraPos = currentState.cameraPos;
+
+		if (rot.x != 0) simCameraQuat *= glm::rotate(glm::quat(1, 0, 0, 0), angularSpeed * deltaTime * rot.x, ux);
+		if (rot.y != 0) simCameraQuat *= glm::rotate(glm::quat(1, 0, 0, 0), angularSpeed * deltaTime * rot.y, uy);
+		if (rot.z != 0) simCameraQuat *= glm::rotate(glm::quat(1, 0, 0, 0), angularSpeed * deltaTime * rot.z, uz);
 
 		// if (rot != glm::vec3(0)) cameraQuat *= glm::rotate(glm::quat(1, 0, 0, 0), angularSpeed * deltaTime, rot);
 
@@ -1173,13 +1874,13 @@ class MyProject : public BaseProject {
 		dp += uy * linearSpeed * deltaTime * mov.y;
 		dp += uz * linearSpeed * deltaTime * mov.z;
 
-		cameraPos += dp;
+		simCameraPos += dp;
 
-		if (cameraPos.x < -PLANE_SCALE) cameraPos.x = -PLANE_SCALE;
-		if (cameraPos.x > PLANE_SCALE) cameraPos.x = PLANE_SCALE;
-		if (cameraPos.y < 0.5f) cameraPos.y = 0.5f;
-		if (cameraPos.z < -PLANE_SCALE) cameraPos.z = -PLANE_SCALE;
-		if (cameraPos.z > PLANE_SCALE) cameraPos.z = PLANE_SCALE;
+		if (simCameraPos.x < -PLANE_SCALE) simCameraPos.x = -PLANE_SCALE;
+		if (simCameraPos.x > PLANE_SCALE) simCameraPos.x = PLANE_SCALE;
+		if (simCameraPos.y < 0.5f) simCameraPos.y = 0.5f;
+		if (simCameraPos.z < -PLANE_SCALE) simCameraPos.z = -PLANE_SCALE;
+		if (simCameraPos.z > PLANE_SCALE) simCameraPos.z = PLANE_SCALE;
 	}
 
 	void updateSelectedModelPosition(float deltaTime) {
@@ -1189,48 +1890,48 @@ class MyProject : public BaseProject {
 		glm::vec3 mov = glm::vec3(0, 0, 0);
 		int rot = 0;
 
-		if (glfwGetKey(window, GLFW_KEY_A)) {
+		if (isKeyDown(GLFW_KEY_A)) {
 			mov.x += 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_D)) {
+		if (isKeyDown(GLFW_KEY_D)) {
 			mov.x -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_S)) {
+		if (isKeyDown(GLFW_KEY_S)) {
 			mov.z -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_W)) {
+		if (isKeyDown(GLFW_KEY_W)) {
 			mov.z += 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_E)) {
+		if (isKeyDown(GLFW_KEY_E)) {
 			rot -= 1;
 		}
 
-		if (glfwGetKey(window, GLFW_KEY_Q)) {
+		if (isKeyDown(GLFW_KEY_Q)) {
 			rot += 1;
 		}
 
-		piecesModelInfo[selectedPieceIndex].position += linearSpeed * deltaTime * (-mov);
-		piecesModelInfo[selectedPieceIndex].eulerRotation.x += angularSpeed * deltaTime * rot;
+		currentState.pieces[selectedPieceIndex].position += linearSpeed * deltaTime * (-mov);
+		currentState.pieces[selectedPieceIndex].eulerRotation.x += angularSpeed * deltaTime * rot;
 	}
 
 	void selectedModelTransition(float deltaTime) {
 		static float linearSpeed = 4.0f;
 
-		if (selectedModelTargetY > piecesModelInfo[selectedPieceIndex].position.y) {
-			piecesModelInfo[selectedPieceIndex].position.y += linearSpeed * deltaTime;
-			if (piecesModelInfo[selectedPieceIndex].position.y >= selectedModelTargetY) {
-				piecesModelInfo[selectedPieceIndex].position.y = selectedModelTargetY;// -piecesModelInfo[selectedPieceIndex].offset.y;
+		if (selectedModelTargetY > currentState.pieces[selectedPieceIndex].position.y) {
+			currentState.pieces[selectedPieceIndex].position.y += linearSpeed * deltaTime;
+			if (currentState.pieces[selectedPieceIndex].position.y >= selectedModelTargetY) {
+				currentState.pieces[selectedPieceIndex].position.y = selectedModelTargetY;// -piecesModelInfo[selectedPieceIndex].offset.y;
 				selectionMode = nextSelectionMode;
 			}
 		}
 		else {
-			piecesModelInfo[selectedPieceIndex].position.y -= linearSpeed * deltaTime;
-			if (piecesModelInfo[selectedPieceIndex].position.y <= selectedModelTargetY) {
-				piecesModelInfo[selectedPieceIndex].position.y = selectedModelTargetY;// -piecesModelInfo[selectedPieceIndex].offset.y;
+			currentState.pieces[selectedPieceIndex].position.y -= linearSpeed * deltaTime;
+			if (currentState.pieces[selectedPieceIndex].position.y <= selectedModelTargetY) {
+				currentState.pieces[selectedPieceIndex].position.y = selectedModelTargetY;// -piecesModelInfo[selectedPieceIndex].offset.y;
 				selectionMode = nextSelectionMode;
 			}
 		}
@@ -1245,12 +1946,261 @@ class MyProject : public BaseProject {
 //added rasterizer option to have wireframes in Pieline::init
 
 
+void printUsage(const char* program) {
+	std::cout << "Usage: " << program << " [options]\n"
+			  << "  --headless         render offscreen, without window and swap chain\n"
+			  << "  --frames N         exit after N frames (headless default: 1)\n"
+			  << "  --snapshot FILE    headless only: save the last frame as a PNG\n"
+			  << "  --benchmark FILE   play a scripted timeline of key events with a fixed dt\n"
+			  << "                     and report frame time statistics\n"
+			  << "  --benchmark-out FILE  where to write the results (default: benchmark_results.json)\n"
+			  << "  --sim-hz HZ        rate of the game logic tick (default: 120)\n"
+			  << "  --pipeline-cache FILE  pipeline cache file (default: pipeline_cache.bin)\n"
+			  << "  --no-pipeline-cache    build the pipelines without a cache (cold start)\n"
+			  << "  --lights N         add N point lights to the scene (default: 0)\n"
+			  << "  --boards N         add N copies of the board, for a dense scene (max 100)\n"
+			  << "  --occlusion-culling  skip the objects hidden by others, with a GPU depth pyramid\n"
+			  << "  --cpu-occlusion    skip them with occluders rasterized on the CPU instead\n"
+			  << "  --bench-occlusion  time the CPU occlusion on a synthetic scene and exit\n"
+			  << "  --bake-texture IN OUT  write the texture container of image IN to OUT and exit\n"
+			  << "  --texture-format F     auto (BC1, BC3 with alpha), bc7 or rgba8 (default: auto)\n"
+			  << "  --mip-filter F     box or kaiser, for the mip levels made on the CPU (default: kaiser)\n"
+			  << "  --bench-mips       time the CPU mip generation of a 4096x4096 image and exit\n"
+			  << "  --no-texture-streaming  load every texture completely before the first frame\n";
+}
+
+bool parseRunOptions(int argc, char* argv[], RunOptions& options) {
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--headless") {
+			options.headless = true;
+		} else if (arg == "--frames" && i + 1 < argc) {
+			options.frames = std::atoi(argv[++i]);
+		} else if (arg == "--snapshot" && i + 1 < argc) {
+			options.snapshotFile = argv[++i];
+		} else if (arg == "--benchmark" && i + 1 < argc) {
+			options.benchmarkScript = argv[++i];
+		} else if (arg == "--benchmark-out" && i + 1 < argc) {
+			options.benchmarkOutput = argv[++i];
+		} else if (arg == "--sim-hz" && i + 1 < argc) {
+			options.simulationHz = std::atof(argv[++i]);
+			if (options.simulationHz <= 0.0) {
+				std::cerr << "--sim-hz must be positive\n";
+				return false;
+			}
+		} else if (arg == "--pipeline-cache" && i + 1 < argc) {
+			options.pipelineCacheFile = argv[++i];
+		} else if (arg == "--no-pipeline-cache") {
+			options.pipelineCacheFile.clear();
+		} else if (arg == "--lights" && i + 1 < argc) {
+			options.extraLights = std::atoi(argv[++i]);
+			if (options.extraLights < 0) {
+				std::cerr << "--lights must not be negative\n";
+				return false;
+			}
+		} else if (arg == "--boards" && i + 1 < argc) {
+			options.stressBoards = std::atoi(argv[++i]);
+			if (options.stressBoards < 0) {
+				std::cerr << "--boards must not be negative\n";
+				return false;
+			}
+		} else if (arg == "--occlusion-culling") {
+			options.occlusionCulling = true;
+		} else if (arg == "--cpu-occlusion") {
+			options.cpuOcclusion = true;
+		} else if (arg == "--bench-occlusion") {
+			options.benchOcclusion = true;
+		} else if (arg == "--bake-texture" && i + 2 < argc) {
+			options.bakeTextureSource = argv[++i];
+			options.bakeTextureOutput = argv[++i];
+		} else if (arg == "--no-texture-streaming") {
+			options.textureStreaming = false;
+		} else if (arg == "--texture-format" && i + 1 < argc) {
+			options.textureFormat = argv[++i];
+			TextureEncoding encoding;
+			if (!ParseTextureEncoding(options.textureFormat, encoding)) {
+				std::cerr << "--texture-format must be auto, bc7 or rgba8\n";
+				return false;
+			}
+		} else if (arg == "--mip-filter" && i + 1 < argc) {
+			options.mipFilter = argv[++i];
+			MipFilter filter;
+			if (!ParseMipFilter(options.mipFilter, filter)) {
+				std::cerr << "--mip-filter must be box or kaiser\n";
+				return false;
+			}
+		} else if (arg == "--bench-mips") {
+			options.benchMips = true;
+		} else {
+			std::cerr << "Unknown or incomplete argument: " << arg << "\n";
+			return false;
+		}
+	}
+
+	if (!options.snapshotFile.empty() && !options.headless) {
+		std::cerr << "--snapshot requires --headless\n";
+		return false;
+	}
+	if (options.headless && options.frames <= 0 && options.benchmarkScript.empty()) {
+		options.frames = 1;
+	}
+	return true;
+}
+
+// A box as 8 corners and 12 triangles, for the occlusion benchmark
+struct BenchVertex {
+	glm::vec3 pos;
+};
+
+void AddBox(std::vector<BenchVertex> &vertices, std::vector<uint32_t> &indices, glm::vec3 boundsMin, glm::vec3 boundsMax) {
+	static const uint32_t BOX_INDICES[36] = {
+		0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,  0, 4, 5, 0, 5, 1,
+		2, 3, 7, 2, 7, 6,  0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3
+	};
+	uint32_t first = static_cast<uint32_t>(vertices.size());
+	for (int corner = 0; corner < 8; corner++) {
+		vertices.push_back({ glm::vec3(corner & 1 ? boundsMax.x : boundsMin.x,
+									   corner & 2 ? boundsMax.y : boundsMin.y,
+									   corner & 4 ? boundsMax.z : boundsMin.z) });
+	}
+	for (uint32_t i : BOX_INDICES) {
+		indices.push_back(first + i);
+	}
+}
+
+// --bench-occlusion: columns of boards with 7 blocks on each, seen from
+// above. Times the rasterization single and multithreaded.
+int RunSoftwareOcclusionBenchmark() {
+	const int FRAMES = 200;
+	std::vector<BenchVertex> occluders;
+	std::vector<uint32_t> occluderIndices;
+	std::vector<std::pair<glm::vec3, glm::vec3>> objects;
+	for (float x = -2.0f; x <= 2.0f; x++) {
+		for (float z = -2.0f; z <= 2.0f; z++) {
+			for (int level = 0; level < 4; level++) {
+				glm::vec3 base(STRESS_GRID_SPACING * x, STRESS_STACK_SPACING * level, STRESS_GRID_SPACING * z);
+				glm::vec3 boardMin = base + glm::vec3(-2.0f, 0.0f, -2.0f);
+				glm::vec3 boardMax = base + glm::vec3(2.0f, 0.1f, 2.0f);
+				AddBox(occluders, occluderIndices, boardMin, boardMax);
+				objects.push_back({ boardMin, boardMax });
+				for (int piece = 0; piece < 7; piece++) {
+					glm::vec3 p = base + glm::vec3(-1.5f + 0.5f * piece, 0.1f, -1.0f + 0.3f * piece);
+					objects.push_back({ p, p + glm::vec3(0.8f, 0.125f, 0.8f) });
+				}
+			}
+		}
+	}
+
+	glm::mat4 proj = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, NEAR_PLANE, FAR_PLANE);
+	proj[1][1] *= -1;
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 25.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+
+	std::cout << occluderIndices.size() / 3 << " occluder triangles, " << objects.size() << " objects, "
+			  << FRAMES << " frames, " << std::thread::hardware_concurrency() << " hardware threads\n";
+	for (bool multithreaded : { false, true }) {
+		SoftwareOcclusion occlusion;
+		occlusion.multithreaded = multithreaded;
+		std::vector<double> rasterize, test;
+		for (int frame = 0; frame < FRAMES; frame++) {
+			occlusion.begin(proj * view);
+			occlusion.addOccluder(occluders, occluderIndices, glm::mat4(1.0f));
+			occlusion.rasterize();
+			for (const auto &o : objects) {
+				occlusion.test(o.first, o.second);
+			}
+			rasterize.push_back(occlusion.rasterizeMs);
+			test.push_back(occlusion.testMs);
+		}
+		nlohmann::json r = SummarizeTimes(rasterize), t = SummarizeTimes(test);
+		std::cout << (multithreaded ? "multithreaded: " : "single thread: ")
+				  << "rasterize p50 " << r["p50"].get<double>() << " ms, test p50 " << t["p50"].get<double>()
+				  << " ms, " << occlusion.occludedPercent() << "% occluded, "
+				  << occlusion.outsideView / FRAMES << " objects outside the view\n";
+	}
+	return EXIT_SUCCESS;
+}
+
+// --bench-mips: the whole mip chain of a synthetic 4096x4096 sRGB image
+// (gradients, fine stripes and noise), single and multithreaded, with each
+// filter.
+int RunMipBenchmark() {
+	const uint32_t SIZE = 4096;
+	const int RUNS = 5;
+	uint32_t levelCount = static_cast<uint32_t>(std::floor(std::log2(SIZE))) + 1;
+	std::vector<std::vector<uint8_t>> levels(levelCount);
+	std::vector<uint8_t *> pointers;
+	for (uint32_t level = 0; level < levelCount; level++) {
+		uint32_t size = std::max(1u, SIZE >> level);
+		levels[level].resize(size_t(size) * size * 4);
+		pointers.push_back(levels[level].data());
+	}
+	uint32_t noise = 12345;
+	for (uint32_t y = 0; y < SIZE; y++) {
+		for (uint32_t x = 0; x < SIZE; x++) {
+			noise = noise * 1664525u + 1013904223u;
+			uint8_t *texel = &levels[0][(size_t(y) * SIZE + x) * 4];
+			texel[0] = static_cast<uint8_t>(x * 255 / SIZE);
+			texel[1] = static_cast<uint8_t>((x / 3 + y / 5) % 2 ? 230 : 20);
+			texel[2] = static_cast<uint8_t>(noise >> 24);
+			texel[3] = static_cast<uint8_t>(y * 255 / SIZE);
+		}
+	}
+
+	std::cout << SIZE << "x" << SIZE << " RGBA8 sRGB, " << levelCount << " levels, " << RUNS << " runs, "
+			  << MipGeneratorInstructions() << ", " << std::thread::hardware_concurrency() << " hardware threads\n";
+	for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+		for (bool multithreaded : { false, true }) {
+			std::vector<double> times;
+			for (int run = 0; run < RUNS; run++) {
+				auto start = std::chrono::steady_clock::now();
+				GenerateMipChain(pointers, SIZE, SIZE, true, filter, multithreaded);
+				times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+			}
+			double p50 = SummarizeTimes(times)["p50"].get<double>();
+			std::cout << MipFilterName(filter) << (multithreaded ? ", multithreaded: " : ", single thread: ")
+					  << "p50 " << p50 << " ms, " << levels[0].size() / (p50 * 1000.0) << " MB/s of level 0\n";
+		}
+	}
+	return EXIT_SUCCESS;
+}
+
 // This is the main: probably you do not need to touch this!
-int main() {
+int main(int argc, char* argv[]) {
     MyProject app;
+    RunOptions options;
+
+    CpuTraceSetThreadName("main");
+    InitAssetSearchPaths(argv[0]);
+
+    if (!parseRunOptions(argc, argv, options)) {
+    	printUsage(argv[0]);
+    	return EXIT_FAILURE;
+    }
+    if (options.benchOcclusion) {
+    	return RunSoftwareOcclusionBenchmark();
+    }
+    if (options.benchMips) {
+    	return RunMipBenchmark();
+    }
+    if (!options.bakeTextureSource.empty()) {
+    	try {
+    		TextureEncoding encoding = TextureEncoding::BC;
+    		ParseTextureEncoding(options.textureFormat, encoding);
+    		MipFilter mipFilter = MipFilter::Kaiser;
+    		ParseMipFilter(options.mipFilter, mipFilter);
+    		if (!BakeTextureContainer(options.bakeTextureSource, options.bakeTextureOutput, encoding, mipFilter)) {
+    			std::cerr << "failed to write " << options.bakeTextureOutput << "\n";
+    			return EXIT_FAILURE;
+    		}
+    	} catch (const std::exception& e) {
+    		std::cerr << e.what() << std::endl;
+    		return EXIT_FAILURE;
+    	}
+    	return EXIT_SUCCESS;
+    }
 
     try {
-        app.run();
+        app.run(options);
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
@@ -14,6 +14,19 @@
 #include <algorithm>
 #include <fstream>
 #include <array>
+#include <map>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <bitset>
+#include <future>
+#include <thread>
+#include <filesystem>
+#include <functional>
+#include <tuple>
+#include <condition_variable>
+#include <deque>
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
@@ -31,10 +44,239 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+// to save the frames rendered in headless mode
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <json.hpp>
+
+#include "ClusteredLighting.hpp"
+#include "SoftwareOcclusion.hpp"
+#include "TextureContainer.hpp"
+#include "BlockCompression.hpp"
+#include "MipGenerator.hpp"
+
 //
 
+// CPU instrumentation: PROFILE_ZONE("name") times the enclosing scope into a
+// per-thread ring buffer, dumped as Chrome trace events (chrome://tracing,
+// Perfetto). Building with CPU_TRACE_ENABLED 0 removes the zones entirely;
+// otherwise a disabled zone costs a single relaxed atomic load.
+#ifndef CPU_TRACE_ENABLED
+#define CPU_TRACE_ENABLED 1
+#endif
+
+const int CPU_TRACE_RING_SIZE = 16384;
+
+struct CpuTraceEvent {
+	const char *name;		// must be a string literal
+	uint64_t startNs;
+	uint64_t durationNs;
+};
+
+struct CpuTraceBuffer {
+	uint32_t threadId;
+	std::string name;		// set by CpuTraceSetThreadName, "thread N" otherwise
+	std::atomic<uint64_t> written{0};
+	std::atomic<bool> writing{false};	// only the owner thread sets it: no contention
+	std::array<CpuTraceEvent, CPU_TRACE_RING_SIZE> events;
+};
+
+std::atomic<bool> cpuTraceEnabled{std::getenv("TANGRAM_CPU_TRACE") != nullptr};
+// CpuTraceDump sets cpuTracePaused and waits, buffer by buffer, for the zone
+// being written to finish: the zones that end while it reads are dropped
+std::atomic<bool> cpuTracePaused{false};
+std::mutex cpuTraceBuffersMutex;
+std::vector<std::unique_ptr<CpuTraceBuffer>> cpuTraceBuffers;
+const auto cpuTraceEpoch = std::chrono::steady_clock::now();
+
+uint64_t CpuTraceNow() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - cpuTraceEpoch).count();
+}
+
+// buffers are owned by the registry, so they survive the threads that filled them
+CpuTraceBuffer &CpuTraceThreadBuffer() {
+	thread_local CpuTraceBuffer *buffer = nullptr;
+	if (buffer == nullptr) {
+		std::lock_guard<std::mutex> lock(cpuTraceBuffersMutex);
+		cpuTraceBuffers.push_back(std::make_unique<CpuTraceBuffer>());
+		buffer = cpuTraceBuffers.back().get();
+		buffer->threadId = static_cast<uint32_t>(cpuTraceBuffers.size());
+	}
+	return *buffer;
+}
+
+// names the calling thread in the trace, once, e.g. at the start of main
+void CpuTraceSetThreadName(const std::string &name) {
+	CpuTraceBuffer &buffer = CpuTraceThreadBuffer();
+	std::lock_guard<std::mutex> lock(cpuTraceBuffersMutex);
+	buffer.name = name;
+}
+
+struct CpuTraceZone {
+	const char *name;
+	uint64_t start;
+	bool active;
+
+	CpuTraceZone(const char *zoneName) {
+		name = zoneName;
+		active = cpuTraceEnabled.load(std::memory_order_relaxed);
+		if (active) start = CpuTraceNow();
+	}
+
+	~CpuTraceZone() {
+		if (!active) return;
+		uint64_t end = CpuTraceNow();
+		CpuTraceBuffer &buffer = CpuTraceThreadBuffer();
+		// seq_cst store then load, against the same pair in CpuTraceDump:
+		// either the dump sees writing, or this zone sees the pause
+		buffer.writing.store(true);
+		if (!cpuTracePaused.load()) {
+			uint64_t n = buffer.written.load(std::memory_order_relaxed);
+			buffer.events[n % CPU_TRACE_RING_SIZE] = { name, start, end - start };
+			buffer.written.store(n + 1, std::memory_order_release);
+		}
+		buffer.writing.store(false, std::memory_order_release);
+	}
+};
+
+#if CPU_TRACE_ENABLED
+#define PROFILE_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) CpuTraceZone PROFILE_ZONE_CONCAT(cpuTraceZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+// Writes the content of all the ring buffers as a Chrome trace-event file.
+// The other threads keep running: the zones they end during the dump are dropped.
+void CpuTraceDump(const std::string &file) {
+	nlohmann::json events = nlohmann::json::array();
+	size_t count = 0;
+	cpuTracePaused = true;
+	{
+		std::lock_guard<std::mutex> lock(cpuTraceBuffersMutex);
+		for (const auto &buffer : cpuTraceBuffers) {
+			while (buffer->writing.load()) {
+				std::this_thread::yield();
+			}
+			events.push_back({
+				{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", buffer->threadId},
+				{"args", {{"name", buffer->name.empty() ? "thread " + std::to_string(buffer->threadId) : buffer->name}}}
+			});
+
+			uint64_t written = buffer->written.load(std::memory_order_acquire);
+			uint64_t first = written > CPU_TRACE_RING_SIZE ? written - CPU_TRACE_RING_SIZE : 0;
+			for (uint64_t i = first; i < written; i++) {
+				const CpuTraceEvent &e = buffer->events[i % CPU_TRACE_RING_SIZE];
+				events.push_back({
+					{"name", e.name}, {"cat", "cpu"}, {"ph", "X"},
+					{"ts", e.startNs / 1000.0}, {"dur", e.durationNs / 1000.0},
+					{"pid", 1}, {"tid", buffer->threadId}
+				});
+				count++;
+			}
+		}
+	}
+	cpuTracePaused = false;
+
+	nlohmann::json trace;
+	trace["traceEvents"] = events;
+	trace["displayTimeUnit"] = "ms";
+
+	std::ofstream out(file);
+	if (!out.is_open()) {
+		std::cout << "failed to open " << file << "\n";
+		return;
+	}
+	out << trace.dump() << "\n";
+	std::cout << count << " CPU trace zones written to " << file << "\n";
+}
+
+// Asset files: shaders are compiled into the executable (EMBED_SHADERS, see
+// shaders/embed_shaders.py); everything else, or a shader when it is not
+// embedded, is searched in the working directory, then next to the
+// executable and in its parents, then in $TANGRAM_ASSET_DIR.
+#ifndef EMBED_SHADERS
+#define EMBED_SHADERS 1
+#endif
+
+#if EMBED_SHADERS
+#include "shaders/EmbeddedShaders.hpp"
+#endif
+
+const int ASSET_PARENT_LEVELS = 3;	// e.g. the Visual Studio x64/Debug output folders
+
+std::vector<std::filesystem::path> assetSearchPaths = { "" };
+
+void InitAssetSearchPaths(const char *argv0) {
+	std::error_code ec;
+	std::filesystem::path dir = std::filesystem::absolute(argv0, ec).parent_path();
+	for (int i = 0; !ec && i <= ASSET_PARENT_LEVELS && !dir.empty(); i++) {
+		assetSearchPaths.push_back(dir);
+		if (dir == dir.parent_path()) break;
+		dir = dir.parent_path();
+	}
+	if (const char *assetDir = std::getenv("TANGRAM_ASSET_DIR")) {
+		assetSearchPaths.push_back(assetDir);
+	}
+}
+
+// the first existing file among the search paths, or the path unchanged
+std::string ResolveAssetPath(const std::string &path) {
+	std::error_code ec;
+	for (const auto &root : assetSearchPaths) {
+		std::filesystem::path candidate = root / path;
+		if (std::filesystem::is_regular_file(candidate, ec)) {
+			return candidate.string();
+		}
+	}
+	return path;
+}
+
+bool FindEmbeddedFile(const std::string &path, const char *&data, size_t &size) {
+#if EMBED_SHADERS
+	for (const embedded::File &f : embedded::FILES) {
+		if (path == f.path) {
+			data = reinterpret_cast<const char *>(f.data);
+			size = f.size;
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
+// embedded data first (unless onlyFiles, e.g. to reload an edited shader),
+// then the search paths
+std::vector<char> ReadAssetFile(const std::string &path, bool onlyFiles = false) {
+	const char *data;
+	size_t size;
+	if (!onlyFiles && FindEmbeddedFile(path, data, size)) {
+		return std::vector<char>(data, data + size);
+	}
+
+	std::ifstream file(ResolveAssetPath(path), std::ios::ate | std::ios::binary);
+	if (!file.is_open()) {
+		throw std::runtime_error("failed to open file " + path + "!");
+	}
+	size_t fileSize = (size_t) file.tellg();
+	std::vector<char> buffer(fileSize);
+	file.seekg(0);
+	file.read(buffer.data(), fileSize);
+	return buffer;
+}
+
 const int MAX_FRAMES_IN_FLIGHT = 2;
 
+// at most this many simulation ticks per frame: after a long stall the
+// simulation slows down instead of spiraling trying to catch up
+const int MAX_SIMULATION_STEPS_PER_FRAME = 8;
+
+// offscreen color targets used in place of the swap chain in headless mode
+const int HEADLESS_IMAGE_COUNT = MAX_FRAMES_IN_FLIGHT + 1;
+
 // Lesson 22.0
 const std::vector<const char*> validationLayers = {
 	"VK_LAYER_KHRONOS_validation"
@@ -195,14 +437,54 @@ struct Model {
 	void cleanup();
 };
 
+// the levels of a texture in a staging buffer, ready to be copied to its image
+struct TextureUpload {
+	TextureContainerHeader header{};
+	std::vector<TextureContainerLevel> levels;
+	VkBuffer stagingBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE;
+	bool baked = false;				// decoded from the source images, the container was missing
+	double encodeMs = 0.0;
+	uint64_t encodedBytes = 0;
+};
+
+// a descriptor sampling a texture, rewritten when a streamed texture is complete
+struct TextureBinding {
+	VkDescriptorSet set;
+	uint32_t binding;
+	uint32_t arrayElement;
+	uint32_t image;		// swap chain image the set is used with
+};
+
+// largest side of the placeholder shown while a texture streams in
+const uint32_t TEXTURE_PLACEHOLDER_SIZE = 16;
+
+// size of the texture table of the lit shaders (textures[] in shader.frag):
+// each 2D texture gets a slot when created, and each object picks its own
+// by index, in its uniform buffer
+const uint32_t MAX_TEXTURES = 16;
+
 struct Texture {
 	BaseProject *BP;
 	uint32_t mipLevels;
+	VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
 	VkImage textureImage;
 	VkDeviceMemory textureImageMemory;
 	VkImageView textureImageView;
 	VkSampler textureSampler;
+	std::vector<TextureBinding> bindings;
+	uint32_t index;		// slot in the texture table
 	
+	// One layer per file, from their container (made if missing). The
+	// placeholder is the levels of the container up to
+	// TEXTURE_PLACEHOLDER_SIZE, or a gray texel when there is none yet.
+	static TextureUpload prepareUpload(BaseProject *bp, const std::vector<std::string> &files, bool placeholder);
+	static void createUploadImage(BaseProject *bp, const TextureUpload &upload, VkImageCreateFlags flags,
+								  VkImage &image, VkDeviceMemory &memory);
+	static void countUpload(BaseProject *bp, const TextureUpload &upload);
+	static void loadImage(BaseProject *bp, const std::vector<std::string> &files, VkImageCreateFlags flags,
+						  VkImage &image, VkDeviceMemory &memory, VkFormat &format, uint32_t &mipLevels,
+						  bool placeholder = false);
 	void createTextureImage(std::string file);
 	void createTextureImageView();
 	void createTextureSampler();
@@ -214,10 +496,12 @@ struct Texture {
 struct CubicTexture {
 	BaseProject* BP;
 	uint32_t mipLevels;
+	VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
 	VkImage textureImage;
 	VkDeviceMemory textureImageMemory;
 	VkImageView textureImageView;
 	VkSampler textureSampler;
+	std::vector<TextureBinding> bindings;
 
 	void createCubicTextureImage(const std::string file[6]);
 	void createCubicImageView();
@@ -227,36 +511,228 @@ struct CubicTexture {
 	void cleanup();
 };
 
+// the fields of a Texture or a CubicTexture that streaming replaces
+struct TextureTarget {
+	VkImage *image;
+	VkDeviceMemory *memory;
+	VkImageView *view;
+	VkFormat *format;
+	uint32_t *mipLevels;
+	VkImageViewType viewType;
+	VkSampler sampler;
+	std::vector<TextureBinding> *bindings;
+};
+
+// Progressive texture loading: textures start with a placeholder and are
+// queued here. A worker thread reads (or bakes) their containers into
+// staging buffers; at the frame boundary the main thread creates the images
+// and submits their uploads with a fence. Once a fence signals, the texture
+// uses the full image and each swap chain image switches its descriptors
+// when it is re-recorded, the placeholder being destroyed after the last.
+struct TextureStreamer {
+	struct Job {
+		std::vector<std::string> files;
+		VkImageCreateFlags flags;
+		TextureTarget target;
+		TextureUpload upload;
+		VkImage image = VK_NULL_HANDLE;
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+	};
+	// a placeholder still bound in the descriptor sets of some images
+	struct Retired {
+		VkImage image;
+		VkDeviceMemory memory;
+		VkImageView view;
+		std::vector<TextureBinding> bindings;
+		VkImageView fullView;
+		VkSampler sampler;
+		std::vector<bool> referencedByImage;
+	};
+
+	BaseProject *BP;
+	bool enabled = false;
+	std::thread worker;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool stopping = false;
+	std::deque<std::unique_ptr<Job>> queued;		// for the worker
+	std::vector<std::unique_ptr<Job>> prepared;	// staging buffers filled by the worker
+	std::vector<std::unique_ptr<Job>> uploading;	// main thread only, from here on
+	std::vector<Retired> retired;
+	int remaining = 0;
+	std::chrono::steady_clock::time_point start;
+	double completeMs = 0.0;		// from the first request to the last texture in place
+
+	void init(BaseProject *bp, bool enable);
+	void add(const std::vector<std::string> &files, VkImageCreateFlags flags, const TextureTarget &target);
+	void work();
+	bool update();
+	void switchDescriptors(uint32_t image);
+	// with the device idle, once no descriptor set binds the placeholders
+	void releaseRetired();
+	void cleanup();
+};
+
+// Depth-only render target sampled with depth comparison by the lit shaders.
+// It is rendered by its own command buffers, submitted only when invalidate()
+// was called since the last frame: otherwise the previous depth is reused.
+struct ShadowMap {
+	BaseProject *BP;
+	uint32_t size = 0;
+	VkFormat format = VK_FORMAT_D32_SFLOAT;
+	VkImage image;
+	VkDeviceMemory imageMemory;
+	VkImageView imageView;
+	VkSampler sampler;
+	VkRenderPass renderPass = VK_NULL_HANDLE;
+	VkFramebuffer framebuffer;
+
+	bool dirty = true;		// the content is undefined until the first render
+	uint64_t renderedFrames = 0;
+	uint64_t reusedFrames = 0;
+
+	void init(BaseProject *bp, uint32_t mapSize);
+	bool enabled() const { return renderPass != VK_NULL_HANDLE; }
+	void invalidate() { dirty = true; }
+	void cleanup();
+};
+
 struct DescriptorSetLayoutBinding {
 	uint32_t binding;
 	VkDescriptorType type;
 	VkShaderStageFlags flags;
+	uint32_t count = 1;
+};
+
+// A resource declared by a shader, as found in its SPIR-V
+struct ReflectedBinding {
+	uint32_t set;
+	uint32_t binding;
+	VkDescriptorType type;
+	VkShaderStageFlags stages;
+	uint32_t count;			// array size, 0 for a runtime sized array
+	uint32_t blockSize;		// uniform and storage blocks only: bytes used by the members
 };
 
+// Descriptor bindings of a set of shader stages, read from their SPIR-V
+// (only the decorations and types that describe descriptors are parsed)
+struct ShaderReflection {
+	std::vector<ReflectedBinding> bindings;
+	std::map<uint32_t, uint32_t> specConstants;	// constant_id -> size of its value in the specialization data
+
+	void add(const std::vector<char>& code, VkShaderStageFlagBits stage);
+	static ShaderReflection fromFiles(const std::string& VertShader, const std::string& FragShader);
+	std::vector<DescriptorSetLayoutBinding> layoutBindings(uint32_t set) const;
+};
 
 struct DescriptorSetLayout {
 	BaseProject *BP;
  	VkDescriptorSetLayout descriptorSetLayout;
+	std::map<uint32_t, uint32_t> blockSizes;	// binding -> size the shaders expect, if reflected
+	std::map<VkDescriptorType, uint32_t> descriptorCounts;	// per set, to size the descriptor pools
  	
  	void init(BaseProject *bp, std::vector<DescriptorSetLayoutBinding> B);
+	void init(BaseProject *bp, const ShaderReflection &R, uint32_t set);
+	void cleanup();
+};
+
+// Descriptor pools are created on demand, each one twice as large as the
+// previous (up to DESCRIPTOR_POOL_MAX_SETS), so nothing has to be counted up front.
+// The sets with the same descriptor counts share their pools, which hold
+// exactly those descriptors for every set.
+const uint32_t DESCRIPTOR_POOL_MIN_SETS = 16;
+const uint32_t DESCRIPTOR_POOL_MAX_SETS = 1024;
+
+struct DescriptorAllocator {
+	struct Bucket {
+		std::vector<VkDescriptorPool> pools;	// the last one is the one being filled
+		uint32_t nextPoolSets = DESCRIPTOR_POOL_MIN_SETS;
+	};
+
+	BaseProject *BP;
+	std::map<std::map<VkDescriptorType, uint32_t>, Bucket> buckets;	// by descriptor counts per set
+	uint32_t allocatedSets = 0;
+
+	void init(BaseProject *bp);
+	VkDescriptorPool createPool(Bucket &bucket, const std::map<VkDescriptorType, uint32_t> &counts, uint32_t maxSets);
+	// count sets of the given layout
+	void allocate(const DescriptorSetLayout &layout, uint32_t count, std::vector<VkDescriptorSet> &sets);
 	void cleanup();
 };
 
+// Everything needed to build a pipeline, captured before any Vulkan object is created
+struct PipelineDescription {
+	std::string vertShader;
+	std::string fragShader;
+	std::vector<DescriptorSetLayout *> D;
+	VkCompareOp compareOP = VK_COMPARE_OP_LESS;
+	bool wireframePipeline = false;	// double sided, for meshes made by MakeWireframeMesh
+	bool blendEnable = false;		// alpha blending, for the transparent pass only
+	bool depthWrite = true;
+	// render pass the pipeline is used in, the main one if VK_NULL_HANDLE
+	VkRenderPass renderPass = VK_NULL_HANDLE;
+	bool depthOnly = false;			// no color attachment, depth bias on (shadow maps)
+	// specialization constants, applied to both stages (a stage ignores the
+	// constant ids it does not declare)
+	std::vector<VkSpecializationMapEntry> specializationEntries;
+	std::vector<char> specializationData;
+	bool shadersFromFiles = false;	// skip the embedded SPIR-V (hot reload)
+};
+
 struct Pipeline {
 	BaseProject *BP;
-	VkPipeline graphicsPipeline;
-  	VkPipelineLayout pipelineLayout;
+	VkPipeline graphicsPipeline = VK_NULL_HANDLE;
+  	VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+	PipelineDescription description;
+	double buildMs = 0.0;		// time taken by the last build()
   	
   	void init(BaseProject *bp, const std::string& VertShader, const std::string& FragShader,
-  			  std::vector<DescriptorSetLayout *> D, VkCompareOp compareOP, bool wireframePipeline);
+  			  std::vector<DescriptorSetLayout *> D, VkCompareOp compareOP, bool wireframePipeline,
+			  const VkSpecializationInfo *specialization);
 	void init(BaseProject* bp, const std::string& VertShader, const std::string& FragShader,
 		std::vector<DescriptorSetLayout*> D, bool wireframePipeline);
+	// describe() only records the parameters; build() reads the shaders and
+	// creates the layout and the pipeline. init() does both.
+	void describe(BaseProject *bp, const std::string& VertShader, const std::string& FragShader,
+				  std::vector<DescriptorSetLayout *> D, VkCompareOp compareOP = VK_COMPARE_OP_LESS,
+				  bool wireframePipeline = false, const VkSpecializationInfo *specialization = nullptr);
+	void build();
+	// builds the described pipelines concurrently, one worker thread each
+	static void buildAll(BaseProject *bp, const std::vector<Pipeline *> &P);
   	VkShaderModule createShaderModule(const std::vector<char>& code);
+	static bool isSpirv(const std::vector<char>& code);
   	static std::vector<char> readFile(const std::string& filename);  	
 	void cleanup();
 };
 
-enum DescriptorSetElementType {UNIFORM, TEXTURE, CUBIC_TEXTURE};
+// Variants of one pipeline that differ only in their specialization
+// constants. The constants are 32 bit each and constant_id i is the i-th value.
+struct PipelineVariants {
+	BaseProject *BP;
+	PipelineDescription base;
+	std::map<std::vector<uint32_t>, std::unique_ptr<Pipeline>> variants;
+
+	void init(BaseProject *bp, const PipelineDescription &description);
+	// the variant for these constants, described but built only by get()
+	// or Pipeline::buildAll
+	Pipeline *describe(const std::vector<uint32_t> &constants);
+	Pipeline &get(const std::vector<uint32_t> &constants);
+	std::vector<Pipeline *> all();
+	void cleanup();
+};
+
+inline uint32_t SpecializationFloat(float f) {
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+
+// STORAGE: host visible storage buffer of the given size, one per swap chain image
+// TEXTURE_ARRAY: the table of MAX_TEXTURES textures indexed by the shaders,
+// the slots past the given textures repeat the first one
+enum DescriptorSetElementType {UNIFORM, TEXTURE, CUBIC_TEXTURE, SHADOW_MAP, STORAGE, TEXTURE_ARRAY};
 
 struct DescriptorSetElement {
 	int binding;
@@ -264,6 +740,8 @@ struct DescriptorSetElement {
 	int size;
 	Texture *tex;
 	CubicTexture* ctex;
+	ShadowMap *shadow;
+	std::vector<Texture *> textures;	// TEXTURE_ARRAY only
 };
 
 struct DescriptorSet {
@@ -275,23 +753,298 @@ struct DescriptorSet {
 	
 	std::vector<bool> toFree;
 
+	// kept to build the set again for a different number of images
+	DescriptorSetLayout *layout = nullptr;
+	std::vector<DescriptorSetElement> elements;
+
 	void init(BaseProject *bp, DescriptorSetLayout *L,
 		std::vector<DescriptorSetElement> E);
+	// for the new swap chain image count, see BaseProject::recreateImageDescriptors
+	void recreate();
+	void cleanup();
+};
+
+// GPU profiling: named scopes of the command buffers are bracketed with
+// timestamp queries. Each swap chain image owns a region of the query pool,
+// so its results can be read back (without waiting) once its fence signaled.
+const int GPU_PROFILER_MAX_SCOPES_PER_FRAME = 32;
+const int GPU_PROFILER_HISTORY_SIZE = 120;
+
+struct GpuScopeStats {
+	std::string name;
+	std::vector<double> history;	// ring of the last GPU_PROFILER_HISTORY_SIZE samples (ms)
+	int historyHead = 0;
+	double last = 0.0;
+	double min = 0.0;
+	double max = 0.0;
+	uint64_t samples = 0;
+	std::vector<std::pair<uint64_t, double>> timeline;	// (frame, ms), only when keepTimeline is set
+
+	void addSample(double ms);
+	double average() const;
+};
+
+struct GpuProfiler {
+	BaseProject *BP;
+	bool enabled = false;
+	VkQueryPool queryPool = VK_NULL_HANDLE;
+	uint32_t framesCount = 0;
+	double timestampPeriod = 1.0;	// nanoseconds per tick
+	uint64_t timestampMask = ~0ull;
+
+	struct RecordedScope {
+		int stats;
+		uint32_t beginQuery;
+		uint32_t endQuery;
+	};
+	std::vector<std::vector<RecordedScope>> recordedScopes;	// per swap chain image
+	std::vector<std::vector<int>> openScopes;					// per swap chain image
+	std::vector<uint32_t> usedQueries;							// per swap chain image
+	std::vector<bool> pending;									// per swap chain image: submitted, not collected
+	std::vector<uint64_t> submittedFrame;						// per swap chain image
+	std::vector<GpuScopeStats> stats;
+	std::map<std::string, int> statsIndex;
+	bool keepTimeline = false;
+
+	// fragment shader invocations of the whole frame (pipeline statistics
+	// query, when the device supports it) and the same divided by the pixels
+	VkQueryPool statisticsPool = VK_NULL_HANDLE;
+	GpuScopeStats fragmentInvocations;
+	GpuScopeStats overdraw;
+
+	void init(BaseProject *bp, uint32_t frames);
+	void resetFrame(VkCommandBuffer commandBuffer, int currentImage);
+	void beginFrameStatistics(VkCommandBuffer commandBuffer, int currentImage);
+	void endFrameStatistics(VkCommandBuffer commandBuffer, int currentImage);
+	void beginScope(VkCommandBuffer commandBuffer, int currentImage, const std::string &name);
+	void endScope(VkCommandBuffer commandBuffer, int currentImage);
+	void markSubmitted(int currentImage, uint64_t frame);
+	void collect(int currentImage);
+	void collectAll();
+	double averageMs(const std::string &name);
+	void printSummary();
+	void writeCSV(const std::string &file);
+	void writeJSON(const std::string &file);
+	void cleanup();
+};
+
+// Two-phase occlusion culling against a hierarchical depth buffer (Hi-Z).
+// The objects visible in the previous frame are drawn first (early pass), the
+// depth pyramid is built from their depth, then every object is tested against
+// it and the newly visible ones are drawn in a second render pass (late pass).
+// The draws are indirect, their instance count (0 or 1) is written by
+// shaders/OcclusionCull.comp, so the command buffers do not change.
+const uint32_t OCCLUSION_MAX_LEVELS = 16;
+
+struct CullObject {				// std430, see OcclusionCull.comp
+	glm::vec4 boundsMin;		// world space bounding box
+	glm::vec4 boundsMax;
+	uint32_t indexCount;
+	uint32_t padding[3];
+};
+
+struct CullParams {
+	alignas(16) glm::mat4 viewProj;
+	alignas(16) glm::uvec4 counts;	// objects, pyramid width, height, levels
+};
+
+struct OcclusionStats {			// written by the late pass of each frame
+	uint32_t tested;
+	uint32_t frustumCulled;
+	uint32_t occluded;
+	uint32_t drawnLate;
+};
+
+struct OcclusionCuller {
+	BaseProject *BP;
+	std::vector<CullObject> objects;
+
+	// the early pass clears, the late one loads: both are compatible with
+	// BaseProject::renderPass, so the same pipelines are used
+	VkRenderPass earlyPass = VK_NULL_HANDLE;
+	VkRenderPass latePass = VK_NULL_HANDLE;
+
+	VkImage pyramid = VK_NULL_HANDLE;
+	VkDeviceMemory pyramidMemory;
+	VkImageView pyramidView;
+	std::vector<VkImageView> levelViews;
+	uint32_t width, height, levels;
+	VkSampler sampler;
+
+	DescriptorSetLayout reduceLayout;
+	DescriptorSetLayout cullLayout;
+	VkPipelineLayout reducePipelineLayout, cullPipelineLayout;
+	VkPipeline reducePipeline, cullPipeline;
+	std::vector<VkDescriptorSet> reduceSets;	// one per pyramid level
+	std::vector<VkDescriptorSet> cullSets;		// one per swap chain image
+
+	VkBuffer visibility;			// 1 if the object passed the last test
+	VkDeviceMemory visibilityMemory;
+	// per swap chain image
+	std::vector<VkBuffer> objectBuffers, paramBuffers, earlyDraws, lateDraws, statsBuffers;
+	std::vector<VkDeviceMemory> objectMemory, paramMemory, earlyDrawsMemory, lateDrawsMemory, statsMemory;
+	std::vector<bool> pending;
+
+	// totals over the frames collected so far
+	uint64_t tested = 0, frustumCulled = 0, occluded = 0, drawnLate = 0;
+
+	void init(BaseProject *bp, uint32_t objectCount);
+	bool enabled() const { return earlyPass != VK_NULL_HANDLE; }
+	void createRenderPasses();
+	void createPipelines();
+	VkPipeline createComputePipeline(const std::string &shader, VkPipelineLayout layout);
+	void createBuffers();
+	// the per image buffers and the descriptor sets, created again by
+	// recreateSwapChain when the image count changes
+	void createImageResources();
+	void cleanupImageResources();
+	// sized after the swap chain, so created again by recreateSwapChain
+	void createPyramid();
+	void cleanupPyramid();
+
+	void setObject(uint32_t object, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, uint32_t indexCount);
+	void upload(int currentImage, const glm::mat4 &viewProj);
+	void recordEarly(VkCommandBuffer commandBuffer, int currentImage);
+	void recordCull(VkCommandBuffer commandBuffer, int currentImage);
+	// draws object with the arguments of the early or the late pass
+	void drawIndexed(VkCommandBuffer commandBuffer, int currentImage, uint32_t object, bool late);
+	void collect(int currentImage);
+	double occludedPercent() const;
 	void cleanup();
 };
 
 
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity must be a power of two.
+template <typename T, size_t Capacity>
+struct SpscQueue {
+	static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+	std::array<T, Capacity> slots;
+	alignas(64) std::atomic<size_t> head{0};	// next slot to read, written by the consumer
+	alignas(64) std::atomic<size_t> tail{0};	// next slot to write, written by the producer
+
+	// producer side, false if the queue is full
+	bool push(const T &item) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == Capacity) {
+			return false;
+		}
+		slots[t & (Capacity - 1)] = item;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer side, false if the queue is empty
+	bool pop(T &item) {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		item = slots[h & (Capacity - 1)];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+};
+
+struct InputEvent {
+	int key;
+	int scancode;
+	int action;		// GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+	int mods;
+};
+
+const size_t INPUT_QUEUE_SIZE = 256;
+
+// Shader hot reload
+const int SHADER_WATCH_INTERVAL_MS = 250;
+
+// a pipeline rebuilt by the shader watcher, waiting to be swapped in
+struct ReloadedPipeline {
+	Pipeline *target;
+	VkPipeline graphicsPipeline;
+	VkPipelineLayout pipelineLayout;
+};
+
+// a replaced pipeline, destroyed once every command buffer has been re-recorded
+// (each image is re-recorded only after its previous submission completed)
+struct RetiredPipeline {
+	VkPipeline graphicsPipeline;
+	VkPipelineLayout pipelineLayout;
+	std::vector<bool> referencedByImage;
+};
+
+// Benchmark mode: the live keyboard is replaced by a script of key events
+// at given frames, and the logic advances by a fixed dt, so that the same
+// script always produces the same sequence of scenes
+struct BenchmarkEvent {
+	uint64_t frame;
+	int key;
+	int action;		// GLFW_PRESS or GLFW_RELEASE
+};
+
+struct BenchmarkScript {
+	std::string name;
+	uint64_t warmupFrames = 0;	// rendered but not measured
+	uint64_t frames = 0;		// measured frames, after the warm up
+	float dt = 1.0f / 60.0f;
+	std::vector<BenchmarkEvent> events;	// sorted by frame
+
+	void load(const std::string &file);
+	static int keyFromName(const std::string &keyName);
+};
+
+// min/avg/p50/p95/p99 of a set of samples
+nlohmann::json SummarizeTimes(std::vector<double> samples);
+
+
+// Options coming from the command line
+struct RunOptions {
+	bool headless = false;		// no window, surface or swap chain: render to offscreen images
+	int frames = 0;				// frames to render before exiting, 0 = until the window is closed
+	std::string snapshotFile;	// headless only: PNG written with the last rendered frame
+	std::string benchmarkScript;	// JSON timeline of key events, see BenchmarkScript
+	std::string benchmarkOutput = "benchmark_results.json";
+	double simulationHz = 120.0;	// rate of the fixed simulation tick
+	std::string pipelineCacheFile = "pipeline_cache.bin";	// empty = no cache
+	int extraLights = 0;		// point lights added to the scene, to measure the light cost
+	int stressBoards = 0;		// copies of the board, for a dense scene
+	bool occlusionCulling = false;
+	bool cpuOcclusion = false;	// software rasterized occluders instead of the GPU culling
+	bool benchOcclusion = false;	// micro-benchmark of the software occlusion, no window
+	std::string bakeTextureSource;	// --bake-texture: image to convert to a texture container, no window
+	std::string bakeTextureOutput;
+	std::string textureFormat = "auto";	// auto (BC1, or BC3 with alpha, when supported), bc7 or rgba8
+	std::string mipFilter = "kaiser";	// filter of the mip levels baked on the CPU: box or kaiser
+	bool benchMips = false;		// micro-benchmark of the CPU mip generation, no window
+	bool textureStreaming = true;	// placeholders first, full textures loaded in the background
+};
+
+
 // MAIN ! 
 class BaseProject {
 	friend class Model;
 	friend class Texture;
 	friend class CubicTexture;
+	friend class ShadowMap;
 	friend class Pipeline;
+	friend class PipelineVariants;
 	friend class DescriptorSetLayout;
 	friend class DescriptorSet;
+	friend class DescriptorAllocator;
+	friend class GpuProfiler;
+	friend class OcclusionCuller;
+	friend class TextureStreamer;
 public:
 	virtual void setWindowParameters() = 0;
-    void run() {
+    void run(const RunOptions &runOptions = RunOptions()) {
+    	runStart = std::chrono::steady_clock::now();
+    	options = runOptions;
+    	if (!options.benchmarkScript.empty()) {
+    		benchmark.load(options.benchmarkScript);
+    		benchmarkMode = true;
+    		options.frames = static_cast<int>(benchmark.warmupFrames + benchmark.frames);
+    	}
     	setWindowParameters();
         initWindow();
         initVulkan();
@@ -300,13 +1053,11 @@ public:
     }
 
 protected:
+	RunOptions options;
 	uint32_t windowWidth;
 	uint32_t windowHeight;
 	std::string windowTitle;
 	VkClearColorValue initialBackgroundColor;
-	int uniformBlocksInPool;
-	int texturesInPool;
-	int setsInPool;
 
 	// Lesson 12
     GLFWwindow* window;
@@ -322,7 +1073,9 @@ protected:
 	std::vector<VkCommandBuffer> commandBuffers;
 
     // Lesson 14
-    VkSwapchainKHR swapChain;
+    VkSwapchainKHR swapChain = VK_NULL_HANDLE;
+	int framebufferWidth = 0;		// window size the swap chain was created for
+	int framebufferHeight = 0;
     std::vector<VkImage> swapChainImages;
 	VkFormat swapChainImageFormat;
 	VkExtent2D swapChainExtent;
@@ -331,7 +1084,7 @@ protected:
 	// Lesson 19
 	VkRenderPass renderPass;
 	
- 	VkDescriptorPool descriptorPool;
+ 	DescriptorAllocator descriptorAllocator;
 
 	// Lesson 22
 	// L22.0 --- Debugging
@@ -351,13 +1104,82 @@ protected:
 	std::vector<VkSemaphore> renderFinishedSemaphores;
 	std::vector<VkFence> inFlightFences;
 	std::vector<VkFence> imagesInFlight;
+
+	// GPU timestamps of the scopes recorded in the command buffers
+	GpuProfiler gpuProfiler;
+
+	// initialized by localInit() if the application uses it
+	ShadowMap shadowMap;
+	std::vector<VkCommandBuffer> shadowCommandBuffers;
+	// when initialized, the opaque objects are drawn by populateOccluders
+	OcclusionCuller occlusionCuller;
+	TextureStreamer textureStreamer;
+	std::vector<Texture *> textureTable;	// the 2D textures, by Texture::index
+	std::chrono::steady_clock::time_point runStart;
+	double firstFrameMs = 0.0;		// from run() to the submission of the first frame
+
+	// Headless mode
+	std::vector<VkDeviceMemory> offscreenImagesMemory;
+	bool enableValidationLayers = true;
+	uint64_t frameCount = 0;
+	uint32_t lastImageIndex = 0;
+
+	// Benchmark mode
+	bool benchmarkMode = false;
+	BenchmarkScript benchmark;
+	size_t nextBenchmarkEvent = 0;
+	std::vector<double> cpuFrameTimes;
+	std::vector<double> presentIntervals;
+	std::chrono::high_resolution_clock::time_point lastFrameTime =
+			std::chrono::high_resolution_clock::now();
+
+	// Pipeline cache shared by all the pipelines, persisted across runs
+	VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+	bool pipelineCacheWarm = false;		// valid data was loaded from disk
+	bool pipelineStatisticsEnabled = false;
+	double pipelineCreationMs = 0.0;	// wall time spent building pipelines
+	double textureLoadMs = 0.0;			// wall time spent loading textures
+	int texturesBaked = 0;				// textures decoded from the source image (container missing)
+	int texturesLoaded = 0;
+	bool textureCompressionBC = false;	// BC1-7 formats can be sampled
+	uint64_t textureBytes = 0;			// memory of the texture images, as uploaded
+	uint64_t textureBytesRGBA8 = 0;		// what they would take as RGBA8
+	double textureEncodeMs = 0.0;		// block compression of the baked textures
+	uint64_t textureEncodedBytes = 0;	// RGBA8 input of the block compression
+
+	// Shader hot reload: a watcher thread rebuilds the pipelines whose SPIR-V
+	// changed, the main thread swaps them in between frames
+	std::vector<Pipeline *> watchedPipelines;
+	std::thread shaderWatcherThread;
+	std::atomic<bool> shaderWatcherRunning{false};
+	std::mutex reloadedPipelinesMutex;
+	std::vector<ReloadedPipeline> reloadedPipelines;
+	std::vector<RetiredPipeline> retiredPipelines;
+	std::vector<bool> commandBufferDirty;
+
+	// Input: key events go through a queue, from the GLFW callback (or the
+	// benchmark script) to the simulation tick that consumes them
+	SpscQueue<InputEvent, INPUT_QUEUE_SIZE> inputQueue;
+	std::bitset<GLFW_KEY_LAST + 1> keyState;	// owned by the simulation tick
+	uint64_t droppedInputEvents = 0;
+	uint64_t reportedInputEvents = 0;		// dropped events already reported
+	std::chrono::steady_clock::time_point lastDropReport = std::chrono::steady_clock::now();
+
+	// Fixed-rate simulation
+	double simulationAccumulator = 0.0;
+	uint64_t simulationTicks = 0;
 	
 	// Lesson 12
     void initWindow() {
+    	if (options.headless) {
+    		window = nullptr;
+    		return;
+    	}
+
         glfwInit();
 
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-        glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
 
         window = glfwCreateWindow(windowWidth, windowHeight, windowTitle.c_str(), nullptr, nullptr);
     }
@@ -368,19 +1190,37 @@ protected:
     void initVulkan() {
 		createInstance();				// L12
 		setupDebugMessenger();			// L22.0
-		createSurface();				// L13
+		if (!options.headless) {
+			createSurface();			// L13
+		}
 		pickPhysicalDevice();			// L14
 		createLogicalDevice();			// L14
-		createSwapChain();				// L15
+		if (options.headless) {
+			createOffscreenImages();
+		} else {
+			createSwapChain();			// L15
+		}
 		createImageViews();				// L15
 		createRenderPass();				// L19
 		createCommandPool();			// L13
 		createDepthResources();			// L22.1
 		createFramebuffers();			// L22.2
 		createDescriptorPool();			// L21
+		createPipelineCache();
+		// a snapshot must show the complete textures
+		textureStreamer.init(this, options.textureStreaming && options.snapshotFile.empty());
 
 		localInit();
+		std::cout << "Pipeline creation: " << pipelineCreationMs << " ms ("
+				  << (pipelineCacheWarm ? "warm" : "cold") << " cache)\n";
+		if (textureStreamer.enabled) {
+			std::cout << "Texture placeholders: " << textureLoadMs << " ms (" << textureStreamer.remaining
+					  << " textures streaming in)\n";
+		} else {
+			printTextureStatistics();
+		}
 
+		gpuProfiler.init(this, static_cast<uint32_t>(swapChainImages.size()));
 		createCommandBuffers();			// L22.5 (13)
 		createSyncObjects();			// L22.3 
     }
@@ -399,26 +1239,25 @@ protected:
 		createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
 		createInfo.pApplicationInfo = &appInfo;
 
-		uint32_t glfwExtensionCount = 0;
-		const char** glfwExtensions;
-		glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-				
-		createInfo.enabledExtensionCount = glfwExtensionCount;
-		createInfo.ppEnabledExtensionNames = glfwExtensions;
-
 		createInfo.enabledLayerCount = 0;
 
+		// For debugging [Lesson 22] - Start
+		if (!checkValidationLayerSupport()) {
+			// build and benchmark machines (e.g. lavapipe only) often lack the layers
+			if (!options.headless) {
+				throw std::runtime_error("validation layers requested, but not available!");
+			}
+			std::cout << "Validation layers not available, running without them\n";
+			enableValidationLayers = false;
+		}
+
 		auto extensions = getRequiredExtensions();
 		createInfo.enabledExtensionCount =
 			static_cast<uint32_t>(extensions.size());
 		createInfo.ppEnabledExtensionNames = extensions.data();		
 		
-		// For debugging [Lesson 22] - Start
-		if (!checkValidationLayerSupport()) {
-			throw std::runtime_error("validation layers requested, but not available!");
-		}
-
 		VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo;
+		if (enableValidationLayers) {
 			createInfo.enabledLayerCount =
 				static_cast<uint32_t>(validationLayers.size());
 			createInfo.ppEnabledLayerNames = validationLayers.data();
@@ -426,6 +1265,7 @@ protected:
 			populateDebugMessengerCreateInfo(debugCreateInfo);
 			createInfo.pNext = (VkDebugUtilsMessengerCreateInfoEXT*)
 									&debugCreateInfo;
+		}
 		// For debugging [Lesson 22] - End
 		
 		VkResult result = vkCreateInstance(&createInfo, nullptr, &instance);
@@ -438,14 +1278,18 @@ protected:
     
     // Lesson 12 and L22.0
     std::vector<const char*> getRequiredExtensions() {
-		uint32_t glfwExtensionCount = 0;
-		const char** glfwExtensions;
-		glfwExtensions =
-			glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-
-		std::vector<const char*> extensions(glfwExtensions,
-			glfwExtensions + glfwExtensionCount);
+		std::vector<const char*> extensions;
+
+		if (!options.headless) {
+			uint32_t glfwExtensionCount = 0;
+			const char** glfwExtensions;
+			glfwExtensions =
+				glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+			extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+		}
+		if (enableValidationLayers) {
 			extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+		}
 		
 		return extensions;
 	}
@@ -506,6 +1350,7 @@ protected:
 
 	// Lesson 22.0 - debug support
 	void setupDebugMessenger() {
+		if (!enableValidationLayers) return;
 
 		VkDebugUtilsMessengerCreateInfoEXT createInfo{};
 		populateDebugMessengerCreateInfo(createInfo);
@@ -556,6 +1401,18 @@ protected:
 
 		bool extensionsSupported = checkDeviceExtensionSupport(device);
 
+		VkPhysicalDeviceFeatures supportedFeatures;
+		vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
+
+		// the lit shaders index their texture table
+		bool featuresSupported = supportedFeatures.samplerAnisotropy &&
+								 supportedFeatures.shaderSampledImageArrayDynamicIndexing;
+
+		if (options.headless) {
+			// no surface to present to: only graphics is needed
+			return indices.isComplete() && featuresSupported;
+		}
+
 		bool swapChainAdequate = false;
 		if (extensionsSupported) {
 			SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
@@ -563,11 +1420,8 @@ protected:
 								!swapChainSupport.presentModes.empty();
 		}
 		
-		VkPhysicalDeviceFeatures supportedFeatures;
-		vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
-		
 		return indices.isComplete() && extensionsSupported && swapChainAdequate &&
-						supportedFeatures.samplerAnisotropy;
+						featuresSupported;
 	}
     
     // Lesson 13
@@ -586,13 +1440,18 @@ protected:
 		for (const auto& queueFamily : queueFamilies) {
 			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
 				indices.graphicsFamily = i;
+				if (options.headless) {
+					indices.presentFamily = i;
+				}
 			}
 				
-			VkBool32 presentSupport = false;
-			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface,
-												 &presentSupport);
-			if (presentSupport) {
-			 	indices.presentFamily = i;
+			if (!options.headless) {
+				VkBool32 presentSupport = false;
+				vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface,
+													 &presentSupport);
+				if (presentSupport) {
+				 	indices.presentFamily = i;
+				}
 			}
 
 			if (indices.isComplete()) {
@@ -672,8 +1531,18 @@ protected:
 			queueCreateInfos.push_back(queueCreateInfo);
 		}
 		
+		VkPhysicalDeviceFeatures supportedFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
 		VkPhysicalDeviceFeatures deviceFeatures{};
 		deviceFeatures.samplerAnisotropy = VK_TRUE;
+		deviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+		// for the fragment counts of the GPU profiler
+		deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+		pipelineStatisticsEnabled = supportedFeatures.pipelineStatisticsQuery == VK_TRUE;
+		// compressed textures, RGBA8 otherwise
+		deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+		textureCompressionBC = supportedFeatures.textureCompressionBC == VK_TRUE;
 		
 		VkDeviceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -683,13 +1552,17 @@ protected:
 			static_cast<uint32_t>(queueCreateInfos.size());
 		
 		createInfo.pEnabledFeatures = &deviceFeatures;
-		createInfo.enabledExtensionCount =
-				static_cast<uint32_t>(deviceExtensions.size());
-		createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+		if (!options.headless) {
+			createInfo.enabledExtensionCount =
+					static_cast<uint32_t>(deviceExtensions.size());
+			createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+		}
 
+		if (enableValidationLayers) {
 			createInfo.enabledLayerCount = 
 					static_cast<uint32_t>(validationLayers.size());
 			createInfo.ppEnabledLayerNames = validationLayers.data();
+		}
 		
 		VkResult result = vkCreateDevice(physicalDevice, &createInfo, nullptr, &device);
 		
@@ -746,13 +1619,19 @@ protected:
 		 createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 		 createInfo.presentMode = presentMode;
 		 createInfo.clipped = VK_TRUE;
-		 createInfo.oldSwapchain = VK_NULL_HANDLE;
+		 // on a resize, the old swap chain lets the driver reuse its resources
+		 VkSwapchainKHR oldSwapChain = swapChain;
+		 createInfo.oldSwapchain = oldSwapChain;
 		 
 		 VkResult result = vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain);
 		 if (result != VK_SUCCESS) {
 		 	PrintVkError(result);
 			throw std::runtime_error("failed to create swap chain!");
 		}
+		if (oldSwapChain != VK_NULL_HANDLE) {
+			vkDestroySwapchainKHR(device, oldSwapChain, nullptr);
+		}
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
 		
 		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);
 		swapChainImages.resize(imageCount);
@@ -763,6 +1642,208 @@ protected:
 		swapChainExtent = extent;
 	}
 
+	// Everything that depends on the window size: the pipelines use a dynamic
+	// viewport and scissor, so they are not touched
+	void recreateSwapChain() {
+		PROFILE_ZONE("recreateSwapChain");
+		int width = 0, height = 0;
+		glfwGetFramebufferSize(window, &width, &height);
+		while ((width == 0 || height == 0) && !glfwWindowShouldClose(window)) {
+			// minimized: nothing to present until the window comes back
+			glfwWaitEvents();
+			glfwGetFramebufferSize(window, &width, &height);
+		}
+		if (width == 0 || height == 0) {
+			return;		// closed while minimized
+		}
+
+		vkDeviceWaitIdle(device);
+
+		size_t imageCount = swapChainImages.size();
+		cleanupSwapChain();
+		createSwapChain();
+		createImageViews();
+		createDepthResources();
+		createFramebuffers();
+		// uniform buffers, descriptor sets, command buffers and profiler
+		// queries are per image: the surface may give a different count
+		bool imageCountChanged = swapChainImages.size() != imageCount;
+		if (imageCountChanged) {
+			recreateImageDescriptors();
+		}
+		if (occlusionCuller.enabled()) {
+			occlusionCuller.cleanupPyramid();
+			occlusionCuller.createPyramid();
+		}
+
+		if (imageCountChanged) {
+			recreateImageCommandBuffers();
+		} else {
+			std::fill(imagesInFlight.begin(), imagesInFlight.end(), VK_NULL_HANDLE);
+			invalidateCommandBuffers();
+			for (uint32_t i = 0; i < commandBuffers.size(); i++) {
+				rerecordIfDirty(i);
+			}
+		}
+		std::cout << "Swap chain recreated: " << swapChainExtent.width << "x"
+				  << swapChainExtent.height << "\n";
+	}
+
+	// with the device idle: every descriptor set is allocated again, since
+	// the sets of the old images cannot be freed one by one. The old pools
+	// live until the end, so no new set gets the handle of an old one (the
+	// textures forget their bindings by handle).
+	void recreateImageDescriptors() {
+		textureStreamer.releaseRetired();
+		DescriptorAllocator oldAllocator = descriptorAllocator;
+		descriptorAllocator.buckets.clear();
+		descriptorAllocator.allocatedSets = 0;
+		if (occlusionCuller.enabled()) {
+			for (uint32_t i = 0; i < occlusionCuller.pending.size(); i++) {
+				occlusionCuller.collect(i);
+			}
+			occlusionCuller.cleanupImageResources();
+			occlusionCuller.createImageResources();
+		}
+		recreateDescriptorSets();
+		oldAllocator.cleanup();
+	}
+
+	void recreateImageCommandBuffers() {
+		vkFreeCommandBuffers(device, commandPool,
+				static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+		if (!shadowCommandBuffers.empty()) {
+			vkFreeCommandBuffers(device, commandPool,
+					static_cast<uint32_t>(shadowCommandBuffers.size()), shadowCommandBuffers.data());
+		}
+		// nothing references the old pipelines any more
+		for (const RetiredPipeline &r : retiredPipelines) {
+			vkDestroyPipeline(device, r.graphicsPipeline, nullptr);
+			vkDestroyPipelineLayout(device, r.pipelineLayout, nullptr);
+		}
+		retiredPipelines.clear();
+
+		gpuProfiler.collectAll();
+		gpuProfiler.cleanup();
+		gpuProfiler.init(this, static_cast<uint32_t>(swapChainImages.size()));
+		createCommandBuffers();
+		shadowMap.invalidate();
+		imagesInFlight.assign(swapChainImages.size(), VK_NULL_HANDLE);
+	}
+
+	// the swap chain itself is kept, to be passed as oldSwapchain
+	void cleanupSwapChain() {
+		vkDestroyImageView(device, depthImageView, nullptr);
+		vkDestroyImage(device, depthImage, nullptr);
+		vkFreeMemory(device, depthImageMemory, nullptr);
+
+		for (size_t i = 0; i < swapChainFramebuffers.size(); i++) {
+			vkDestroyFramebuffer(device, swapChainFramebuffers[i], nullptr);
+		}
+
+		for (size_t i = 0; i < swapChainImageViews.size(); i++){
+			vkDestroyImageView(device, swapChainImageViews[i], nullptr);
+		}
+	}
+
+	// Headless mode: offscreen images take the place of the swap chain ones,
+	// with the same role (one framebuffer and command buffer each)
+	void createOffscreenImages() {
+		swapChainImageFormat = VK_FORMAT_R8G8B8A8_SRGB;
+		swapChainExtent = { windowWidth, windowHeight };
+
+		swapChainImages.resize(HEADLESS_IMAGE_COUNT);
+		offscreenImagesMemory.resize(HEADLESS_IMAGE_COUNT);
+		for (size_t i = 0; i < swapChainImages.size(); i++) {
+			createImage(swapChainExtent.width, swapChainExtent.height, 1,
+						swapChainImageFormat, VK_IMAGE_TILING_OPTIMAL,
+						VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+						VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+						VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+						swapChainImages[i], offscreenImagesMemory[i]);
+		}
+	}
+
+	// Headless mode: copies a rendered image to a host visible buffer and
+	// writes it as a PNG
+	void saveSnapshot(uint32_t imageIndex, const std::string &file) {
+		uint32_t width = swapChainExtent.width;
+		uint32_t height = swapChainExtent.height;
+		VkDeviceSize imageSize = width * height * 4;
+
+		VkBuffer readbackBuffer;
+		VkDeviceMemory readbackBufferMemory;
+		createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+					 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+					 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+					 readbackBuffer, readbackBufferMemory);
+
+		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+
+		// the render pass left the image in TRANSFER_SRC_OPTIMAL
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = swapChainImages[imageIndex];
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+		barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer,
+							 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+							 VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+							 0, nullptr, 0, nullptr, 1, &barrier);
+
+		VkBufferImageCopy region{};
+		region.bufferOffset = 0;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = {0, 0, 0};
+		region.imageExtent = {width, height, 1};
+		vkCmdCopyImageToBuffer(commandBuffer, swapChainImages[imageIndex],
+				VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, 1, &region);
+
+		VkBufferMemoryBarrier bufferBarrier{};
+		bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		bufferBarrier.buffer = readbackBuffer;
+		bufferBarrier.offset = 0;
+		bufferBarrier.size = VK_WHOLE_SIZE;
+		vkCmdPipelineBarrier(commandBuffer,
+							 VK_PIPELINE_STAGE_TRANSFER_BIT,
+							 VK_PIPELINE_STAGE_HOST_BIT, 0,
+							 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+		endSingleTimeCommands(commandBuffer);
+
+		void* data;
+		vkMapMemory(device, readbackBufferMemory, 0, imageSize, 0, &data);
+		// R8G8B8A8_SRGB: the bytes are already the gamma encoded RGBA of the PNG
+		int written = stbi_write_png(file.c_str(), width, height, 4, data, width * 4);
+		vkUnmapMemory(device, readbackBufferMemory);
+
+		vkDestroyBuffer(device, readbackBuffer, nullptr);
+		vkFreeMemory(device, readbackBufferMemory, nullptr);
+
+		if (!written) {
+			throw std::runtime_error("failed to write snapshot " + file + "!");
+		}
+		std::cout << "Snapshot written to " << file << "\n";
+	}
+
 	// Lesson 14
 	VkSurfaceFormatKHR chooseSwapSurfaceFormat(
 				const std::vector<VkSurfaceFormatKHR>& availableFormats)
@@ -874,7 +1955,9 @@ protected:
 		colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		// offscreen images are left ready to be copied back to the host
+		colorAttachment.finalLayout = options.headless ?
+				VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 		
 		VkAttachmentReference colorAttachmentRef{};
 		colorAttachmentRef.attachment = 0;
@@ -952,7 +2035,8 @@ protected:
 		VkCommandPoolCreateInfo poolInfo{};
 		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 		poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
-		poolInfo.flags = 0; // Optional
+		// command buffers are re-recorded one by one after a shader reload
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 		
 		VkResult result = vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool);
 		if (result != VK_SUCCESS) {
@@ -967,7 +2051,8 @@ protected:
 		
 		createImage(swapChainExtent.width, swapChainExtent.height, 1, depthFormat,
 					VK_IMAGE_TILING_OPTIMAL,
-					VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+					// sampled by the occlusion culling
+					VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
 					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
 					depthImage, depthImageMemory);
 		depthImageView = createImageView(depthImage, depthFormat,
@@ -1020,95 +2105,6 @@ protected:
 
 		vkBindImageMemory(device, image, imageMemory, 0);
 	}
-
-	// New - Lesson 23
-	void generateMipmaps(VkImage image, VkFormat imageFormat,
-						 int32_t texWidth, int32_t texHeight,
-						 uint32_t mipLevels, int layerCount = 1) {
-		VkFormatProperties formatProperties;
-		vkGetPhysicalDeviceFormatProperties(physicalDevice, imageFormat,
-							&formatProperties);
-
-		if (!(formatProperties.optimalTilingFeatures &
-					VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
-			throw std::runtime_error("texture image format does not support linear blitting!");
-		}
-
-		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-		
-		VkImageMemoryBarrier barrier{};
-		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrier.image = image;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		barrier.subresourceRange.baseArrayLayer = 0;
-		barrier.subresourceRange.layerCount = layerCount;
-		barrier.subresourceRange.levelCount = 1;
-
-		int32_t mipWidth = texWidth;
-		int32_t mipHeight = texHeight;
-
-		for (uint32_t i = 1; i < mipLevels; i++) { 
-			barrier.subresourceRange.baseMipLevel = i - 1;
-			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			
-			vkCmdPipelineBarrier(commandBuffer,
-								 VK_PIPELINE_STAGE_TRANSFER_BIT,
-								 VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-								 0, nullptr, 0, nullptr,
-								 1, &barrier);
-
-			VkImageBlit blit{};
-			blit.srcOffsets[0] = { 0, 0, 0 };
-			blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
-			blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			blit.srcSubresource.mipLevel = i - 1;
-			blit.srcSubresource.baseArrayLayer = 0;
-			blit.srcSubresource.layerCount = layerCount;
-			blit.dstOffsets[0] = { 0, 0, 0 };
-			blit.dstOffsets[1] = { mipWidth > 1 ? mipWidth / 2 : 1,
-								   mipHeight > 1 ? mipHeight/2:1, 1};
-			blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			blit.dstSubresource.mipLevel = i;
-			blit.dstSubresource.baseArrayLayer = 0;
-			blit.dstSubresource.layerCount = layerCount;
-			
-			vkCmdBlitImage(commandBuffer, image,
-						   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-						   image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-						   &blit, VK_FILTER_LINEAR);
-
-			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-			
-			vkCmdPipelineBarrier(commandBuffer,
-								 VK_PIPELINE_STAGE_TRANSFER_BIT,
-								 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-								 0, nullptr, 0, nullptr,
-								 1, &barrier);
-			if (mipWidth > 1) mipWidth /= 2;
-			if (mipHeight > 1) mipHeight /= 2;
-		}
-
-		barrier.subresourceRange.baseMipLevel = mipLevels - 1;
-		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		vkCmdPipelineBarrier(commandBuffer,
-							 VK_PIPELINE_STAGE_TRANSFER_BIT,
-							 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-							 0, nullptr, 0, nullptr,
-							 1, &barrier);
-
-		endSingleTimeCommands(commandBuffer);
-	}
 	
 	// New - Lesson 23
 	void transitionImageLayout(VkImage image, VkFormat format,
@@ -1171,6 +2167,65 @@ protected:
 
 		endSingleTimeCommands(commandBuffer);
 	}
+
+	// Every level of a texture container from the staging buffer, in one
+	// command buffer: to TRANSFER_DST, one copy region per level, then
+	// straight to SHADER_READ_ONLY, with no blits
+	void uploadTextureLevels(VkBuffer buffer, VkImage image, const TextureContainerHeader &header,
+							 const std::vector<TextureContainerLevel> &levels) {
+		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+		recordTextureUpload(commandBuffer, buffer, image, header, levels);
+		endSingleTimeCommands(commandBuffer);
+	}
+
+	void recordTextureUpload(VkCommandBuffer commandBuffer, VkBuffer buffer, VkImage image,
+							 const TextureContainerHeader &header,
+							 const std::vector<TextureContainerLevel> &levels) {
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = image;
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = header.levels;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = header.layers;
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		vkCmdPipelineBarrier(commandBuffer,
+							 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+							 VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+							 0, nullptr, 0, nullptr, 1, &barrier);
+
+		std::vector<VkBufferImageCopy> regions(levels.size());
+		for (uint32_t i = 0; i < levels.size(); i++) {
+			VkBufferImageCopy &region = regions[i];
+			region.bufferOffset = levels[i].offset;
+			region.bufferRowLength = 0;
+			region.bufferImageHeight = 0;
+			region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			region.imageSubresource.mipLevel = i;
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = header.layers;
+			region.imageOffset = {0, 0, 0};
+			region.imageExtent = {std::max(1u, header.width >> i), std::max(1u, header.height >> i), 1};
+		}
+		vkCmdCopyBufferToImage(commandBuffer, buffer, image,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				static_cast<uint32_t>(regions.size()), regions.data());
+
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer,
+							 VK_PIPELINE_STAGE_TRANSFER_BIT,
+							 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+							 0, nullptr, 0, nullptr, 1, &barrier);
+	}
 	
 	// New - Lesson 23
 	VkCommandBuffer beginSingleTimeCommands() { 
@@ -1265,27 +2320,94 @@ protected:
     
     // Lesson 21
 	void createDescriptorPool() {
-		std::array<VkDescriptorPoolSize, 2> poolSizes{};
-		poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		poolSizes[0].descriptorCount = static_cast<uint32_t>(uniformBlocksInPool *
-															 swapChainImages.size());
-		// New - Lesson 23
-		poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		poolSizes[1].descriptorCount = static_cast<uint32_t>(texturesInPool *
-															 swapChainImages.size());
-		//
-
-		VkDescriptorPoolCreateInfo poolInfo{};
-		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-		poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());;
-		poolInfo.pPoolSizes = poolSizes.data();
-		poolInfo.maxSets = static_cast<uint32_t>(setsInPool * swapChainImages.size());
-		
-		VkResult result = vkCreateDescriptorPool(device, &poolInfo, nullptr,
-									&descriptorPool);
+		descriptorAllocator.init(this);
+	}
+
+	// The initial data is accepted only if its header matches this device:
+	// the driver would reject a foreign blob anyway, but some drivers crash on it
+	bool isPipelineCacheCompatible(const std::vector<char> &data) {
+		struct CacheHeader {
+			uint32_t headerSize;
+			uint32_t headerVersion;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint8_t uuid[VK_UUID_SIZE];
+		};
+		if (data.size() < sizeof(CacheHeader)) {
+			return false;
+		}
+		CacheHeader header;
+		memcpy(&header, data.data(), sizeof(CacheHeader));
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+		return header.headerSize >= sizeof(CacheHeader) &&
+			   header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+			   header.vendorID == properties.vendorID &&
+			   header.deviceID == properties.deviceID &&
+			   memcmp(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+
+	void createPipelineCache() {
+		std::vector<char> initialData;
+		if (!options.pipelineCacheFile.empty()) {
+			std::ifstream file(options.pipelineCacheFile, std::ios::ate | std::ios::binary);
+			if (file.is_open()) {
+				initialData.resize((size_t) file.tellg());
+				file.seekg(0);
+				file.read(initialData.data(), initialData.size());
+				if (!isPipelineCacheCompatible(initialData)) {
+					std::cout << "Ignoring " << options.pipelineCacheFile
+							  << ": created by another device or driver\n";
+					initialData.clear();
+				}
+			}
+		}
+
+		VkPipelineCacheCreateInfo cacheInfo{};
+		cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		cacheInfo.initialDataSize = initialData.size();
+		cacheInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+		VkResult result = vkCreatePipelineCache(device, &cacheInfo, nullptr, &pipelineCache);
+		if (result != VK_SUCCESS) {
+		 	PrintVkError(result);
+			throw std::runtime_error("failed to create pipeline cache!");
+		}
+		pipelineCacheWarm = !initialData.empty();
+	}
+
+	void savePipelineCache() {
+		if (options.pipelineCacheFile.empty()) {
+			return;
+		}
+		size_t size = 0;
+		VkResult result = vkGetPipelineCacheData(device, pipelineCache, &size, nullptr);
+		std::vector<char> data(size);
+		if (result == VK_SUCCESS) {
+			result = vkGetPipelineCacheData(device, pipelineCache, &size, data.data());
+		}
 		if (result != VK_SUCCESS) {
 		 	PrintVkError(result);
-			throw std::runtime_error("failed to create descriptor pool!");
+			std::cout << "Could not read back the pipeline cache\n";
+			return;
+		}
+
+		// written aside and renamed, so a crash never leaves half a cache
+		std::string temporary = options.pipelineCacheFile + ".tmp";
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			file.write(data.data(), size);
+			if (!file) {
+				std::cout << "Could not write " << options.pipelineCacheFile << "\n";
+				return;
+			}
+		}
+		std::error_code ec;
+		std::filesystem::rename(temporary, options.pipelineCacheFile, ec);
+		if (ec) {
+			std::cout << "Could not write " << options.pipelineCacheFile << ": " << ec.message() << "\n";
 		}
 	}
 	
@@ -1309,48 +2431,298 @@ protected:
 			throw std::runtime_error("failed to allocate command buffers!");
 		}
 		
-		// Lesson 22.5 --- Draw calls
-		// This is where the commands that actually draw something on screen are!
-		for (size_t i = 0; i < commandBuffers.size(); i++) {
-			VkCommandBufferBeginInfo beginInfo{};
-			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			beginInfo.flags = 0; // Optional
-			beginInfo.pInheritanceInfo = nullptr; // Optional
-
-			if (vkBeginCommandBuffer(commandBuffers[i], &beginInfo) !=
-						VK_SUCCESS) {
-				throw std::runtime_error("failed to begin recording command buffer!");
+		if (shadowMap.enabled()) {
+			shadowCommandBuffers.resize(commandBuffers.size());
+			result = vkAllocateCommandBuffers(device, &allocInfo,
+					shadowCommandBuffers.data());
+			if (result != VK_SUCCESS) {
+				PrintVkError(result);
+				throw std::runtime_error("failed to allocate shadow map command buffers!");
 			}
-			
-			VkRenderPassBeginInfo renderPassInfo{};
-			renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-			renderPassInfo.renderPass = renderPass; 
-			renderPassInfo.framebuffer = swapChainFramebuffers[i];
-			renderPassInfo.renderArea.offset = {0, 0};
-			renderPassInfo.renderArea.extent = swapChainExtent;
-	
-			std::array<VkClearValue, 2> clearValues{};
-			clearValues[0].color = initialBackgroundColor;
-			clearValues[1].depthStencil = {1.0f, 0};
+		}
+		
+		for (size_t i = 0; i < commandBuffers.size(); i++) {
+			recordCommandBuffer(static_cast<int>(i));
+		}
+		commandBufferDirty.assign(commandBuffers.size(), false);
+	}
+
+	// Lesson 22.5 --- Draw calls
+	// This is where the commands that actually draw something on screen are!
+	void recordCommandBuffer(int i) {
+		PROFILE_ZONE("recordCommandBuffer");
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = 0; // Optional
+		beginInfo.pInheritanceInfo = nullptr; // Optional
+
+		if (vkBeginCommandBuffer(commandBuffers[i], &beginInfo) !=
+					VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording command buffer!");
+		}
+
+		gpuProfiler.resetFrame(commandBuffers[i], i);
+		gpuProfiler.beginFrameStatistics(commandBuffers[i], i);
+		gpuProfiler.beginScope(commandBuffers[i], i, "frame");
+		
+		if (occlusionCuller.enabled()) {
+			occlusionCuller.recordEarly(commandBuffers[i], i);
+			beginMainRenderPass(commandBuffers[i], i, occlusionCuller.earlyPass);
+			populateOccluders(commandBuffers[i], i, false);
+			vkCmdEndRenderPass(commandBuffers[i]);
+
+			gpuProfiler.beginScope(commandBuffers[i], i, "occlusion culling");
+			occlusionCuller.recordCull(commandBuffers[i], i);
+			gpuProfiler.endScope(commandBuffers[i], i);
+
+			beginMainRenderPass(commandBuffers[i], i, occlusionCuller.latePass);
+			populateOccluders(commandBuffers[i], i, true);
+		} else {
+			beginMainRenderPass(commandBuffers[i], i, renderPass);
+		}
+
+		populateCommandBuffer(commandBuffers[i], i);
+		
+
+		vkCmdEndRenderPass(commandBuffers[i]);
+
+		gpuProfiler.endScope(commandBuffers[i], i);
+		gpuProfiler.endFrameStatistics(commandBuffers[i], i);
+
+		if (vkEndCommandBuffer(commandBuffers[i]) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record command buffer!");
+		}
+
+		if (shadowMap.enabled()) {
+			recordShadowCommandBuffer(i);
+		}
+	}
+	// pass is renderPass or one compatible with it
+	void beginMainRenderPass(VkCommandBuffer commandBuffer, int i, VkRenderPass pass) {
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.renderPass = pass; 
+		renderPassInfo.framebuffer = swapChainFramebuffers[i];
+		renderPassInfo.renderArea.offset = {0, 0};
+		renderPassInfo.renderArea.extent = swapChainExtent;
 	
-			renderPassInfo.clearValueCount =
-							static_cast<uint32_t>(clearValues.size());
-			renderPassInfo.pClearValues = clearValues.data();
-			
-			vkCmdBeginRenderPass(commandBuffers[i], &renderPassInfo,
-					VK_SUBPASS_CONTENTS_INLINE);			
+		std::array<VkClearValue, 2> clearValues{};
+		clearValues[0].color = initialBackgroundColor;
+		clearValues[1].depthStencil = {1.0f, 0};
 	
+		renderPassInfo.clearValueCount =
+						static_cast<uint32_t>(clearValues.size());
+		renderPassInfo.pClearValues = clearValues.data();
+		
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo,
+				VK_SUBPASS_CONTENTS_INLINE);			
+
+		// dynamic state of every pipeline
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float) swapChainExtent.width;
+		viewport.height = (float) swapChainExtent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+		VkRect2D scissor{};
+		scissor.offset = {0, 0};
+		scissor.extent = swapChainExtent;
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+	}
+	void recordShadowCommandBuffer(int i) {
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-			populateCommandBuffer(commandBuffers[i], i);
-			
+		if (vkBeginCommandBuffer(shadowCommandBuffers[i], &beginInfo) !=
+					VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording shadow map command buffer!");
+		}
 
-			vkCmdEndRenderPass(commandBuffers[i]);
+		VkClearValue clearValue{};
+		clearValue.depthStencil = {1.0f, 0};
+
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.renderPass = shadowMap.renderPass;
+		renderPassInfo.framebuffer = shadowMap.framebuffer;
+		renderPassInfo.renderArea.offset = {0, 0};
+		renderPassInfo.renderArea.extent = {shadowMap.size, shadowMap.size};
+		renderPassInfo.clearValueCount = 1;
+		renderPassInfo.pClearValues = &clearValue;
+
+		vkCmdBeginRenderPass(shadowCommandBuffers[i], &renderPassInfo,
+				VK_SUBPASS_CONTENTS_INLINE);
+
+		VkViewport viewport{};
+		viewport.width = (float) shadowMap.size;
+		viewport.height = (float) shadowMap.size;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(shadowCommandBuffers[i], 0, 1, &viewport);
+
+		VkRect2D scissor{};
+		scissor.extent = {shadowMap.size, shadowMap.size};
+		vkCmdSetScissor(shadowCommandBuffers[i], 0, 1, &scissor);
+
+		populateShadowCommandBuffer(shadowCommandBuffers[i], i);
+
+		vkCmdEndRenderPass(shadowCommandBuffers[i]);
+
+		if (vkEndCommandBuffer(shadowCommandBuffers[i]) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record shadow map command buffer!");
+		}
+	}
+
+	// Shader hot reload, for windowed interactive runs only: rebuilds the given
+	// pipelines whenever one of their .spv files is rewritten
+	void watchShaders(const std::vector<Pipeline *> &P) {
+		if (options.headless || benchmarkMode) {
+			return;
+		}
+		watchedPipelines = P;
+		shaderWatcherRunning = true;
+		shaderWatcherThread = std::thread(&BaseProject::shaderWatcherLoop, this);
+	}
+
+	void stopShaderWatcher() {
+		if (shaderWatcherThread.joinable()) {
+			shaderWatcherRunning = false;
+			shaderWatcherThread.join();
+		}
+	}
+
+	// runs on the watcher thread: only reads the pipeline descriptions, which
+	// never change, and hands the new Vulkan objects over to the main thread
+	void shaderWatcherLoop() {
+		CpuTraceSetThreadName("shader watcher");
+		std::map<std::string, std::filesystem::file_time_type> lastWrite;
+		auto writeTime = [](const std::string &file) {
+			std::error_code ec;
+			auto t = std::filesystem::last_write_time(ResolveAssetPath(file), ec);
+			return ec ? std::filesystem::file_time_type::min() : t;
+		};
+		for (Pipeline *p : watchedPipelines) {
+			lastWrite[p->description.vertShader] = writeTime(p->description.vertShader);
+			lastWrite[p->description.fragShader] = writeTime(p->description.fragShader);
+		}
+
+		while (shaderWatcherRunning) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(SHADER_WATCH_INTERVAL_MS));
+
+			std::set<std::string> changed;
+			for (auto &file : lastWrite) {
+				auto t = writeTime(file.first);
+				if (t != file.second) {
+					file.second = t;
+					changed.insert(file.first);
+				}
+			}
+			if (changed.empty()) continue;
+
+			for (Pipeline *p : watchedPipelines) {
+				if (!changed.count(p->description.vertShader) &&
+					!changed.count(p->description.fragShader)) continue;
+
+				Pipeline rebuilt;
+				rebuilt.BP = this;
+				rebuilt.description = p->description;
+				rebuilt.description.shadersFromFiles = true;
+				try {
+					rebuilt.build();
+				} catch (const std::exception &e) {
+					// e.g. a file still being written: keep the old pipeline,
+					// the next write triggers another attempt
+					std::cout << "Reload of " << p->description.fragShader << " failed: " << e.what() << "\n";
+					continue;
+				}
+				std::lock_guard<std::mutex> lock(reloadedPipelinesMutex);
+				reloadedPipelines.push_back({ p, rebuilt.graphicsPipeline, rebuilt.pipelineLayout });
+			}
+		}
+	}
+
+	// at the frame boundary: swap the rebuilt pipelines in and mark all the
+	// command buffers for re-recording, without waiting for the device
+	void applyReloadedPipelines() {
+		std::vector<ReloadedPipeline> ready;
+		{
+			std::lock_guard<std::mutex> lock(reloadedPipelinesMutex);
+			ready.swap(reloadedPipelines);
+		}
+		for (const ReloadedPipeline &r : ready) {
+			retiredPipelines.push_back({ r.target->graphicsPipeline, r.target->pipelineLayout,
+										 std::vector<bool>(commandBuffers.size(), true) });
+			r.target->graphicsPipeline = r.graphicsPipeline;
+			r.target->pipelineLayout = r.pipelineLayout;
+			invalidateCommandBuffers();
+			shadowMap.invalidate();
+			std::cout << "Reloaded " << r.target->description.vertShader << " + "
+					  << r.target->description.fragShader << "\n";
+		}
+	}
+
+	uint32_t registerTexture(Texture *texture) {
+		if (textureTable.size() >= MAX_TEXTURES) {
+			throw std::runtime_error("more than " + std::to_string(MAX_TEXTURES) + " textures!");
+		}
+		textureTable.push_back(texture);
+		return static_cast<uint32_t>(textureTable.size() - 1);
+	}
 
-			if (vkEndCommandBuffer(commandBuffers[i]) != VK_SUCCESS) {
-				throw std::runtime_error("failed to record command buffer!");
+	void printTextureStatistics() {
+		std::cout << "Texture loading: " << textureLoadMs << " ms (" << texturesLoaded << " textures, "
+				  << texturesBaked << " baked from the source image)\n";
+		std::cout << "Texture memory: " << textureBytes / 1024 << " KiB, "
+				  << (textureBytesRGBA8 - textureBytes) / 1024 << " KiB saved by block compression";
+		if (textureEncodeMs > 0.0) {
+			std::cout << " (encoded at " << textureEncodedBytes / textureEncodeMs / 1000.0 << " MB/s)";
+		}
+		std::cout << "\n";
+	}
+
+	// the command buffers are re-recorded as their images come back, e.g.
+	// after changing what populateCommandBuffer draws
+	void invalidateCommandBuffers() {
+		commandBufferDirty.assign(commandBuffers.size(), true);
+	}
+
+	// to be called once the previous submission of the image has completed
+	void rerecordIfDirty(uint32_t imageIndex) {
+		if (!commandBufferDirty[imageIndex]) return;
+
+		textureStreamer.switchDescriptors(imageIndex);
+		recordCommandBuffer(imageIndex);
+		commandBufferDirty[imageIndex] = false;
+
+		for (auto it = retiredPipelines.begin(); it != retiredPipelines.end();) {
+			it->referencedByImage[imageIndex] = false;
+			if (std::none_of(it->referencedByImage.begin(), it->referencedByImage.end(),
+							 [](bool b) { return b; })) {
+				vkDestroyPipeline(device, it->graphicsPipeline, nullptr);
+				vkDestroyPipelineLayout(device, it->pipelineLayout, nullptr);
+				it = retiredPipelines.erase(it);
+			} else {
+				++it;
 			}
 		}
 	}
+
+	// with the device idle and the watcher stopped
+	void releaseReloadedPipelines() {
+		for (const ReloadedPipeline &r : reloadedPipelines) {
+			vkDestroyPipeline(device, r.graphicsPipeline, nullptr);
+			vkDestroyPipelineLayout(device, r.pipelineLayout, nullptr);
+		}
+		reloadedPipelines.clear();
+		for (const RetiredPipeline &r : retiredPipelines) {
+			vkDestroyPipeline(device, r.graphicsPipeline, nullptr);
+			vkDestroyPipelineLayout(device, r.pipelineLayout, nullptr);
+		}
+		retiredPipelines.clear();
+	}
     
     // Lesson 22.5
     void createSyncObjects() {
@@ -1386,51 +2758,328 @@ protected:
     
     // Lesson 22.6 --- Main Rendering Loop
     void mainLoop() {
-        while (!glfwWindowShouldClose(window)) {
-            glfwPollEvents();
+    	gpuProfiler.keepTimeline = benchmarkMode;
+    	auto lastPresent = std::chrono::high_resolution_clock::now();
+
+    	while (options.headless || !glfwWindowShouldClose(window)) {
+    		if (options.frames != 0 && frameCount >= static_cast<uint64_t>(options.frames)) {
+    			break;
+    		}
+    		if (!options.headless) {
+	            glfwPollEvents();
+	        }
+	        if (benchmarkMode) {
+	        	applyBenchmarkEvents();
+	        }
+	        reportDroppedInputEvents(false);
+
+	        auto frameStart = std::chrono::high_resolution_clock::now();
             drawFrame();
+	        auto frameEnd = std::chrono::high_resolution_clock::now();
+
+	        // in headless mode there is no present: the interval is between submissions
+	        if (benchmarkMode && frameCount > benchmark.warmupFrames) {
+	        	cpuFrameTimes.push_back(std::chrono::duration<double, std::milli>(
+	        			frameEnd - frameStart).count());
+	        	presentIntervals.push_back(std::chrono::duration<double, std::milli>(
+	        			frameEnd - lastPresent).count());
+	        }
+	        lastPresent = frameEnd;
         }
         
         vkDeviceWaitIdle(device);
+        reportDroppedInputEvents(true);
+
+        if (benchmarkMode) {
+        	gpuProfiler.collectAll();
+        	writeBenchmarkResults();
+        }
+
+        if (options.headless && !options.snapshotFile.empty() && frameCount > 0) {
+        	saveSnapshot(lastImageIndex, options.snapshotFile);
+        }
     }
+
+	// key state for the game logic, as of the events consumed by the last tick
+	bool isKeyDown(int key) {
+		return key >= 0 && key <= GLFW_KEY_LAST && keyState[key];
+	}
+
+	// time elapsed since the previous call, or the fixed step of the benchmark
+	double frameDeltaTime() {
+		auto now = std::chrono::high_resolution_clock::now();
+		double dt = std::chrono::duration<double, std::chrono::seconds::period>
+				(now - lastFrameTime).count();
+		lastFrameTime = now;
+		return benchmarkMode ? benchmark.dt : dt;
+	}
+
+	// one step of the game logic, always called with the same dt
+	virtual void simulationTick(float dt) {}
+
+	// Runs the simulation ticks due since the previous frame, which may be
+	// none or several. Returns how far the frame time is between the last
+	// two ticks (0 to 1), to interpolate the rendered state.
+	float advanceSimulation() {
+		PROFILE_ZONE("advanceSimulation");
+		double step = 1.0 / options.simulationHz;
+		simulationAccumulator += frameDeltaTime();
+
+		int steps = 0;
+		while (simulationAccumulator >= step && steps < MAX_SIMULATION_STEPS_PER_FRAME) {
+			processInputEvents();
+			simulationTick(static_cast<float>(step));
+			simulationAccumulator -= step;
+			simulationTicks++;
+			steps++;
+		}
+		if (simulationAccumulator >= step) {
+			// too far behind: drop the time that could not be simulated
+			simulationAccumulator = std::fmod(simulationAccumulator, step);
+		}
+
+		return static_cast<float>(simulationAccumulator / step);
+	}
+
+	// keyboard events, from GLFW or from the benchmark script, delivered
+	// at the beginning of a simulation tick
+	virtual void handleKeyEvent(int key, int scancode, int action, int mods) {}
+
+	// producer side of the input queue
+	void queueInputEvent(const InputEvent &e) {
+		if (!inputQueue.push(e)) {
+			droppedInputEvents++;
+		}
+	}
+
+	// at most once per second, and once more at exit (force)
+	void reportDroppedInputEvents(bool force) {
+		auto now = std::chrono::steady_clock::now();
+		if (droppedInputEvents == reportedInputEvents ||
+			(!force && now - lastDropReport < std::chrono::seconds(1))) {
+			return;
+		}
+		std::cout << "Input queue full, " << droppedInputEvents - reportedInputEvents << " key events dropped ("
+				  << droppedInputEvents << " in total)\n";
+		reportedInputEvents = droppedInputEvents;
+		lastDropReport = now;
+	}
+
+	// to be used by the GLFW key callback: live input is ignored while a script runs
+	void onLiveKeyEvent(int key, int scancode, int action, int mods) {
+		if (!benchmarkMode) {
+			queueInputEvent({ key, scancode, action, mods });
+		}
+	}
+
+	// consumer side: updates the key state and dispatches the queued events
+	void processInputEvents() {
+		InputEvent e;
+		while (inputQueue.pop(e)) {
+			if (e.key >= 0 && e.key <= GLFW_KEY_LAST) {
+				if (e.action == GLFW_PRESS) keyState.set(e.key);
+				if (e.action == GLFW_RELEASE) keyState.reset(e.key);
+			}
+			handleKeyEvent(e.key, e.scancode, e.action, e.mods);
+		}
+	}
+
+	// state of the scene reported with the benchmark results, to check
+	// that a script reproduces the same scene across runs
+	virtual nlohmann::json benchmarkSceneState() {
+		return nullptr;
+	}
+
+	// application specific measurements, added to the benchmark results
+	virtual void addBenchmarkResults(nlohmann::json &results) {}
+
+	void applyBenchmarkEvents() {
+		while (nextBenchmarkEvent < benchmark.events.size() &&
+				benchmark.events[nextBenchmarkEvent].frame <= frameCount) {
+			const BenchmarkEvent &e = benchmark.events[nextBenchmarkEvent++];
+			queueInputEvent({ e.key, 0, e.action, 0 });
+		}
+	}
+
+	void writeBenchmarkResults() {
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+		std::vector<double> gpuFrameTimes;
+		auto frameScope = gpuProfiler.statsIndex.find("frame");
+		if (frameScope != gpuProfiler.statsIndex.end()) {
+			for (const auto &sample : gpuProfiler.stats[frameScope->second].timeline) {
+				if (sample.first >= benchmark.warmupFrames) {
+					gpuFrameTimes.push_back(sample.second);
+				}
+			}
+		}
+
+		nlohmann::json results;
+		results["script"] = benchmark.name;
+		results["device"] = properties.deviceName;
+		results["driverVersion"] = properties.driverVersion;
+		results["headless"] = options.headless;
+		results["extent"] = { swapChainExtent.width, swapChainExtent.height };
+		results["warmupFrames"] = benchmark.warmupFrames;
+		results["frames"] = benchmark.frames;
+		results["dt"] = benchmark.dt;
+		results["cpuFrameMs"] = SummarizeTimes(cpuFrameTimes);
+		results["gpuFrameMs"] = SummarizeTimes(gpuFrameTimes);
+		results["presentIntervalMs"] = SummarizeTimes(presentIntervals);
+		std::vector<double> fragments, overdraw;
+		for (const auto &sample : gpuProfiler.fragmentInvocations.timeline) {
+			if (sample.first >= benchmark.warmupFrames) fragments.push_back(sample.second);
+		}
+		for (const auto &sample : gpuProfiler.overdraw.timeline) {
+			if (sample.first >= benchmark.warmupFrames) overdraw.push_back(sample.second);
+		}
+		results["fragmentShaderInvocations"] = SummarizeTimes(fragments);
+		results["overdraw"] = SummarizeTimes(overdraw);
+		results["pipelineCreationMs"] = pipelineCreationMs;
+		results["firstFrameMs"] = firstFrameMs;
+		results["textureLoad"] = {
+			{"ms", textureLoadMs},
+			{"textures", texturesLoaded},
+			{"baked", texturesBaked},
+			{"bytes", textureBytes},
+			{"bytesSaved", textureBytesRGBA8 - textureBytes},
+			{"encodeMBps", textureEncodeMs > 0.0 ? textureEncodedBytes / textureEncodeMs / 1000.0 : 0.0},
+			{"streaming", textureStreamer.enabled},
+			{"streamedMs", textureStreamer.completeMs}
+		};
+		if (occlusionCuller.enabled()) {
+			results["occlusion"] = {
+				{"objects", occlusionCuller.objects.size()},
+				{"tested", occlusionCuller.tested},
+				{"occluded", occlusionCuller.occluded},
+				{"occludedPercent", occlusionCuller.occludedPercent()},
+				{"frustumCulled", occlusionCuller.frustumCulled},
+				{"drawnLate", occlusionCuller.drawnLate}
+			};
+		}
+		if (shadowMap.enabled()) {
+			results["shadowMapRenderedFrames"] = shadowMap.renderedFrames;
+			results["shadowMapReusedFrames"] = shadowMap.reusedFrames;
+		}
+		results["pipelineCacheWarm"] = pipelineCacheWarm;
+		results["scene"] = benchmarkSceneState();
+		addBenchmarkResults(results);
+
+		std::ofstream out(options.benchmarkOutput);
+		if (!out.is_open()) {
+			throw std::runtime_error("failed to open " + options.benchmarkOutput + "!");
+		}
+		out << results.dump(4) << "\n";
+		std::cout << results.dump(4) << "\n";
+		std::cout << "Benchmark results written to " << options.benchmarkOutput << "\n";
+	}
     
     // Lesson 22.6
     void drawFrame() {
-		vkWaitForFences(device, 1, &inFlightFences[currentFrame],
-						VK_TRUE, UINT64_MAX);
+		PROFILE_ZONE("drawFrame");
+		{
+			PROFILE_ZONE("wait frame fence");
+			vkWaitForFences(device, 1, &inFlightFences[currentFrame],
+							VK_TRUE, UINT64_MAX);
+		}
+
+		applyReloadedPipelines();
+		if (textureStreamer.update()) {
+			invalidateCommandBuffers();
+		}
 		
 		uint32_t imageIndex;
 		
-		VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX,
-				imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		VkResult result;
+		if (options.headless) {
+			// offscreen images are simply used in turn
+			imageIndex = static_cast<uint32_t>(frameCount % swapChainImages.size());
+		} else {
+			PROFILE_ZONE("acquire image");
+			result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX,
+					imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		}
+		if (!options.headless) {
+			if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+				// nothing was acquired and the frame fence is still signaled
+				recreateSwapChain();
+				return;
+			}
+			if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+				PrintVkError(result);
+				throw std::runtime_error("failed to acquire swap chain image!");
+			}
+		}
 
 		if (imagesInFlight[imageIndex] != VK_NULL_HANDLE) {
+			PROFILE_ZONE("wait image fence");
 			vkWaitForFences(device, 1, &imagesInFlight[imageIndex],
 							VK_TRUE, UINT64_MAX);
+			// the previous submission of this image is complete: its
+			// timestamps are available without stalling
+			gpuProfiler.collect(imageIndex);
+			if (occlusionCuller.enabled()) {
+				occlusionCuller.collect(imageIndex);
+			}
 		}
 		imagesInFlight[imageIndex] = inFlightFences[currentFrame];
 		
 		updateUniformBuffer(imageIndex);
+		// after the update, which may change what is drawn (e.g. the draw order)
+		rerecordIfDirty(imageIndex);
 		
 		VkSubmitInfo submitInfo{};
 		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 		VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
 		VkPipelineStageFlags waitStages[] =
 			{VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.waitSemaphoreCount = options.headless ? 0 : 1;
 		submitInfo.pWaitSemaphores = waitSemaphores;
 		submitInfo.pWaitDstStageMask = waitStages;
-		submitInfo.commandBufferCount = 1;
-		submitInfo.pCommandBuffers = &commandBuffers[imageIndex];
+		// the shadow map pass runs first, only if something it depends on changed
+		std::vector<VkCommandBuffer> submitted;
+		if (shadowMap.enabled()) {
+			if (shadowMap.dirty) {
+				submitted.push_back(shadowCommandBuffers[imageIndex]);
+				shadowMap.dirty = false;
+				shadowMap.renderedFrames++;
+			} else {
+				shadowMap.reusedFrames++;
+			}
+		}
+		submitted.push_back(commandBuffers[imageIndex]);
+		submitInfo.commandBufferCount = static_cast<uint32_t>(submitted.size());
+		submitInfo.pCommandBuffers = submitted.data();
 		VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.signalSemaphoreCount = options.headless ? 0 : 1;
 		submitInfo.pSignalSemaphores = signalSemaphores;
 		
 		vkResetFences(device, 1, &inFlightFences[currentFrame]);
 
-		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo,
-				inFlightFences[currentFrame]) != VK_SUCCESS) {
-			throw std::runtime_error("failed to submit draw command buffer!");
+		{
+			PROFILE_ZONE("queue submit");
+			if (vkQueueSubmit(graphicsQueue, 1, &submitInfo,
+					inFlightFences[currentFrame]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to submit draw command buffer!");
+			}
+		}
+
+		gpuProfiler.markSubmitted(imageIndex, frameCount);
+		if (occlusionCuller.enabled()) {
+			occlusionCuller.pending[imageIndex] = true;
+		}
+		lastImageIndex = imageIndex;
+		if (frameCount == 0) {
+			firstFrameMs = std::chrono::duration<double, std::milli>(
+					std::chrono::steady_clock::now() - runStart).count();
+			std::cout << "First frame submitted " << firstFrameMs << " ms after start\n";
+		}
+		frameCount++;
+
+		if (options.headless) {
+			currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+			return;
 		}
 		
 		VkPresentInfoKHR presentInfo{};
@@ -1444,38 +3093,85 @@ protected:
 		presentInfo.pImageIndices = &imageIndex;
 		presentInfo.pResults = nullptr; // Optional
 		
-		result = vkQueuePresentKHR(presentQueue, &presentInfo);
+		{
+			PROFILE_ZONE("present");
+			result = vkQueuePresentKHR(presentQueue, &presentInfo);
+		}
 
 		currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+		// not every platform reports a resize through the present result
+		int width, height;
+		glfwGetFramebufferSize(window, &width, &height);
+		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR ||
+			width != framebufferWidth || height != framebufferHeight) {
+			recreateSwapChain();
+		} else if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to present swap chain image!");
+		}
     }
 
 	virtual void updateUniformBuffer(uint32_t currentImage) = 0;
+	// draws the shadow casters, inside the render pass of shadowMap
+	virtual void populateShadowCommandBuffer(VkCommandBuffer commandBuffer, int currentImage) {}
+	// with occlusion culling: draws the opaque objects, with OcclusionCuller::drawIndexed
+	// for those that can be culled, once in the early and once in the late render pass
+	virtual void populateOccluders(VkCommandBuffer, int, bool) {}
+
+	// Prints the GPU timings and writes them next to the executable
+	void dumpGpuProfile() {
+		gpuProfiler.printSummary();
+		if (occlusionCuller.enabled()) {
+			std::cout << "Occlusion culling: " << occlusionCuller.occludedPercent() << "% of "
+					  << occlusionCuller.tested << " tested objects occluded, "
+					  << occlusionCuller.frustumCulled << " outside the view, "
+					  << occlusionCuller.drawnLate << " drawn in the late pass\n";
+		}
+		if (shadowMap.enabled()) {
+			std::cout << "Shadow map: rendered in " << shadowMap.renderedFrames
+					  << " frames, cache reused in " << shadowMap.reusedFrames << "\n";
+		}
+		gpuProfiler.writeCSV("gpu_profile.csv");
+		gpuProfiler.writeJSON("gpu_profile.json");
+	}
 
 	virtual void localCleanup() = 0;
+	// the swap chain image count changed: every DescriptorSet must be
+	// recreated, and the uniform buffers not written each frame filled again
+	virtual void recreateDescriptorSets() = 0;
 	
 	// All lessons
 	
     void cleanup() {
-		vkDestroyImageView(device, depthImageView, nullptr);
-		vkDestroyImage(device, depthImage, nullptr);
-		vkFreeMemory(device, depthImageMemory, nullptr);
+		stopShaderWatcher();
+		releaseReloadedPipelines();
 
-		for (size_t i = 0; i < swapChainFramebuffers.size(); i++) {
-			vkDestroyFramebuffer(device, swapChainFramebuffers[i], nullptr);
-		}
+		cleanupSwapChain();
 		
 		vkFreeCommandBuffers(device, commandPool,
 				static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+		if (!shadowCommandBuffers.empty()) {
+			vkFreeCommandBuffers(device, commandPool,
+					static_cast<uint32_t>(shadowCommandBuffers.size()), shadowCommandBuffers.data());
+		}
 
-		vkDestroyRenderPass(device, renderPass, nullptr);
+		gpuProfiler.cleanup();
+		occlusionCuller.cleanup();
+		textureStreamer.cleanup();
 
-		for (size_t i = 0; i < swapChainImageViews.size(); i++){
-			vkDestroyImageView(device, swapChainImageViews[i], nullptr);
-		}
+		vkDestroyRenderPass(device, renderPass, nullptr);
 		
-		vkDestroySwapchainKHR(device, swapChain, nullptr);
+		if (options.headless) {
+			for (size_t i = 0; i < swapChainImages.size(); i++) {
+				vkDestroyImage(device, swapChainImages[i], nullptr);
+				vkFreeMemory(device, offscreenImagesMemory[i], nullptr);
+			}
+		} else {
+			vkDestroySwapchainKHR(device, swapChain, nullptr);
+		}
 		
-		vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+		descriptorAllocator.cleanup();
     	
     	
 		localCleanup();
@@ -1487,17 +3183,26 @@ protected:
     	}
     	
     	vkDestroyCommandPool(device, commandPool, nullptr);
+
+		savePipelineCache();
+		vkDestroyPipelineCache(device, pipelineCache, nullptr);
     	
  		vkDestroyDevice(device, nullptr);
 		
-		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+		if (enableValidationLayers) {
+			DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+		}
 		
-		vkDestroySurfaceKHR(instance, surface, nullptr);
+		if (!options.headless) {
+			vkDestroySurfaceKHR(instance, surface, nullptr);
+		}
     	vkDestroyInstance(instance, nullptr);
 
-        glfwDestroyWindow(window);
+		if (!options.headless) {
+	        glfwDestroyWindow(window);
 
-        glfwTerminate();
+	        glfwTerminate();
+	    }
     }
 	
 };
@@ -1506,13 +3211,14 @@ protected:
 
 
 void Model::loadModel(std::string file) {
+	PROFILE_ZONE("Model::loadModel");
 	tinyobj::attrib_t attrib;
 	std::vector<tinyobj::shape_t> shapes;
 	std::vector<tinyobj::material_t> materials;
 	std::string warn, err;
 	
 	if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
-						  file.c_str())) {
+						  ResolveAssetPath(file).c_str())) {
 		throw std::runtime_error(warn + err);
 	}
 	
@@ -1594,53 +3300,261 @@ void Model::cleanup() {
 
 
 
-void Texture::createTextureImage(std::string file) {
-	int texWidth, texHeight, texChannels;
-	stbi_uc* pixels = stbi_load(file.c_str(), &texWidth, &texHeight,
-						&texChannels, STBI_rgb_alpha);
-	if (!pixels) {
-		throw std::runtime_error("failed to load texture image!");
-	}
+enum class TextureEncoding { RGBA8, BC, BC7 };
 
-	VkDeviceSize imageSize = texWidth * texHeight * 4;
-	mipLevels = static_cast<uint32_t>(std::floor(
-					std::log2(std::max(texWidth, texHeight)))) + 1;
-	
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	 
-	BP->createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+// Parses --texture-format
+bool ParseTextureEncoding(const std::string &name, TextureEncoding &encoding) {
+	if (name == "auto") encoding = TextureEncoding::BC;
+	else if (name == "bc7") encoding = TextureEncoding::BC7;
+	else if (name == "rgba8") encoding = TextureEncoding::RGBA8;
+	else return false;
+	return true;
+}
+
+bool IsBlockCompressed(VkFormat format) {
+	return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+}
+
+// The mip chains of image files (one layer each), decoded and filtered on the
+// CPU, then block compressed unless encoding is RGBA8: BC1 when every texel
+// is opaque, BC3 otherwise, or BC7. Laid out as in a texture container: each
+// level holds all the layers. The layers are decoded in parallel (the six
+// faces of a cubemap), each expanded to RGBA8 straight into its slice of
+// level 0, then filtered into the next levels by GenerateMipLevel.
+std::vector<uint8_t> BakeTextureData(const std::vector<std::string> &sources, TextureEncoding encoding,
+									 MipFilter mipFilter, TextureContainerHeader &header, double &encodeMs,
+									 uint64_t &encodedBytes) {
+	int texWidth = 0, texHeight = 0, texChannels;
+	for (const std::string &source : sources) {
+		int w, h;
+		if (!stbi_info(source.c_str(), &w, &h, &texChannels)) {
+			throw std::runtime_error("failed to load texture image " + source + "!");
+		}
+		if (texWidth != 0 && (w != texWidth || h != texHeight)) {
+			throw std::runtime_error("texture layers of different sizes: " + source + "!");
+		}
+		texWidth = w;
+		texHeight = h;
+	}
+
+	header = {};
+	header.width = static_cast<uint32_t>(texWidth);
+	header.height = static_cast<uint32_t>(texHeight);
+	header.levels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
+	header.layers = static_cast<uint32_t>(sources.size());
+	header.format = VK_FORMAT_R8G8B8A8_SRGB;
+	header.bytesPerBlock = 4;
+	std::vector<TextureContainerLevel> chainLevels = TextureContainer::levelTable(header);
+	std::vector<uint8_t> chain(chainLevels.back().offset + chainLevels.back().size);
+
+	std::vector<char> opaque(sources.size(), 1);
+	std::atomic<bool> failed(false);
+	ParallelFor(sources.size(), [&](size_t begin, size_t end) {
+		for (size_t layer = begin; layer < end; layer++) {
+			int w, h, channels;
+			// decoded with the channels of the file, to expand them only once
+			stbi_uc* pixels = stbi_load(sources[layer].c_str(), &w, &h, &channels, 0);
+			if (!pixels || w != texWidth || h != texHeight) {
+				stbi_image_free(pixels);
+				failed = true;
+				continue;
+			}
+			size_t count = size_t(w) * h;
+			if (channels == 2 || channels == 4) {
+				for (size_t i = channels - 1; i < count * channels && opaque[layer]; i += channels) {
+					opaque[layer] = pixels[i] == 255;
+				}
+			}
+			ExpandToRGBA8(pixels, channels, count, &chain[chainLevels[0].size / header.layers * layer]);
+			stbi_image_free(pixels);
+		}
+	}, 1);
+	if (failed) {
+		throw std::runtime_error("failed to load texture image!");
+	}
+
+	// each level is filtered in parallel bands of rows
+	for (uint32_t layer = 0; layer < header.layers; layer++) {
+		std::vector<uint8_t *> levels;
+		for (const TextureContainerLevel &level : chainLevels) {
+			levels.push_back(&chain[level.offset + level.size / header.layers * layer]);
+		}
+		GenerateMipChain(levels, header.width, header.height, true, mipFilter);
+	}
+	if (encoding == TextureEncoding::RGBA8) {
+		return chain;
+	}
+
+	BlockFormat blockFormat = BlockFormat::BC7;
+	header.format = VK_FORMAT_BC7_SRGB_BLOCK;
+	if (encoding == TextureEncoding::BC) {
+		bool allOpaque = std::all_of(opaque.begin(), opaque.end(), [](char o) { return o != 0; });
+		header.format = allOpaque ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC3_SRGB_BLOCK;
+		blockFormat = allOpaque ? BlockFormat::BC1 : BlockFormat::BC3;
+	}
+	header.bytesPerBlock = static_cast<uint32_t>(BlockBytes(blockFormat));
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<TextureContainerLevel> levels = TextureContainer::levelTable(header);
+	std::vector<uint8_t> data(levels.back().offset + levels.back().size);
+	for (uint32_t level = 0; level < header.levels; level++) {
+		uint32_t w = std::max(1u, header.width >> level), h = std::max(1u, header.height >> level);
+		uint64_t chainSize = chainLevels[level].size / header.layers, size = levels[level].size / header.layers;
+		for (uint32_t layer = 0; layer < header.layers; layer++) {
+			CompressImage(&chain[chainLevels[level].offset + chainSize * layer], w, h, blockFormat,
+						  &data[levels[level].offset + size * layer]);
+		}
+	}
+	encodedBytes += chain.size();
+	encodeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return data;
+}
+
+bool BakeTextureContainer(const std::string &source, const std::string &destination, TextureEncoding encoding,
+						  MipFilter mipFilter) {
+	TextureContainerHeader header;
+	double encodeMs = 0.0;
+	uint64_t encodedBytes = 0;
+	std::vector<uint8_t> data = BakeTextureData({ source }, encoding, mipFilter, header, encodeMs, encodedBytes);
+	return TextureContainer::write(destination, header, data.data());
+}
+
+const char *TextureEncodingName(TextureEncoding encoding) {
+	return encoding == TextureEncoding::RGBA8 ? "rgba8-srgb" : encoding == TextureEncoding::BC ? "bc-srgb" : "bc7-srgb";
+}
+
+TextureUpload Texture::prepareUpload(BaseProject *BP, const std::vector<std::string> &files, bool placeholder) {
+	std::vector<std::string> sources;
+	for (const std::string &file : files) {
+		sources.push_back(ResolveAssetPath(file));
+	}
+
+	TextureEncoding encoding = TextureEncoding::BC;
+	ParseTextureEncoding(BP->options.textureFormat, encoding);
+	if (!BP->textureCompressionBC) {
+		encoding = TextureEncoding::RGBA8;
+	}
+	MipFilter mipFilter = MipFilter::Kaiser;
+	ParseMipFilter(BP->options.mipFilter, mipFilter);
+	std::string cache = TextureCachePath(sources, std::string(TextureEncodingName(encoding)) + "-" + MipFilterName(mipFilter));
+
+	// a container baked next to the image (e.g. "textures/Wood.png.tgtx"),
+	// else the one in the cache; with no container yet, decode the images
+	// once and leave the result in the cache for the next runs
+	TextureUpload upload;
+	TextureContainer container;
+	std::vector<uint8_t> baked;
+	bool found = (sources.size() == 1 && container.open(sources[0] + TEXTURE_CONTAINER_EXTENSION) &&
+				  (BP->textureCompressionBC || !IsBlockCompressed(static_cast<VkFormat>(container.header.format)))) ||
+				 container.open(cache);
+	uint32_t first = 0;
+	if (found && placeholder) {
+		while (first + 1 < container.header.levels &&
+			   std::max(container.header.width >> first, container.header.height >> first) > TEXTURE_PLACEHOLDER_SIZE) {
+			first++;
+		}
+	} else if (!found && placeholder) {
+		baked.assign(4 * sources.size(), 128);
+		for (size_t layer = 0; layer < sources.size(); layer++) baked[4 * layer + 3] = 255;
+		container.header = {};
+		container.header.format = VK_FORMAT_R8G8B8A8_SRGB;
+		container.header.width = container.header.height = 1;
+		container.header.levels = 1;
+		container.header.layers = static_cast<uint32_t>(sources.size());
+		container.header.bytesPerBlock = 4;
+	} else if (!found) {
+		baked = BakeTextureData(sources, encoding, mipFilter, container.header, upload.encodeMs, upload.encodedBytes);
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(cache).parent_path(), ec);
+		if (!TextureContainer::write(cache, container.header, baked.data())) {
+			std::cout << "Could not write the texture cache " << cache << "\n";
+		}
+		upload.baked = true;
+	}
+	if (!baked.empty()) {
+		container.levels = TextureContainer::levelTable(container.header);
+		container.dataSize = container.levels.back().offset + container.levels.back().size;
+	}
+
+	// the levels from first on
+	upload.header = container.header;
+	upload.header.width = std::max(1u, container.header.width >> first);
+	upload.header.height = std::max(1u, container.header.height >> first);
+	upload.header.levels = container.header.levels - first;
+	for (uint32_t level = first; level < container.header.levels; level++) {
+		upload.levels.push_back({ container.levels[level].offset - container.levels[first].offset,
+								  container.levels[level].size });
+	}
+
+	VkDeviceSize imageSize = container.dataSize - container.levels[first].offset;
+	BP->createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 	  						VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
 	  						VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-	  						stagingBuffer, stagingBufferMemory);
+	  						upload.stagingBuffer, upload.stagingBufferMemory);
 	void* data;
-	vkMapMemory(BP->device, stagingBufferMemory, 0, imageSize, 0, &data);
-	memcpy(data, pixels, static_cast<size_t>(imageSize));
-	vkUnmapMemory(BP->device, stagingBufferMemory);
-	
-	stbi_image_free(pixels);
-	
-	BP->createImage(texWidth, texHeight, mipLevels, VK_FORMAT_R8G8B8A8_SRGB,
-				VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+	vkMapMemory(BP->device, upload.stagingBufferMemory, 0, imageSize, 0, &data);
+	if (baked.empty()) {
+		container.readData(data, first);
+	} else {
+		memcpy(data, baked.data(), baked.size());
+	}
+	vkUnmapMemory(BP->device, upload.stagingBufferMemory);
+	return upload;
+}
+
+void Texture::createUploadImage(BaseProject *BP, const TextureUpload &upload, VkImageCreateFlags flags,
+								VkImage &image, VkDeviceMemory &memory) {
+	BP->createImage(upload.header.width, upload.header.height, upload.header.levels,
+				static_cast<VkFormat>(upload.header.format), VK_IMAGE_TILING_OPTIMAL,
 				VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage,
-				textureImageMemory);
-				
-	BP->transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_SRGB,
-			VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
-	BP->copyBufferToImage(stagingBuffer, textureImage,
-			static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image,
+				memory, upload.header.layers, flags);
+}
+
+// statistics of a complete texture
+void Texture::countUpload(BaseProject *BP, const TextureUpload &upload) {
+	const TextureContainerHeader &header = upload.header;
+	BP->texturesLoaded++;
+	BP->texturesBaked += upload.baked ? 1 : 0;
+	BP->textureEncodeMs += upload.encodeMs;
+	BP->textureEncodedBytes += upload.encodedBytes;
+	BP->textureBytes += upload.levels.back().offset + upload.levels.back().size;
+	for (uint32_t level = 0; level < header.levels; level++) {
+		BP->textureBytesRGBA8 += uint64_t(std::max(1u, header.width >> level)) *
+								 std::max(1u, header.height >> level) * 4 * header.layers;
+	}
+}
+
+void Texture::loadImage(BaseProject *BP, const std::vector<std::string> &files, VkImageCreateFlags flags,
+						VkImage &image, VkDeviceMemory &memory, VkFormat &format, uint32_t &mipLevels,
+						bool placeholder) {
+	auto start = std::chrono::steady_clock::now();
+	TextureUpload upload = prepareUpload(BP, files, placeholder);
+	format = static_cast<VkFormat>(upload.header.format);
+	mipLevels = upload.header.levels;
+
+	createUploadImage(BP, upload, flags, image, memory);
+	BP->uploadTextureLevels(upload.stagingBuffer, image, upload.header, upload.levels);
 
-	BP->generateMipmaps(textureImage, VK_FORMAT_R8G8B8A8_SRGB,
-					texWidth, texHeight, mipLevels);
+	vkDestroyBuffer(BP->device, upload.stagingBuffer, nullptr);
+	vkFreeMemory(BP->device, upload.stagingBufferMemory, nullptr);
 
-	vkDestroyBuffer(BP->device, stagingBuffer, nullptr);
-	vkFreeMemory(BP->device, stagingBufferMemory, nullptr);
+	if (!placeholder) {
+		countUpload(BP, upload);
+	}
+	BP->textureLoadMs += std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count();
+}
+
+void Texture::createTextureImage(std::string file) {
+	PROFILE_ZONE("Texture::createTextureImage");
+	loadImage(BP, { file }, 0, textureImage, textureImageMemory, format, mipLevels,
+			  BP->textureStreamer.enabled);
 }
 
 void Texture::createTextureImageView() {
 	textureImageView = BP->createImageView(textureImage,
-									   VK_FORMAT_R8G8B8A8_SRGB,
+									   format,
 									   VK_IMAGE_ASPECT_COLOR_BIT,
 									   mipLevels);
 }
@@ -1662,7 +3576,8 @@ void Texture::createTextureSampler() {
 	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
 	samplerInfo.mipLodBias = 0.0f;
 	samplerInfo.minLod = 0.0f;
-	samplerInfo.maxLod = static_cast<float>(mipLevels);
+	// no clamp: a streamed texture gets its full mip chain later
+	samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
 	
 	VkResult result = vkCreateSampler(BP->device, &samplerInfo, nullptr,
 									  &textureSampler);
@@ -1676,9 +3591,14 @@ void Texture::createTextureSampler() {
 
 void Texture::init(BaseProject *bp, std::string file) {
 	BP = bp;
+	index = BP->registerTexture(this);
 	createTextureImage(file);
 	createTextureImageView();
 	createTextureSampler();
+	if (BP->textureStreamer.enabled) {
+		BP->textureStreamer.add({ file }, 0, { &textureImage, &textureImageMemory, &textureImageView, &format,
+									&mipLevels, VK_IMAGE_VIEW_TYPE_2D, textureSampler, &bindings });
+	}
 }
 
 void Texture::cleanup() {
@@ -1693,63 +3613,14 @@ void Texture::cleanup() {
 
 
 void CubicTexture::createCubicTextureImage(const std::string file[6]) {
-	int texWidth, texHeight, texChannels;
-	stbi_uc* pixels[6];
-	for (int i = 0; i < 6; i++) {
-		pixels[i] = stbi_load(file[i].c_str(), &texWidth, &texHeight,
-			&texChannels, STBI_rgb_alpha);
-		if (!pixels[i]) {
-			std::cout << file[i].c_str() << "\n";
-			throw std::runtime_error("failed to load texture image!");
-		}
-		std::cout << file[i] << " -> size: " << texWidth
-			<< "x" << texHeight << ", ch: " << texChannels << "\n";
-	}
-
-	VkDeviceSize imageSize = texWidth * texHeight * 4;
-	VkDeviceSize totalImageSize = texWidth * texHeight * 4 * 6;
-	mipLevels = static_cast<uint32_t>(std::floor(
-		std::log2(std::max(texWidth, texHeight)))) + 1;
-
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-
-	BP->createBuffer(totalImageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-		VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-		stagingBuffer, stagingBufferMemory);
-	void* data;
-	vkMapMemory(BP->device, stagingBufferMemory, 0, totalImageSize, 0, &data);
-	for (int i = 0; i < 6; i++) {
-		memcpy(static_cast<char*>(data) + imageSize * i, pixels[i], static_cast<size_t>(imageSize));
-	}
-	vkUnmapMemory(BP->device, stagingBufferMemory);
-
-	for (int i = 0; i < 6; i++) {
-		stbi_image_free(pixels[i]);
-	}
-
-	BP->createImage(texWidth, texHeight, mipLevels, VK_FORMAT_R8G8B8A8_SRGB,
-		VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-		VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage,
-		textureImageMemory, 6, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
-
-	BP->transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_SRGB,
-		VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, 6);
-	BP->copyBufferToImage(stagingBuffer, textureImage,
-		static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight), 6);
-
-	BP->generateMipmaps(textureImage, VK_FORMAT_R8G8B8A8_SRGB,
-		texWidth, texHeight, mipLevels, 6);
-
-	vkDestroyBuffer(BP->device, stagingBuffer, nullptr);
-	vkFreeMemory(BP->device, stagingBufferMemory, nullptr);
+	PROFILE_ZONE("CubicTexture::createCubicTextureImage");
+	Texture::loadImage(BP, std::vector<std::string>(file, file + 6), VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
+					   textureImage, textureImageMemory, format, mipLevels, BP->textureStreamer.enabled);
 }
 
 void CubicTexture::createCubicImageView() {
 	textureImageView = BP->createImageView(textureImage,
-		VK_FORMAT_R8G8B8A8_SRGB,
+		format,
 		VK_IMAGE_ASPECT_COLOR_BIT,
 		mipLevels, VK_IMAGE_VIEW_TYPE_CUBE, 6);
 }
@@ -1771,7 +3642,8 @@ void CubicTexture::createCubicTextureSampler() {
 	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
 	samplerInfo.mipLodBias = 0.0f;
 	samplerInfo.minLod = 0.0f;
-	samplerInfo.maxLod = static_cast<float>(mipLevels);
+	// no clamp: a streamed texture gets its full mip chain later
+	samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
 
 	VkResult result = vkCreateSampler(BP->device, &samplerInfo, nullptr,
 		&textureSampler);
@@ -1788,6 +3660,11 @@ void CubicTexture::init(BaseProject* bp, const std::string file[6]) {
 	createCubicTextureImage(file);
 	createCubicImageView();
 	createCubicTextureSampler();
+	if (BP->textureStreamer.enabled) {
+		BP->textureStreamer.add(std::vector<std::string>(file, file + 6), VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
+								{ &textureImage, &textureImageMemory, &textureImageView, &format, &mipLevels,
+								  VK_IMAGE_VIEW_TYPE_CUBE, textureSampler, &bindings });
+	}
 }
 
 void CubicTexture::cleanup() {
@@ -1798,25 +3675,418 @@ void CubicTexture::cleanup() {
 }
 
 
+void TextureStreamer::init(BaseProject *bp, bool enable) {
+	BP = bp;
+	enabled = enable;
+	start = std::chrono::steady_clock::now();
+	if (enabled) {
+		worker = std::thread(&TextureStreamer::work, this);
+	}
+}
+
+void TextureStreamer::add(const std::vector<std::string> &files, VkImageCreateFlags flags,
+						  const TextureTarget &target) {
+	std::unique_ptr<Job> job = std::make_unique<Job>();
+	job->files = files;
+	job->flags = flags;
+	job->target = target;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queued.push_back(std::move(job));
+	}
+	remaining++;
+	wake.notify_one();
+}
+
+// worker thread: the file reads and the decoding, away from the frames
+void TextureStreamer::work() {
+	CpuTraceSetThreadName("texture streamer");
+	while (true) {
+		std::unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this]() { return stopping || !queued.empty(); });
+			if (stopping) return;
+			job = std::move(queued.front());
+			queued.pop_front();
+		}
+		try {
+			PROFILE_ZONE("TextureStreamer::prepare");
+			job->upload = Texture::prepareUpload(BP, job->files, false);
+		} catch (const std::exception &e) {
+			// the placeholder stays
+			std::cout << "Streaming of " << job->files[0] << " failed: " << e.what() << "\n";
+			continue;
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		prepared.push_back(std::move(job));
+	}
+}
+
+// At the frame boundary: submits the uploads of the prepared textures and
+// puts in place the ones whose upload completed. True if any changed, the
+// command buffers must then be recorded again.
+bool TextureStreamer::update() {
+	if (!enabled) return false;
+	PROFILE_ZONE("TextureStreamer::update");
+	std::vector<std::unique_ptr<Job>> ready;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		ready.swap(prepared);
+	}
+	for (std::unique_ptr<Job> &job : ready) {
+		Texture::createUploadImage(BP, job->upload, job->flags, job->image, job->memory);
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = BP->commandPool;
+		allocInfo.commandBufferCount = 1;
+		VkResult result = vkAllocateCommandBuffers(BP->device, &allocInfo, &job->commandBuffer);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to allocate texture upload command buffer!");
+		}
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		result = vkBeginCommandBuffer(job->commandBuffer, &beginInfo);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to begin recording texture upload command buffer!");
+		}
+		BP->recordTextureUpload(job->commandBuffer, job->upload.stagingBuffer, job->image,
+								job->upload.header, job->upload.levels);
+		result = vkEndCommandBuffer(job->commandBuffer);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to record texture upload command buffer!");
+		}
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		result = vkCreateFence(BP->device, &fenceInfo, nullptr, &job->fence);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to create texture upload fence!");
+		}
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &job->commandBuffer;
+		result = vkQueueSubmit(BP->graphicsQueue, 1, &submitInfo, job->fence);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to submit texture upload!");
+		}
+		uploading.push_back(std::move(job));
+	}
+
+	bool changed = false;
+	for (auto it = uploading.begin(); it != uploading.end();) {
+		Job &job = **it;
+		if (vkGetFenceStatus(BP->device, job.fence) != VK_SUCCESS) {
+			++it;
+			continue;
+		}
+		vkDestroyFence(BP->device, job.fence, nullptr);
+		vkFreeCommandBuffers(BP->device, BP->commandPool, 1, &job.commandBuffer);
+		vkDestroyBuffer(BP->device, job.upload.stagingBuffer, nullptr);
+		vkFreeMemory(BP->device, job.upload.stagingBufferMemory, nullptr);
+
+		// the placeholder is released once no image binds it
+		const TextureTarget &target = job.target;
+		Retired placeholder{ *target.image, *target.memory, *target.view, *target.bindings,
+							 VK_NULL_HANDLE, target.sampler,
+							 std::vector<bool>(BP->commandBuffers.size(), true) };
+		*target.image = job.image;
+		*target.memory = job.memory;
+		*target.format = static_cast<VkFormat>(job.upload.header.format);
+		*target.mipLevels = job.upload.header.levels;
+		*target.view = BP->createImageView(job.image, *target.format, VK_IMAGE_ASPECT_COLOR_BIT,
+										   *target.mipLevels, target.viewType, job.upload.header.layers);
+		placeholder.fullView = *target.view;
+		retired.push_back(placeholder);
+
+		Texture::countUpload(BP, job.upload);
+		it = uploading.erase(it);
+		changed = true;
+		if (--remaining == 0) {
+			completeMs = std::chrono::duration<double, std::milli>(
+					std::chrono::steady_clock::now() - start).count();
+			std::cout << "Textures streamed in " << completeMs << " ms\n";
+			BP->printTextureStatistics();
+		}
+	}
+	return changed;
+}
+
+// to be called once the previous submission of the image has completed,
+// before recording it again
+void TextureStreamer::switchDescriptors(uint32_t image) {
+	for (auto it = retired.begin(); it != retired.end();) {
+		if (it->referencedByImage[image]) {
+			for (const TextureBinding &b : it->bindings) {
+				if (b.image != image) continue;
+				VkDescriptorImageInfo imageInfo{};
+				imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				imageInfo.imageView = it->fullView;
+				imageInfo.sampler = it->sampler;
+
+				VkWriteDescriptorSet write{};
+				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				write.dstSet = b.set;
+				write.dstBinding = b.binding;
+				write.dstArrayElement = b.arrayElement;
+				write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				write.descriptorCount = 1;
+				write.pImageInfo = &imageInfo;
+				vkUpdateDescriptorSets(BP->device, 1, &write, 0, nullptr);
+			}
+			it->referencedByImage[image] = false;
+		}
+		if (std::none_of(it->referencedByImage.begin(), it->referencedByImage.end(),
+						 [](bool b) { return b; })) {
+			vkDestroyImageView(BP->device, it->view, nullptr);
+			vkDestroyImage(BP->device, it->image, nullptr);
+			vkFreeMemory(BP->device, it->memory, nullptr);
+			it = retired.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+// with the device idle
+void TextureStreamer::cleanup() {
+	if (!enabled) return;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_one();
+	worker.join();
+
+	for (std::unique_ptr<Job> &job : prepared) {
+		vkDestroyBuffer(BP->device, job->upload.stagingBuffer, nullptr);
+		vkFreeMemory(BP->device, job->upload.stagingBufferMemory, nullptr);
+	}
+	for (std::unique_ptr<Job> &job : uploading) {
+		vkDestroyFence(BP->device, job->fence, nullptr);
+		vkFreeCommandBuffers(BP->device, BP->commandPool, 1, &job->commandBuffer);
+		vkDestroyBuffer(BP->device, job->upload.stagingBuffer, nullptr);
+		vkFreeMemory(BP->device, job->upload.stagingBufferMemory, nullptr);
+		vkDestroyImage(BP->device, job->image, nullptr);
+		vkFreeMemory(BP->device, job->memory, nullptr);
+	}
+	prepared.clear();
+	uploading.clear();
+	releaseRetired();
+}
+
+void TextureStreamer::releaseRetired() {
+	for (const Retired &r : retired) {
+		vkDestroyImageView(BP->device, r.view, nullptr);
+		vkDestroyImage(BP->device, r.image, nullptr);
+		vkFreeMemory(BP->device, r.memory, nullptr);
+	}
+	retired.clear();
+}
+
+
+
+void ShadowMap::init(BaseProject *bp, uint32_t mapSize) {
+	BP = bp;
+	size = mapSize;
+
+	BP->createImage(size, size, 1, format, VK_IMAGE_TILING_OPTIMAL,
+					VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, imageMemory);
+	imageView = BP->createImageView(image, format, VK_IMAGE_ASPECT_DEPTH_BIT, 1);
+
+	// hardware 2x2 PCF: each lookup returns the filtered result of the comparison
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_LINEAR;
+	samplerInfo.minFilter = VK_FILTER_LINEAR;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+	samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;	// outside the map: lit
+	samplerInfo.anisotropyEnable = VK_FALSE;
+	samplerInfo.maxAnisotropy = 1.0f;
+	samplerInfo.unnormalizedCoordinates = VK_FALSE;
+	samplerInfo.compareEnable = VK_TRUE;
+	samplerInfo.compareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerInfo.minLod = 0.0f;
+	samplerInfo.maxLod = 0.0f;
+
+	VkResult result = vkCreateSampler(BP->device, &samplerInfo, nullptr, &sampler);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create shadow map sampler!");
+	}
+
+	VkAttachmentDescription depthAttachment{};
+	depthAttachment.format = format;
+	depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+	depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	depthAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+	VkAttachmentReference depthAttachmentRef{};
+	depthAttachmentRef.attachment = 0;
+	depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+	VkSubpassDescription subpass{};
+	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpass.colorAttachmentCount = 0;
+	subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+	// the previous frames stop reading the map before it is cleared, and
+	// the lit pass of this frame reads it only once it is written
+	std::array<VkSubpassDependency, 2> dependencies{};
+	dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[0].dstSubpass = 0;
+	dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+	dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	dependencies[1].srcSubpass = 0;
+	dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	VkRenderPassCreateInfo renderPassInfo{};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassInfo.attachmentCount = 1;
+	renderPassInfo.pAttachments = &depthAttachment;
+	renderPassInfo.subpassCount = 1;
+	renderPassInfo.pSubpasses = &subpass;
+	renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+	renderPassInfo.pDependencies = dependencies.data();
+
+	result = vkCreateRenderPass(BP->device, &renderPassInfo, nullptr, &renderPass);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create shadow map render pass!");
+	}
+
+	VkFramebufferCreateInfo framebufferInfo{};
+	framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+	framebufferInfo.renderPass = renderPass;
+	framebufferInfo.attachmentCount = 1;
+	framebufferInfo.pAttachments = &imageView;
+	framebufferInfo.width = size;
+	framebufferInfo.height = size;
+	framebufferInfo.layers = 1;
+
+	result = vkCreateFramebuffer(BP->device, &framebufferInfo, nullptr, &framebuffer);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create shadow map framebuffer!");
+	}
+	dirty = true;
+}
+
+void ShadowMap::cleanup() {
+	if (!enabled()) return;
+	vkDestroyFramebuffer(BP->device, framebuffer, nullptr);
+	vkDestroyRenderPass(BP->device, renderPass, nullptr);
+	vkDestroySampler(BP->device, sampler, nullptr);
+	vkDestroyImageView(BP->device, imageView, nullptr);
+	vkDestroyImage(BP->device, image, nullptr);
+	vkFreeMemory(BP->device, imageMemory, nullptr);
+	renderPass = VK_NULL_HANDLE;
+}
+
+
 
 
 
 void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::string& FragShader,
 	std::vector<DescriptorSetLayout*> D, bool wireframePipeline) {
-	init(bp, VertShader, FragShader, D, VK_COMPARE_OP_LESS, wireframePipeline);
+	init(bp, VertShader, FragShader, D, VK_COMPARE_OP_LESS, wireframePipeline, nullptr);
 }
 
 void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::string& FragShader,
-	std::vector<DescriptorSetLayout*> D, VkCompareOp compareOP = VK_COMPARE_OP_LESS, bool wireframePipeline = false) {
+	std::vector<DescriptorSetLayout*> D, VkCompareOp compareOP = VK_COMPARE_OP_LESS, bool wireframePipeline = false,
+	const VkSpecializationInfo *specialization = nullptr) {
+	describe(bp, VertShader, FragShader, D, compareOP, wireframePipeline, specialization);
+	build();
+	BP->pipelineCreationMs += buildMs;
+}
+
+void Pipeline::describe(BaseProject *bp, const std::string& VertShader, const std::string& FragShader,
+	std::vector<DescriptorSetLayout *> D, VkCompareOp compareOP, bool wireframePipeline,
+	const VkSpecializationInfo *specialization) {
 	BP = bp;
+	description.vertShader = VertShader;
+	description.fragShader = FragShader;
+	description.D = D;
+	description.compareOP = compareOP;
+	description.wireframePipeline = wireframePipeline;
+	// copied: the build may happen later, on another thread
+	description.specializationEntries.clear();
+	description.specializationData.clear();
+	if (specialization != nullptr) {
+		description.specializationEntries.assign(specialization->pMapEntries,
+				specialization->pMapEntries + specialization->mapEntryCount);
+		const char *data = static_cast<const char *>(specialization->pData);
+		description.specializationData.assign(data, data + specialization->dataSize);
+	}
+}
+
+void Pipeline::buildAll(BaseProject *bp, const std::vector<Pipeline *> &P) {
+	PROFILE_ZONE("Pipeline::buildAll");
+	auto start = std::chrono::high_resolution_clock::now();
+
+	std::vector<std::future<void>> builds;
+	for (Pipeline *p : P) {
+		builds.push_back(std::async(std::launch::async, [p]() { p->build(); }));
+	}
+	// wait for all of them before rethrowing, so no worker outlives the call
+	for (auto &b : builds) {
+		b.wait();
+	}
+
+	double serialMs = 0.0;
+	for (size_t i = 0; i < builds.size(); i++) {
+		builds[i].get();
+		serialMs += P[i]->buildMs;
+	}
+	double wallMs = std::chrono::duration<double, std::milli>(
+			std::chrono::high_resolution_clock::now() - start).count();
+	bp->pipelineCreationMs += wallMs;
+
+	std::cout << P.size() << " pipelines built in " << wallMs << " ms ("
+			  << serialMs << " ms one after another)\n";
+}
+
+// Lesson 17 to 21, can run on any thread: shader modules, layouts and
+// pipelines can be created concurrently and the pipeline cache is synchronized
+void Pipeline::build() {
+	PROFILE_ZONE("Pipeline::build");
+	auto start = std::chrono::high_resolution_clock::now();
+	const std::vector<DescriptorSetLayout *> &D = description.D;
 	
-	auto vertShaderCode = readFile(VertShader);
-	auto fragShaderCode = readFile(FragShader);
+	auto vertShaderCode = ReadAssetFile(description.vertShader, description.shadersFromFiles);
+	auto fragShaderCode = ReadAssetFile(description.fragShader, description.shadersFromFiles);
+	if (!isSpirv(vertShaderCode) || !isSpirv(fragShaderCode)) {
+		throw std::runtime_error("invalid SPIR-V in " + description.vertShader +
+								 " or " + description.fragShader + "!");
+	}
 	
-	std::cout << "Vertex shader len: " <<
-				vertShaderCode.size() << "\n";
-	std::cout << "Fragment shader len: " <<
-				fragShaderCode.size() << "\n";
+	// a single insertion, so lines from concurrent builds do not interleave
+	std::cout << description.vertShader + " len: " + std::to_string(vertShaderCode.size()) + ", " +
+				 description.fragShader + " len: " + std::to_string(fragShaderCode.size()) + "\n";
 	
 	VkShaderModule vertShaderModule =
 			createShaderModule(vertShaderCode);
@@ -1837,6 +4107,28 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
     fragShaderStageInfo.module = fragShaderModule;
     fragShaderStageInfo.pName = "main";
 
+	VkSpecializationInfo specializationInfo{};
+	if (!description.specializationEntries.empty()) {
+		// every constant must be one the shaders declare, with the same size
+		ShaderReflection R;
+		R.add(vertShaderCode, VK_SHADER_STAGE_VERTEX_BIT);
+		R.add(fragShaderCode, VK_SHADER_STAGE_FRAGMENT_BIT);
+		for (const VkSpecializationMapEntry &e : description.specializationEntries) {
+			auto declared = R.specConstants.find(e.constantID);
+			if (declared == R.specConstants.end() || declared->second != e.size ||
+				e.offset + e.size > description.specializationData.size()) {
+				throw std::runtime_error("specialization constant " + std::to_string(e.constantID) +
+						" does not match the constant_id declarations of " + description.fragShader + "!");
+			}
+		}
+		specializationInfo.mapEntryCount = static_cast<uint32_t>(description.specializationEntries.size());
+		specializationInfo.pMapEntries = description.specializationEntries.data();
+		specializationInfo.dataSize = description.specializationData.size();
+		specializationInfo.pData = description.specializationData.data();
+		vertShaderStageInfo.pSpecializationInfo = &specializationInfo;
+		fragShaderStageInfo.pSpecializationInfo = &specializationInfo;
+	}
+
     VkPipelineShaderStageCreateInfo shaderStages[] =
     		{vertShaderStageInfo, fragShaderStageInfo};
 
@@ -1861,28 +4153,27 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
 	inputAssembly.primitiveRestartEnable = VK_FALSE;
 
 	// Lesson 19
-	VkViewport viewport{};
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.width = (float) BP->swapChainExtent.width;
-	viewport.height = (float) BP->swapChainExtent.height;
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-	
-	VkRect2D scissor{};
-	scissor.offset = {0, 0};
-	scissor.extent = BP->swapChainExtent;
-	
+	// viewport and scissor are dynamic (set in recordCommandBuffer), so the
+	// pipeline does not depend on the window size
 	VkPipelineViewportStateCreateInfo viewportState{};
 	viewportState.sType =
 			VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 	viewportState.viewportCount = 1;
-	viewportState.pViewports = &viewport;
+	viewportState.pViewports = nullptr;
 	viewportState.scissorCount = 1;
-	viewportState.pScissors = &scissor;
+	viewportState.pScissors = nullptr;
+
+	std::array<VkDynamicState, 2> dynamicStates = {
+		VK_DYNAMIC_STATE_VIEWPORT,
+		VK_DYNAMIC_STATE_SCISSOR
+	};
+	VkPipelineDynamicStateCreateInfo dynamicState{};
+	dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+	dynamicState.pDynamicStates = dynamicStates.data();
 	
 	VkPipelineRasterizationStateCreateInfo rasterizer{};
-	if (!wireframePipeline) {
+	if (!description.wireframePipeline) {
 		rasterizer.sType =
 			VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 		rasterizer.depthClampEnable = VK_FALSE;
@@ -1895,14 +4186,22 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
 		rasterizer.depthBiasConstantFactor = 0.0f; // Optional
 		rasterizer.depthBiasClamp = 0.0f; // Optional
 		rasterizer.depthBiasSlopeFactor = 0.0f; // Optional
+		if (description.depthOnly) {
+			// against shadow acne on the lit surfaces
+			rasterizer.depthBiasEnable = VK_TRUE;
+			rasterizer.depthBiasConstantFactor = 1.25f;
+			rasterizer.depthBiasSlopeFactor = 1.75f;
+		}
 	}
 	else {
+		// the edges are drawn by the fragment shader on filled triangles, so
+		// neither fillModeNonSolid nor wideLines is needed; both faces are drawn
 		rasterizer.sType =
 			VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 		rasterizer.depthClampEnable = VK_FALSE;
 		rasterizer.rasterizerDiscardEnable = VK_FALSE;
-		rasterizer.polygonMode = VK_POLYGON_MODE_LINE;
-		rasterizer.lineWidth = 2.0f;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.0f;
 		rasterizer.cullMode = VK_CULL_MODE_NONE;
 		rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 		rasterizer.depthBiasEnable = VK_FALSE;
@@ -1927,7 +4226,7 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
 			VK_COLOR_COMPONENT_G_BIT |
 			VK_COLOR_COMPONENT_B_BIT |
 			VK_COLOR_COMPONENT_A_BIT;
-	colorBlendAttachment.blendEnable = VK_TRUE;
+	colorBlendAttachment.blendEnable = description.blendEnable ? VK_TRUE : VK_FALSE;
 	colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
 	colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
 	colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
@@ -1940,7 +4239,7 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
 			VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 	colorBlending.logicOpEnable = VK_FALSE;
 	colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
-	colorBlending.attachmentCount = 1;
+	colorBlending.attachmentCount = description.depthOnly ? 0 : 1;
 	colorBlending.pAttachments = &colorBlendAttachment;
 	colorBlending.blendConstants[0] = 0.0f; // Optional
 	colorBlending.blendConstants[1] = 0.0f; // Optional
@@ -1973,8 +4272,8 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
 	depthStencil.sType = 
 			VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 	depthStencil.depthTestEnable = VK_TRUE;
-	depthStencil.depthWriteEnable = VK_TRUE;
-	depthStencil.depthCompareOp = compareOP; //default VK_COMPARE_OP_LESS
+	depthStencil.depthWriteEnable = description.depthWrite ? VK_TRUE : VK_FALSE;
+	depthStencil.depthCompareOp = description.compareOP; //default VK_COMPARE_OP_LESS
 	depthStencil.depthBoundsTestEnable = VK_FALSE;
 	depthStencil.minDepthBounds = 0.0f; // Optional
 	depthStencil.maxDepthBounds = 1.0f; // Optional
@@ -1994,15 +4293,19 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
 	pipelineInfo.pMultisampleState = &multisampling;
 	pipelineInfo.pDepthStencilState = &depthStencil;
 	pipelineInfo.pColorBlendState = &colorBlending;
-	pipelineInfo.pDynamicState = nullptr; // Optional
+	pipelineInfo.pDynamicState = &dynamicState;
 	pipelineInfo.layout = pipelineLayout;
-	pipelineInfo.renderPass = BP->renderPass;
+	pipelineInfo.renderPass = description.renderPass != VK_NULL_HANDLE ?
+			description.renderPass : BP->renderPass;
 	pipelineInfo.subpass = 0;
 	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional
 	pipelineInfo.basePipelineIndex = -1; // Optional
 	
-	result = vkCreateGraphicsPipelines(BP->device, VK_NULL_HANDLE, 1,
-			&pipelineInfo, nullptr, &graphicsPipeline);
+	{
+		PROFILE_ZONE("vkCreateGraphicsPipelines");
+		result = vkCreateGraphicsPipelines(BP->device, BP->pipelineCache, 1,
+				&pipelineInfo, nullptr, &graphicsPipeline);
+	}
 	if (result != VK_SUCCESS) {
 	 	PrintVkError(result);
 		throw std::runtime_error("failed to create graphics pipeline!");
@@ -2010,24 +4313,24 @@ void Pipeline::init(BaseProject* bp, const std::string& VertShader, const std::s
 	
 	vkDestroyShaderModule(BP->device, fragShaderModule, nullptr);
 	vkDestroyShaderModule(BP->device, vertShaderModule, nullptr);
+
+	buildMs = std::chrono::duration<double, std::milli>(
+			std::chrono::high_resolution_clock::now() - start).count();
 }
 
 // Lesson 18
 std::vector<char> Pipeline::readFile(const std::string& filename) {
-		std::ifstream file(filename, std::ios::ate | std::ios::binary);
-	if (!file.is_open()) {
-		throw std::runtime_error("failed to open file!");
+	return ReadAssetFile(filename);
+}
+
+bool Pipeline::isSpirv(const std::vector<char>& code) {
+	const uint32_t SPIRV_MAGIC = 0x07230203;
+	uint32_t magic = 0;
+	if (code.size() < sizeof(magic) || code.size() % 4 != 0) {
+		return false;
 	}
-	
-	size_t fileSize = (size_t) file.tellg();
-	std::vector<char> buffer(fileSize);
-	 
-	file.seekg(0);
-	file.read(buffer.data(), fileSize);
-	 
-	file.close();
-	 
-	return buffer;
+	memcpy(&magic, code.data(), sizeof(magic));
+	return magic == SPIRV_MAGIC;
 }
 
 // Lesson 18
@@ -2054,17 +4357,66 @@ void Pipeline::cleanup() {
 		vkDestroyPipelineLayout(BP->device, pipelineLayout, nullptr);
 }
 
+void PipelineVariants::init(BaseProject *bp, const PipelineDescription &description) {
+	BP = bp;
+	base = description;
+}
+
+Pipeline *PipelineVariants::describe(const std::vector<uint32_t> &constants) {
+	std::unique_ptr<Pipeline> &variant = variants[constants];
+	if (!variant) {
+		variant.reset(new Pipeline());
+		variant->BP = BP;
+		variant->description = base;
+		variant->description.specializationEntries.clear();
+		for (uint32_t i = 0; i < constants.size(); i++) {
+			variant->description.specializationEntries.push_back({ i, i * 4, 4 });
+		}
+		const char *data = reinterpret_cast<const char *>(constants.data());
+		variant->description.specializationData.assign(data, data + constants.size() * 4);
+	}
+	return variant.get();
+}
+
+Pipeline &PipelineVariants::get(const std::vector<uint32_t> &constants) {
+	Pipeline *variant = describe(constants);
+	if (variant->graphicsPipeline == VK_NULL_HANDLE) {
+		variant->build();
+		BP->pipelineCreationMs += variant->buildMs;
+	}
+	return *variant;
+}
+
+std::vector<Pipeline *> PipelineVariants::all() {
+	std::vector<Pipeline *> P;
+	for (auto &v : variants) {
+		P.push_back(v.second.get());
+	}
+	return P;
+}
+
+void PipelineVariants::cleanup() {
+	for (auto &v : variants) {
+		if (v.second->graphicsPipeline != VK_NULL_HANDLE) {
+			v.second->cleanup();
+		}
+	}
+	variants.clear();
+}
+
 void DescriptorSetLayout::init(BaseProject *bp, std::vector<DescriptorSetLayoutBinding> B) {
 	BP = bp;
 	
 	std::vector<VkDescriptorSetLayoutBinding> bindings;
 	bindings.resize(B.size());
+	descriptorCounts.clear();
 	for(int i = 0; i < B.size(); i++) {
 		bindings[i].binding = B[i].binding;
 		bindings[i].descriptorType = B[i].type;
-		bindings[i].descriptorCount = 1;
+		bindings[i].descriptorCount = B[i].count;
 		bindings[i].stageFlags = B[i].flags;
 		bindings[i].pImmutableSamplers = nullptr;
+		descriptorCounts[B[i].type] += B[i].count;
 	}
 	
 	VkDescriptorSetLayoutCreateInfo layoutInfo{};
@@ -2080,6 +4432,19 @@ void DescriptorSetLayout::init(BaseProject *bp, std::vector<DescriptorSetLayoutB
 	}
 }
 
+void DescriptorSetLayout::init(BaseProject *bp, const ShaderReflection &R, uint32_t set) {
+	for (const ReflectedBinding &b : R.bindings) {
+		if (b.set == set && b.blockSize > 0) {
+			blockSizes[b.binding] = b.blockSize;
+		}
+	}
+	std::vector<DescriptorSetLayoutBinding> B = R.layoutBindings(set);
+	if (B.empty()) {
+		throw std::runtime_error("no descriptors in set " + std::to_string(set) + " of the shaders!");
+	}
+	init(bp, B);
+}
+
 void DescriptorSetLayout::cleanup() {
     	vkDestroyDescriptorSetLayout(BP->device, descriptorSetLayout, nullptr);	
 }
@@ -2087,6 +4452,8 @@ void DescriptorSetLayout::cleanup() {
 void DescriptorSet::init(BaseProject *bp, DescriptorSetLayout *DSL,
 						 std::vector<DescriptorSetElement> E) {
 	BP = bp;
+	layout = DSL;
+	elements = E;
 	
 	// Create uniform buffer
 	uniformBuffers.resize(E.size());
@@ -2096,10 +4463,18 @@ void DescriptorSet::init(BaseProject *bp, DescriptorSetLayout *DSL,
 	for (int j = 0; j < E.size(); j++) {
 		uniformBuffers[j].resize(BP->swapChainImages.size());
 		uniformBuffersMemory[j].resize(BP->swapChainImages.size());
-		if(E[j].type == UNIFORM) {
+		auto reflected = DSL->blockSizes.find(E[j].binding);
+		if (E[j].type == UNIFORM && reflected != DSL->blockSizes.end() &&
+			static_cast<uint32_t>(E[j].size) < reflected->second) {
+			throw std::runtime_error("uniform buffer for binding " + std::to_string(E[j].binding) +
+					" is " + std::to_string(E[j].size) + " bytes, the shaders use " +
+					std::to_string(reflected->second) + "!");
+		}
+		if(E[j].type == UNIFORM || E[j].type == STORAGE) {
 			for (size_t i = 0; i < BP->swapChainImages.size(); i++) {
 				VkDeviceSize bufferSize = E[j].size;
-				BP->createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+				BP->createBuffer(bufferSize, E[j].type == UNIFORM ?
+										 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT : VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 									 	 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
 									 	 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 									 	 uniformBuffers[j][i], uniformBuffersMemory[j][i]);
@@ -2111,28 +4486,17 @@ void DescriptorSet::init(BaseProject *bp, DescriptorSetLayout *DSL,
 	}
 	
 	// Create Descriptor set
-	std::vector<VkDescriptorSetLayout> layouts(BP->swapChainImages.size(),
-											   DSL->descriptorSetLayout);
-	VkDescriptorSetAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	allocInfo.descriptorPool = BP->descriptorPool;
-	allocInfo.descriptorSetCount = static_cast<uint32_t>(BP->swapChainImages.size());
-	allocInfo.pSetLayouts = layouts.data();
-	
-	descriptorSets.resize(BP->swapChainImages.size());
-	
-	VkResult result = vkAllocateDescriptorSets(BP->device, &allocInfo,
-										descriptorSets.data());
-	if (result != VK_SUCCESS) {
-		PrintVkError(result);
-		throw std::runtime_error("failed to allocate descriptor sets!");
-	}
+	BP->descriptorAllocator.allocate(*DSL, static_cast<uint32_t>(BP->swapChainImages.size()), descriptorSets);
 	
 	for (size_t i = 0; i < BP->swapChainImages.size(); i++) {
 		std::vector<VkWriteDescriptorSet> descriptorWrites(E.size());
+		// the infos must outlive the loop, vkUpdateDescriptorSets reads them
+		std::vector<VkDescriptorBufferInfo> bufferInfos(E.size());
+		std::vector<VkDescriptorImageInfo> imageInfos(E.size());
+		std::vector<std::vector<VkDescriptorImageInfo>> arrayInfos(E.size());
 		for (int j = 0; j < E.size(); j++) {
-			if(E[j].type == UNIFORM) {
-				VkDescriptorBufferInfo bufferInfo{};
+			if(E[j].type == UNIFORM || E[j].type == STORAGE) {
+				VkDescriptorBufferInfo &bufferInfo = bufferInfos[j];
 				bufferInfo.buffer = uniformBuffers[j][i];
 				bufferInfo.offset = 0;
 				bufferInfo.range = E[j].size;
@@ -2141,14 +4505,17 @@ void DescriptorSet::init(BaseProject *bp, DescriptorSetLayout *DSL,
 				descriptorWrites[j].dstSet = descriptorSets[i];
 				descriptorWrites[j].dstBinding = E[j].binding;
 				descriptorWrites[j].dstArrayElement = 0;
-				descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+				descriptorWrites[j].descriptorType = E[j].type == UNIFORM ?
+						VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 				descriptorWrites[j].descriptorCount = 1;
 				descriptorWrites[j].pBufferInfo = &bufferInfo;
 			} else if(E[j].type == TEXTURE) {
-				VkDescriptorImageInfo imageInfo{};
+				VkDescriptorImageInfo &imageInfo = imageInfos[j];
 				imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 				imageInfo.imageView = E[j].tex->textureImageView;
 				imageInfo.sampler = E[j].tex->textureSampler;
+				E[j].tex->bindings.push_back({ descriptorSets[i], static_cast<uint32_t>(E[j].binding), 0,
+											   static_cast<uint32_t>(i) });
 		
 				descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				descriptorWrites[j].dstSet = descriptorSets[i];
@@ -2159,11 +4526,48 @@ void DescriptorSet::init(BaseProject *bp, DescriptorSetLayout *DSL,
 				descriptorWrites[j].descriptorCount = 1;
 				descriptorWrites[j].pImageInfo = &imageInfo;
 			}
+			else if (E[j].type == SHADOW_MAP) {
+				VkDescriptorImageInfo &imageInfo = imageInfos[j];
+				imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				imageInfo.imageView = E[j].shadow->imageView;
+				imageInfo.sampler = E[j].shadow->sampler;
+
+				descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				descriptorWrites[j].dstSet = descriptorSets[i];
+				descriptorWrites[j].dstBinding = E[j].binding;
+				descriptorWrites[j].dstArrayElement = 0;
+				descriptorWrites[j].descriptorType =
+											VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				descriptorWrites[j].descriptorCount = 1;
+				descriptorWrites[j].pImageInfo = &imageInfo;
+			}
+			else if (E[j].type == TEXTURE_ARRAY) {
+				arrayInfos[j].resize(MAX_TEXTURES);
+				for (uint32_t k = 0; k < MAX_TEXTURES; k++) {
+					Texture *tex = E[j].textures[k < E[j].textures.size() ? k : 0];
+					arrayInfos[j][k].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					arrayInfos[j][k].imageView = tex->textureImageView;
+					arrayInfos[j][k].sampler = tex->textureSampler;
+					tex->bindings.push_back({ descriptorSets[i], static_cast<uint32_t>(E[j].binding), k,
+											  static_cast<uint32_t>(i) });
+				}
+
+				descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				descriptorWrites[j].dstSet = descriptorSets[i];
+				descriptorWrites[j].dstBinding = E[j].binding;
+				descriptorWrites[j].dstArrayElement = 0;
+				descriptorWrites[j].descriptorType =
+											VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				descriptorWrites[j].descriptorCount = MAX_TEXTURES;
+				descriptorWrites[j].pImageInfo = arrayInfos[j].data();
+			}
 			else if (E[j].type == CUBIC_TEXTURE) {
-				VkDescriptorImageInfo imageInfo{};
+				VkDescriptorImageInfo &imageInfo = imageInfos[j];
 				imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 				imageInfo.imageView = E[j].ctex->textureImageView;
 				imageInfo.sampler = E[j].ctex->textureSampler;
+				E[j].ctex->bindings.push_back({ descriptorSets[i], static_cast<uint32_t>(E[j].binding), 0,
+												static_cast<uint32_t>(i) });
 
 				descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				descriptorWrites[j].dstSet = descriptorSets[i];
@@ -2182,13 +4586,1211 @@ void DescriptorSet::init(BaseProject *bp, DescriptorSetLayout *DSL,
 
 }
 
+void DescriptorSet::recreate() {
+	// the texture streamer must not write the old sets any more
+	auto forget = [this](std::vector<TextureBinding> &bindings) {
+		bindings.erase(std::remove_if(bindings.begin(), bindings.end(), [this](const TextureBinding &b) {
+			return std::find(descriptorSets.begin(), descriptorSets.end(), b.set) != descriptorSets.end();
+		}), bindings.end());
+	};
+	for (DescriptorSetElement &e : elements) {
+		if (e.type == TEXTURE) forget(e.tex->bindings);
+		if (e.type == CUBIC_TEXTURE) forget(e.ctex->bindings);
+		if (e.type == TEXTURE_ARRAY) {
+			for (Texture *tex : e.textures) forget(tex->bindings);
+		}
+	}
+
+	cleanup();
+	init(BP, layout, elements);
+}
+
 void DescriptorSet::cleanup() {
 	for(int j = 0; j < uniformBuffers.size(); j++) {
 		if(toFree[j]) {
-			for (size_t i = 0; i < BP->swapChainImages.size(); i++) {
+			for (size_t i = 0; i < uniformBuffers[j].size(); i++) {
 				vkDestroyBuffer(BP->device, uniformBuffers[j][i], nullptr);
 				vkFreeMemory(BP->device, uniformBuffersMemory[j][i], nullptr);
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+
+void DescriptorAllocator::init(BaseProject *bp) {
+	BP = bp;
+}
+
+VkDescriptorPool DescriptorAllocator::createPool(Bucket &bucket, const std::map<VkDescriptorType, uint32_t> &counts,
+												 uint32_t maxSets) {
+	std::vector<VkDescriptorPoolSize> poolSizes;
+	for (const auto &c : counts) {
+		poolSizes.push_back({ c.first, c.second * maxSets });
+	}
+
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	poolInfo.pPoolSizes = poolSizes.data();
+	poolInfo.maxSets = maxSets;
+
+	VkDescriptorPool pool;
+	VkResult result = vkCreateDescriptorPool(BP->device, &poolInfo, nullptr, &pool);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create descriptor pool!");
+	}
+	bucket.nextPoolSets = std::min(maxSets * 2, DESCRIPTOR_POOL_MAX_SETS);
+	return pool;
+}
+
+void DescriptorAllocator::allocate(const DescriptorSetLayout &layout, uint32_t count,
+								   std::vector<VkDescriptorSet> &sets) {
+	std::vector<VkDescriptorSetLayout> layouts(count, layout.descriptorSetLayout);
+	sets.resize(count);
+	Bucket &bucket = buckets[layout.descriptorCounts];
+
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorSetCount = count;
+	allocInfo.pSetLayouts = layouts.data();
+
+	VkResult result = VK_ERROR_OUT_OF_POOL_MEMORY;
+	if (!bucket.pools.empty()) {
+		allocInfo.descriptorPool = bucket.pools.back();
+		result = vkAllocateDescriptorSets(BP->device, &allocInfo, sets.data());
+	}
+	if (result != VK_SUCCESS) {
+		// no pool yet, or the current one is full (VK_ERROR_OUT_OF_POOL_MEMORY
+		// or, before maintenance1, VK_ERROR_FRAGMENTED_POOL or another error):
+		// start a new one
+		uint32_t maxSets = std::max(bucket.nextPoolSets, count);
+		bucket.pools.push_back(createPool(bucket, layout.descriptorCounts, maxSets));
+		allocInfo.descriptorPool = bucket.pools.back();
+		result = vkAllocateDescriptorSets(BP->device, &allocInfo, sets.data());
+	}
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to allocate descriptor sets!");
+	}
+	allocatedSets += count;
+}
+
+void DescriptorAllocator::cleanup() {
+	for (auto &b : buckets) {
+		for (VkDescriptorPool pool : b.second.pools) {
+			vkDestroyDescriptorPool(BP->device, pool, nullptr);
+		}
+	}
+	buckets.clear();
+	allocatedSets = 0;
+}
+
+
+// SPIR-V opcodes, decorations and storage classes used by the reflection
+namespace spirv {
+	const uint32_t MAGIC = 0x07230203;
+	enum Op {
+		OpTypeBool = 20, OpTypeInt = 21, OpTypeFloat = 22, OpTypeVector = 23, OpTypeMatrix = 24,
+		OpTypeImage = 25, OpTypeSampler = 26, OpTypeSampledImage = 27, OpTypeArray = 28,
+		OpTypeRuntimeArray = 29, OpTypeStruct = 30, OpTypePointer = 32, OpConstant = 43,
+		OpSpecConstantTrue = 48, OpSpecConstantFalse = 49, OpSpecConstant = 50, OpVariable = 59, OpDecorate = 71, OpMemberDecorate = 72
+	};
+	enum Decoration {
+		SpecId = 1, Block = 2, BufferBlock = 3, ArrayStride = 6, MatrixStride = 7,
+		Binding = 33, DescriptorSet = 34, Offset = 35
+	};
+	enum StorageClass { UniformConstant = 0, Uniform = 2, StorageBuffer = 12 };
+	enum Dim { DimBuffer = 5, DimSubpassData = 6 };
+}
+
+void ShaderReflection::add(const std::vector<char>& code, VkShaderStageFlagBits stage) {
+	std::vector<uint32_t> words(code.size() / 4);
+	memcpy(words.data(), code.data(), words.size() * 4);
+	if (words.size() < 5 || words[0] != spirv::MAGIC) {
+		throw std::runtime_error("invalid SPIR-V module!");
+	}
+
+	// everything is keyed by result id
+	std::map<uint32_t, std::vector<uint32_t>> types;	// id -> the whole instruction
+	std::map<uint32_t, uint32_t> constants;
+	std::map<uint32_t, uint32_t> bindingOf, setOf, arrayStride;
+	std::set<uint32_t> blocks, bufferBlocks;
+	std::map<std::pair<uint32_t, uint32_t>, uint32_t> memberOffset, memberMatrixStride;
+	std::vector<std::pair<uint32_t, uint32_t>> variables;	// (pointer type, id)
+	std::map<uint32_t, uint32_t> specIdOf;
+	std::vector<std::pair<uint32_t, uint32_t>> specResults;	// (type, id)
+
+	for (size_t i = 5; i < words.size();) {
+		uint32_t op = words[i] & 0xFFFF;
+		uint32_t count = words[i] >> 16;
+		if (count == 0 || i + count > words.size()) {
+			throw std::runtime_error("malformed SPIR-V module!");
+		}
+		const uint32_t *w = &words[i];
+
+		switch (op) {
+		case spirv::OpTypeBool: case spirv::OpTypeInt: case spirv::OpTypeFloat: case spirv::OpTypeVector:
+		case spirv::OpTypeMatrix: case spirv::OpTypeImage: case spirv::OpTypeSampler:
+		case spirv::OpTypeSampledImage: case spirv::OpTypeArray: case spirv::OpTypeRuntimeArray:
+		case spirv::OpTypeStruct: case spirv::OpTypePointer:
+			types[w[1]] = std::vector<uint32_t>(w, w + count);
+			break;
+		case spirv::OpConstant:
+			constants[w[2]] = w[3];
+			break;
+		case spirv::OpSpecConstantTrue: case spirv::OpSpecConstantFalse: case spirv::OpSpecConstant:
+			specResults.push_back({ w[1], w[2] });
+			break;
+		case spirv::OpVariable:
+			if (w[3] == spirv::UniformConstant || w[3] == spirv::Uniform ||
+				w[3] == spirv::StorageBuffer) {
+				variables.push_back({ w[1], w[2] });
+			}
+			break;
+		case spirv::OpDecorate:
+			if (w[2] == spirv::SpecId) specIdOf[w[1]] = w[3];
+			if (w[2] == spirv::Binding) bindingOf[w[1]] = w[3];
+			if (w[2] == spirv::DescriptorSet) setOf[w[1]] = w[3];
+			if (w[2] == spirv::ArrayStride) arrayStride[w[1]] = w[3];
+			if (w[2] == spirv::Block) blocks.insert(w[1]);
+			if (w[2] == spirv::BufferBlock) bufferBlocks.insert(w[1]);
+			break;
+		case spirv::OpMemberDecorate:
+			if (w[3] == spirv::Offset) memberOffset[{ w[1], w[2] }] = w[4];
+			if (w[3] == spirv::MatrixStride) memberMatrixStride[{ w[1], w[2] }] = w[4];
+			break;
+		}
+		i += count;
+	}
+
+	auto type = [&](uint32_t id) -> const std::vector<uint32_t>& {
+		auto it = types.find(id);
+		if (it == types.end()) {
+			throw std::runtime_error("unknown type in SPIR-V module!");
+		}
+		return it->second;
+	};
+
+	// size of a type inside an explicitly laid out block, matrixStride comes
+	// from the member that holds the matrix
+	std::function<uint32_t(uint32_t, uint32_t)> sizeOf = [&](uint32_t id, uint32_t matrixStride) -> uint32_t {
+		const std::vector<uint32_t> &t = type(id);
+		switch (t[0] & 0xFFFF) {
+		case spirv::OpTypeInt:
+		case spirv::OpTypeFloat:
+			return t[2] / 8;
+		case spirv::OpTypeVector:
+			return t[3] * sizeOf(t[2], 0);
+		case spirv::OpTypeMatrix:
+			return t[3] * (matrixStride ? matrixStride : sizeOf(t[2], 0));
+		case spirv::OpTypeArray: {
+			uint32_t stride = arrayStride.count(id) ? arrayStride[id] : sizeOf(t[2], matrixStride);
+			return constants[t[3]] * stride;
+		}
+		case spirv::OpTypeStruct: {
+			uint32_t size = 0;
+			for (uint32_t m = 0; m + 2 < t.size(); m++) {
+				uint32_t offset = memberOffset.count({ id, m }) ? memberOffset[{ id, m }] : size;
+				uint32_t stride = memberMatrixStride.count({ id, m }) ? memberMatrixStride[{ id, m }] : 0;
+				size = std::max(size, offset + sizeOf(t[m + 2], stride));
+			}
+			return size;
+		}
+		default:
+			return 0;	// runtime arrays do not add to the fixed size
+		}
+	};
+
+	// booleans are passed as VkBool32
+	for (const auto &c : specResults) {
+		if (!specIdOf.count(c.second)) continue;
+		const std::vector<uint32_t> &t = type(c.first);
+		specConstants[specIdOf[c.second]] = (t[0] & 0xFFFF) == spirv::OpTypeBool ? 4 : t[2] / 8;
+	}
+
+	for (const auto &v : variables) {
+		if (!bindingOf.count(v.second)) continue;
+
+		const std::vector<uint32_t> &pointer = type(v.first);
+		uint32_t storage = pointer[2];
+		uint32_t id = pointer[3];
+
+		ReflectedBinding b{};
+		b.set = setOf.count(v.second) ? setOf[v.second] : 0;
+		b.binding = bindingOf[v.second];
+		b.stages = stage;
+		b.count = 1;
+
+		const std::vector<uint32_t> *t = &type(id);
+		if ((t->at(0) & 0xFFFF) == spirv::OpTypeArray) {
+			b.count = constants[t->at(3)];
+			id = t->at(2);
+			t = &type(id);
+		} else if ((t->at(0) & 0xFFFF) == spirv::OpTypeRuntimeArray) {
+			b.count = 0;
+			id = t->at(2);
+			t = &type(id);
+		}
+
+		switch (t->at(0) & 0xFFFF) {
+		case spirv::OpTypeStruct:
+			b.type = (storage == spirv::StorageBuffer || bufferBlocks.count(id)) ?
+					 VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			b.blockSize = sizeOf(id, 0);
+			break;
+		case spirv::OpTypeSampledImage:
+			b.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			break;
+		case spirv::OpTypeSampler:
+			b.type = VK_DESCRIPTOR_TYPE_SAMPLER;
+			break;
+		case spirv::OpTypeImage:
+			if (t->at(3) == spirv::DimSubpassData) {
+				b.type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+			} else if (t->at(3) == spirv::DimBuffer) {
+				b.type = t->at(7) == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER :
+										 VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+			} else {
+				b.type = t->at(7) == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE :
+										 VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+			}
+			break;
+		default:
+			continue;
+		}
+
+		// the same binding seen by another stage: merge
+		auto same = std::find_if(bindings.begin(), bindings.end(), [&](const ReflectedBinding &o) {
+			return o.set == b.set && o.binding == b.binding;
+		});
+		if (same == bindings.end()) {
+			bindings.push_back(b);
+		} else {
+			if (same->type != b.type) {
+				throw std::runtime_error("set " + std::to_string(b.set) + " binding " +
+						std::to_string(b.binding) + " has different types in different stages!");
+			}
+			same->stages |= b.stages;
+			same->blockSize = std::max(same->blockSize, b.blockSize);
+		}
+	}
+}
+
+ShaderReflection ShaderReflection::fromFiles(const std::string& VertShader, const std::string& FragShader) {
+	ShaderReflection R;
+	R.add(Pipeline::readFile(VertShader), VK_SHADER_STAGE_VERTEX_BIT);
+	R.add(Pipeline::readFile(FragShader), VK_SHADER_STAGE_FRAGMENT_BIT);
+	return R;
+}
+
+std::vector<DescriptorSetLayoutBinding> ShaderReflection::layoutBindings(uint32_t set) const {
+	std::vector<DescriptorSetLayoutBinding> B;
+	for (const ReflectedBinding &b : bindings) {
+		if (b.set == set) {
+			B.push_back({ b.binding, b.type, b.stages, b.count });
+		}
+	}
+	std::sort(B.begin(), B.end(), [](const DescriptorSetLayoutBinding &a, const DescriptorSetLayoutBinding &b) {
+		return a.binding < b.binding;
+	});
+	return B;
+}
+
+
+void GpuScopeStats::addSample(double ms) {
+	if (history.empty()) {
+		history.resize(GPU_PROFILER_HISTORY_SIZE, 0.0);
+	}
+	history[historyHead] = ms;
+	historyHead = (historyHead + 1) % GPU_PROFILER_HISTORY_SIZE;
+
+	min = samples == 0 ? ms : std::min(min, ms);
+	max = samples == 0 ? ms : std::max(max, ms);
+	last = ms;
+	samples++;
+}
+
+double GpuScopeStats::average() const {
+	size_t n = std::min<uint64_t>(samples, GPU_PROFILER_HISTORY_SIZE);
+	if (n == 0) return 0.0;
+
+	double sum = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		sum += history[i];
+	}
+	return sum / n;
+}
+
+void GpuProfiler::init(BaseProject *bp, uint32_t frames) {
+	BP = bp;
+	framesCount = frames;
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(BP->physicalDevice, &properties);
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(BP->physicalDevice, &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(BP->physicalDevice, &queueFamilyCount,
+						queueFamilies.data());
+	uint32_t validBits = queueFamilies[
+				BP->findQueueFamilies(BP->physicalDevice).graphicsFamily.value()].timestampValidBits;
+
+	if (validBits == 0 || properties.limits.timestampPeriod == 0.0f) {
+		std::cout << "GPU profiler disabled: timestamps not supported on the graphics queue\n";
+		enabled = false;
+		return;
+	}
+	timestampPeriod = properties.limits.timestampPeriod;
+	timestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+
+	VkQueryPoolCreateInfo queryPoolInfo{};
+	queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	queryPoolInfo.queryCount = framesCount * GPU_PROFILER_MAX_SCOPES_PER_FRAME * 2;
+
+	VkResult result = vkCreateQueryPool(BP->device, &queryPoolInfo, nullptr, &queryPool);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create timestamp query pool!");
+	}
+
+	if (BP->pipelineStatisticsEnabled) {
+		VkQueryPoolCreateInfo statisticsPoolInfo{};
+		statisticsPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		statisticsPoolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+		statisticsPoolInfo.queryCount = framesCount;
+		statisticsPoolInfo.pipelineStatistics =
+				VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+		result = vkCreateQueryPool(BP->device, &statisticsPoolInfo, nullptr, &statisticsPool);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to create pipeline statistics query pool!");
+		}
+	}
+	fragmentInvocations.name = "fragment shader invocations";
+	overdraw.name = "overdraw";
+
+	recordedScopes.resize(framesCount);
+	openScopes.resize(framesCount);
+	usedQueries.resize(framesCount, 0);
+	pending.resize(framesCount, false);
+	submittedFrame.resize(framesCount, 0);
+	enabled = true;
+}
+
+void GpuProfiler::resetFrame(VkCommandBuffer commandBuffer, int currentImage) {
+	if (!enabled) return;
+
+	recordedScopes[currentImage].clear();
+	openScopes[currentImage].clear();
+	usedQueries[currentImage] = 0;
+	vkCmdResetQueryPool(commandBuffer, queryPool,
+			currentImage * GPU_PROFILER_MAX_SCOPES_PER_FRAME * 2,
+			GPU_PROFILER_MAX_SCOPES_PER_FRAME * 2);
+	if (statisticsPool != VK_NULL_HANDLE) {
+		vkCmdResetQueryPool(commandBuffer, statisticsPool, currentImage, 1);
+	}
+}
+
+void GpuProfiler::beginFrameStatistics(VkCommandBuffer commandBuffer, int currentImage) {
+	if (!enabled || statisticsPool == VK_NULL_HANDLE) return;
+	vkCmdBeginQuery(commandBuffer, statisticsPool, currentImage, 0);
+}
+
+void GpuProfiler::endFrameStatistics(VkCommandBuffer commandBuffer, int currentImage) {
+	if (!enabled || statisticsPool == VK_NULL_HANDLE) return;
+	vkCmdEndQuery(commandBuffer, statisticsPool, currentImage);
+}
+
+void GpuProfiler::beginScope(VkCommandBuffer commandBuffer, int currentImage, const std::string &name) {
+	if (!enabled) return;
+
+	if (usedQueries[currentImage] + 2 > GPU_PROFILER_MAX_SCOPES_PER_FRAME * 2) {
+		throw std::runtime_error("too many GPU profiler scopes in a frame!");
+	}
+
+	auto it = statsIndex.find(name);
+	int statsId;
+	if (it == statsIndex.end()) {
+		statsId = static_cast<int>(stats.size());
+		stats.push_back({});
+		stats.back().name = name;
+		statsIndex[name] = statsId;
+	} else {
+		statsId = it->second;
+	}
+
+	uint32_t base = currentImage * GPU_PROFILER_MAX_SCOPES_PER_FRAME * 2;
+	RecordedScope scope;
+	scope.stats = statsId;
+	scope.beginQuery = base + usedQueries[currentImage]++;
+	scope.endQuery = base + usedQueries[currentImage]++;
+
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			queryPool, scope.beginQuery);
+
+	openScopes[currentImage].push_back(static_cast<int>(recordedScopes[currentImage].size()));
+	recordedScopes[currentImage].push_back(scope);
+}
+
+void GpuProfiler::endScope(VkCommandBuffer commandBuffer, int currentImage) {
+	if (!enabled) return;
+
+	if (openScopes[currentImage].empty()) {
+		throw std::runtime_error("GPU profiler scope closed without being opened!");
+	}
+	RecordedScope &scope = recordedScopes[currentImage][openScopes[currentImage].back()];
+	openScopes[currentImage].pop_back();
+
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			queryPool, scope.endQuery);
+}
+
+void GpuProfiler::markSubmitted(int currentImage, uint64_t frame) {
+	if (!enabled) return;
+
+	pending[currentImage] = true;
+	submittedFrame[currentImage] = frame;
+}
+
+void GpuProfiler::collect(int currentImage) {
+	if (!enabled || !pending[currentImage]) return;
+	pending[currentImage] = false;
+
+	if (statisticsPool != VK_NULL_HANDLE) {
+		uint64_t invocations[2];	// value, availability
+		VkResult result = vkGetQueryPoolResults(BP->device, statisticsPool, currentImage, 1,
+				sizeof(invocations), invocations, sizeof(invocations),
+				VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+		if ((result == VK_SUCCESS || result == VK_NOT_READY) && invocations[1] != 0) {
+			double pixels = (double) BP->swapChainExtent.width * BP->swapChainExtent.height;
+			fragmentInvocations.addSample((double) invocations[0]);
+			overdraw.addSample(invocations[0] / pixels);
+			if (keepTimeline) {
+				fragmentInvocations.timeline.push_back({ submittedFrame[currentImage], (double) invocations[0] });
+				overdraw.timeline.push_back({ submittedFrame[currentImage], invocations[0] / pixels });
+			}
+		}
+	}
+	if (usedQueries[currentImage] == 0) return;
+
+	// pairs of (value, availability): no VK_QUERY_RESULT_WAIT_BIT, so a
+	// query that is not ready yet is simply skipped for this frame
+	uint32_t count = usedQueries[currentImage];
+	uint32_t base = currentImage * GPU_PROFILER_MAX_SCOPES_PER_FRAME * 2;
+	std::vector<uint64_t> results(count * 2);
+
+	VkResult result = vkGetQueryPoolResults(BP->device, queryPool, base, count,
+			results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+	if (result != VK_SUCCESS && result != VK_NOT_READY) {
+		PrintVkError(result);
+		return;
+	}
+
+	for (const RecordedScope &scope : recordedScopes[currentImage]) {
+		uint32_t b = scope.beginQuery - base;
+		uint32_t e = scope.endQuery - base;
+		if (results[b * 2 + 1] == 0 || results[e * 2 + 1] == 0) continue;
+
+		uint64_t ticks = (results[e * 2] - results[b * 2]) & timestampMask;
+		double ms = ticks * timestampPeriod / 1000000.0;
+		stats[scope.stats].addSample(ms);
+		if (keepTimeline) {
+			stats[scope.stats].timeline.push_back({ submittedFrame[currentImage], ms });
+		}
+	}
+}
+
+// to be called once the device is idle, for the frames never waited for
+void GpuProfiler::collectAll() {
+	for (uint32_t i = 0; i < framesCount && enabled; i++) {
+		collect(i);
+	}
+}
+
+double GpuProfiler::averageMs(const std::string &name) {
+	auto it = statsIndex.find(name);
+	return it == statsIndex.end() ? 0.0 : stats[it->second].average();
+}
+
+void GpuProfiler::printSummary() {
+	if (!enabled) {
+		std::cout << "GPU profiler not available\n";
+		return;
+	}
+	std::cout << "GPU timings (average of the last " << GPU_PROFILER_HISTORY_SIZE << " frames):\n";
+	for (const GpuScopeStats &s : stats) {
+		std::cout << "  " << s.name << ": " << s.average() << " ms (min " << s.min
+				  << ", max " << s.max << ", samples " << s.samples << ")\n";
+	}
+	if (fragmentInvocations.samples > 0) {
+		std::cout << "  " << fragmentInvocations.name << ": " << fragmentInvocations.average()
+				  << " per frame, overdraw " << overdraw.average() << "x the pixels\n";
+	}
+}
+
+void GpuProfiler::writeCSV(const std::string &file) {
+	std::ofstream out(file);
+	if (!out.is_open()) {
+		std::cout << "failed to open " << file << "\n";
+		return;
+	}
+	out << "scope,average_ms,last_ms,min_ms,max_ms,samples\n";
+	for (const GpuScopeStats &s : stats) {
+		out << s.name << "," << s.average() << "," << s.last << "," << s.min << ","
+			<< s.max << "," << s.samples << "\n";
+	}
+	std::cout << "GPU profile written to " << file << "\n";
+}
+
+void GpuProfiler::writeJSON(const std::string &file) {
+	nlohmann::json j;
+	j["timestampPeriodNs"] = timestampPeriod;
+	j["historySize"] = GPU_PROFILER_HISTORY_SIZE;
+	j["scopes"] = nlohmann::json::array();
+	for (const GpuScopeStats &s : stats) {
+		j["scopes"].push_back({
+			{"name", s.name},
+			{"averageMs", s.average()},
+			{"lastMs", s.last},
+			{"minMs", s.min},
+			{"maxMs", s.max},
+			{"samples", s.samples}
+		});
+	}
+	if (fragmentInvocations.samples > 0) {
+		j["fragmentShaderInvocations"] = fragmentInvocations.average();
+		j["overdraw"] = overdraw.average();
+	}
+
+	std::ofstream out(file);
+	if (!out.is_open()) {
+		std::cout << "failed to open " << file << "\n";
+		return;
+	}
+	out << j.dump(4) << "\n";
+	std::cout << "GPU profile written to " << file << "\n";
+}
+
+void GpuProfiler::cleanup() {
+	if (queryPool != VK_NULL_HANDLE) {
+		vkDestroyQueryPool(BP->device, queryPool, nullptr);
+		queryPool = VK_NULL_HANDLE;
+	}
+	if (statisticsPool != VK_NULL_HANDLE) {
+		vkDestroyQueryPool(BP->device, statisticsPool, nullptr);
+		statisticsPool = VK_NULL_HANDLE;
+	}
+}
+
+void OcclusionCuller::init(BaseProject *bp, uint32_t objectCount) {
+	BP = bp;
+	objects.assign(objectCount, CullObject{});
+
+	reduceLayout.init(BP, {
+		{0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT},
+		{1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT}
+	});
+	cullLayout.init(BP, {
+		{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+		{1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+		{2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+		{3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+		{4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+		{5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+		{6, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT}
+	});
+
+	createRenderPasses();
+	createPipelines();
+	createBuffers();
+
+	// nearest texels only: the pyramid is read with texelFetch
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_NEAREST;
+	samplerInfo.minFilter = VK_FILTER_NEAREST;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	samplerInfo.anisotropyEnable = VK_FALSE;
+	samplerInfo.maxAnisotropy = 1.0f;
+	samplerInfo.unnormalizedCoordinates = VK_FALSE;
+	samplerInfo.compareEnable = VK_FALSE;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerInfo.minLod = 0.0f;
+	samplerInfo.maxLod = static_cast<float>(OCCLUSION_MAX_LEVELS);
+
+	VkResult result = vkCreateSampler(BP->device, &samplerInfo, nullptr, &sampler);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create Hi-Z sampler!");
+	}
+
+	createImageResources();
+	createPyramid();
+}
+
+void OcclusionCuller::createRenderPasses() {
+	VkAttachmentDescription colorAttachment{};
+	colorAttachment.format = BP->swapChainImageFormat;
+	colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+	colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	// kept for the pyramid, then for the depth test of the late pass
+	VkAttachmentDescription depthAttachment{};
+	depthAttachment.format = VK_FORMAT_D32_SFLOAT;
+	depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+	depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+	VkAttachmentReference colorAttachmentRef{};
+	colorAttachmentRef.attachment = 0;
+	colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	VkAttachmentReference depthAttachmentRef{};
+	depthAttachmentRef.attachment = 1;
+	depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+	VkSubpassDescription subpass{};
+	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpass.colorAttachmentCount = 1;
+	subpass.pColorAttachments = &colorAttachmentRef;
+	subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+	// early: the pyramid of the previous frame has been read before the depth
+	// is cleared, and the depth is written before the pyramid is built
+	std::array<VkSubpassDependency, 2> dependencies{};
+	dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[0].dstSubpass = 0;
+	dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	dependencies[0].srcAccessMask = 0;
+	dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+			VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+	dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	dependencies[1].srcSubpass = 0;
+	dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	dependencies[1].dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
+
+	VkRenderPassCreateInfo renderPassInfo{};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+	renderPassInfo.pAttachments = attachments.data();
+	renderPassInfo.subpassCount = 1;
+	renderPassInfo.pSubpasses = &subpass;
+	renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+	renderPassInfo.pDependencies = dependencies.data();
+
+	VkResult result = vkCreateRenderPass(BP->device, &renderPassInfo, nullptr, &earlyPass);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create early occlusion render pass!");
+	}
+
+	// late: continues on the image of the early pass once the culling is done
+	colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	colorAttachment.finalLayout = BP->options.headless ?
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+	depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	depthAttachment.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+	depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	attachments = {colorAttachment, depthAttachment};
+
+	VkSubpassDependency dependency{};
+	dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+	dependency.dstSubpass = 0;
+	dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+			VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+	dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	renderPassInfo.dependencyCount = 1;
+	renderPassInfo.pDependencies = &dependency;
+
+	result = vkCreateRenderPass(BP->device, &renderPassInfo, nullptr, &latePass);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create late occlusion render pass!");
+	}
+}
+
+VkPipeline OcclusionCuller::createComputePipeline(const std::string &shader, VkPipelineLayout layout) {
+	std::vector<char> code = Pipeline::readFile(shader);
+
+	VkShaderModuleCreateInfo moduleInfo{};
+	moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	moduleInfo.codeSize = code.size();
+	moduleInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+	VkShaderModule module;
+	VkResult result = vkCreateShaderModule(BP->device, &moduleInfo, nullptr, &module);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create shader module!");
+	}
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	pipelineInfo.stage.module = module;
+	pipelineInfo.stage.pName = "main";
+	pipelineInfo.layout = layout;
+
+	VkPipeline pipeline;
+	result = vkCreateComputePipelines(BP->device, BP->pipelineCache, 1, &pipelineInfo, nullptr, &pipeline);
+	vkDestroyShaderModule(BP->device, module, nullptr);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create compute pipeline " + shader + "!");
+	}
+	return pipeline;
+}
+
+void OcclusionCuller::createPipelines() {
+	VkPushConstantRange range{};
+	range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	range.offset = 0;
+	range.size = 4 * sizeof(uint32_t);
+
+	VkPipelineLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	layoutInfo.setLayoutCount = 1;
+	layoutInfo.pSetLayouts = &reduceLayout.descriptorSetLayout;
+	layoutInfo.pushConstantRangeCount = 1;
+	layoutInfo.pPushConstantRanges = &range;
+
+	VkResult result = vkCreatePipelineLayout(BP->device, &layoutInfo, nullptr, &reducePipelineLayout);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create pipeline layout!");
+	}
+
+	range.size = sizeof(uint32_t);
+	layoutInfo.pSetLayouts = &cullLayout.descriptorSetLayout;
+	result = vkCreatePipelineLayout(BP->device, &layoutInfo, nullptr, &cullPipelineLayout);
+	if (result != VK_SUCCESS) {
+		PrintVkError(result);
+		throw std::runtime_error("failed to create pipeline layout!");
+	}
+
+	reducePipeline = createComputePipeline("shaders/HiZReduceComp.spv", reducePipelineLayout);
+	cullPipeline = createComputePipeline("shaders/OcclusionCullComp.spv", cullPipelineLayout);
+}
+
+void OcclusionCuller::createBuffers() {
+	BP->createBuffer(objects.size() * sizeof(uint32_t),
+					 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+					 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, visibility, visibilityMemory);
+	// nothing visible yet: the first frame draws everything in the late pass
+	VkCommandBuffer commandBuffer = BP->beginSingleTimeCommands();
+	vkCmdFillBuffer(commandBuffer, visibility, 0, VK_WHOLE_SIZE, 0);
+	BP->endSingleTimeCommands(commandBuffer);
+}
+
+void OcclusionCuller::createImageResources() {
+	VkDeviceSize count = objects.size();
+	size_t images = BP->swapChainImages.size();
+
+	objectBuffers.resize(images); objectMemory.resize(images);
+	paramBuffers.resize(images); paramMemory.resize(images);
+	earlyDraws.resize(images); earlyDrawsMemory.resize(images);
+	lateDraws.resize(images); lateDrawsMemory.resize(images);
+	statsBuffers.resize(images); statsMemory.resize(images);
+	for (size_t i = 0; i < images; i++) {
+		BP->createBuffer(count * sizeof(CullObject), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+						 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+						 objectBuffers[i], objectMemory[i]);
+		BP->createBuffer(sizeof(CullParams), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+						 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+						 paramBuffers[i], paramMemory[i]);
+		BP->createBuffer(count * sizeof(VkDrawIndexedIndirectCommand),
+						 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+						 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, earlyDraws[i], earlyDrawsMemory[i]);
+		BP->createBuffer(count * sizeof(VkDrawIndexedIndirectCommand),
+						 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+						 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, lateDraws[i], lateDrawsMemory[i]);
+		BP->createBuffer(sizeof(OcclusionStats),
+						 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+						 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+						 statsBuffers[i], statsMemory[i]);
+	}
+
+	// the level sets too: they come from the same (reset) allocator
+	BP->descriptorAllocator.allocate(reduceLayout, OCCLUSION_MAX_LEVELS, reduceSets);
+	BP->descriptorAllocator.allocate(cullLayout, static_cast<uint32_t>(images), cullSets);
+	pending.assign(images, false);
+}
+
+void OcclusionCuller::cleanupImageResources() {
+	for (size_t i = 0; i < objectBuffers.size(); i++) {
+		vkDestroyBuffer(BP->device, objectBuffers[i], nullptr);
+		vkFreeMemory(BP->device, objectMemory[i], nullptr);
+		vkDestroyBuffer(BP->device, paramBuffers[i], nullptr);
+		vkFreeMemory(BP->device, paramMemory[i], nullptr);
+		vkDestroyBuffer(BP->device, earlyDraws[i], nullptr);
+		vkFreeMemory(BP->device, earlyDrawsMemory[i], nullptr);
+		vkDestroyBuffer(BP->device, lateDraws[i], nullptr);
+		vkFreeMemory(BP->device, lateDrawsMemory[i], nullptr);
+		vkDestroyBuffer(BP->device, statsBuffers[i], nullptr);
+		vkFreeMemory(BP->device, statsMemory[i], nullptr);
+	}
+}
+
+void OcclusionCuller::createPyramid() {
+	width = std::max(1u, BP->swapChainExtent.width / 2);
+	height = std::max(1u, BP->swapChainExtent.height / 2);
+	levels = std::min(OCCLUSION_MAX_LEVELS,
+			static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1);
+
+	BP->createImage(width, height, levels, VK_FORMAT_R32_SFLOAT, VK_IMAGE_TILING_OPTIMAL,
+					VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, pyramid, pyramidMemory);
+	pyramidView = BP->createImageView(pyramid, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, levels);
+	levelViews.resize(levels);
+	for (uint32_t l = 0; l < levels; l++) {
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = pyramid;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = VK_FORMAT_R32_SFLOAT;
+		viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		viewInfo.subresourceRange.baseMipLevel = l;
+		viewInfo.subresourceRange.levelCount = 1;
+		viewInfo.subresourceRange.baseArrayLayer = 0;
+		viewInfo.subresourceRange.layerCount = 1;
+
+		VkResult result = vkCreateImageView(BP->device, &viewInfo, nullptr, &levelViews[l]);
+		if (result != VK_SUCCESS) {
+			PrintVkError(result);
+			throw std::runtime_error("failed to create image view!");
+		}
+	}
+
+	// written and read by the compute shaders only, it stays in GENERAL
+	VkCommandBuffer commandBuffer = BP->beginSingleTimeCommands();
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = pyramid;
+	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseMipLevel = 0;
+	barrier.subresourceRange.levelCount = levels;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount = 1;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	BP->endSingleTimeCommands(commandBuffer);
+
+	// level 0 reads the depth buffer, the others the previous level
+	for (uint32_t l = 0; l < levels; l++) {
+		VkDescriptorImageInfo source{};
+		source.sampler = sampler;
+		source.imageView = l == 0 ? BP->depthImageView : levelViews[l - 1];
+		source.imageLayout = l == 0 ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+		VkDescriptorImageInfo destination{};
+		destination.imageView = levelViews[l];
+		destination.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+		std::array<VkWriteDescriptorSet, 2> writes{};
+		writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[0].dstSet = reduceSets[l];
+		writes[0].dstBinding = 0;
+		writes[0].descriptorCount = 1;
+		writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writes[0].pImageInfo = &source;
+		writes[1] = writes[0];
+		writes[1].dstBinding = 1;
+		writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		writes[1].pImageInfo = &destination;
+		vkUpdateDescriptorSets(BP->device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+	}
+
+	VkDeviceSize count = objects.size();
+	for (size_t i = 0; i < cullSets.size(); i++) {
+		std::array<VkDescriptorBufferInfo, 6> buffers = {{
+			{ objectBuffers[i], 0, count * sizeof(CullObject) },
+			{ paramBuffers[i], 0, sizeof(CullParams) },
+			{ visibility, 0, count * sizeof(uint32_t) },
+			{ earlyDraws[i], 0, count * sizeof(VkDrawIndexedIndirectCommand) },
+			{ lateDraws[i], 0, count * sizeof(VkDrawIndexedIndirectCommand) },
+			{ statsBuffers[i], 0, sizeof(OcclusionStats) }
+		}};
+		VkDescriptorImageInfo pyramidInfo{};
+		pyramidInfo.sampler = sampler;
+		pyramidInfo.imageView = pyramidView;
+		pyramidInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+		std::array<VkWriteDescriptorSet, 7> writes{};
+		for (uint32_t b = 0; b < writes.size(); b++) {
+			writes[b].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[b].dstSet = cullSets[i];
+			writes[b].dstBinding = b;
+			writes[b].descriptorCount = 1;
+			if (b == 1) {
+				writes[b].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+				writes[b].pBufferInfo = &buffers[b];
+			} else if (b == 6) {
+				writes[b].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				writes[b].pImageInfo = &pyramidInfo;
+			} else {
+				writes[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				writes[b].pBufferInfo = &buffers[b];
+			}
+		}
+		vkUpdateDescriptorSets(BP->device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+	}
+}
+
+void OcclusionCuller::cleanupPyramid() {
+	for (VkImageView view : levelViews) {
+		vkDestroyImageView(BP->device, view, nullptr);
+	}
+	levelViews.clear();
+	vkDestroyImageView(BP->device, pyramidView, nullptr);
+	vkDestroyImage(BP->device, pyramid, nullptr);
+	vkFreeMemory(BP->device, pyramidMemory, nullptr);
+}
+
+void OcclusionCuller::setObject(uint32_t object, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax,
+								uint32_t indexCount) {
+	objects[object].boundsMin = glm::vec4(boundsMin, 1.0f);
+	objects[object].boundsMax = glm::vec4(boundsMax, 1.0f);
+	objects[object].indexCount = indexCount;
+}
+
+void OcclusionCuller::upload(int currentImage, const glm::mat4 &viewProj) {
+	void* data;
+	vkMapMemory(BP->device, objectMemory[currentImage], 0, objects.size() * sizeof(CullObject), 0, &data);
+	memcpy(data, objects.data(), objects.size() * sizeof(CullObject));
+	vkUnmapMemory(BP->device, objectMemory[currentImage]);
+
+	CullParams params{};
+	params.viewProj = viewProj;
+	params.counts = glm::uvec4(static_cast<uint32_t>(objects.size()), width, height, levels);
+	vkMapMemory(BP->device, paramMemory[currentImage], 0, sizeof(params), 0, &data);
+	memcpy(data, &params, sizeof(params));
+	vkUnmapMemory(BP->device, paramMemory[currentImage]);
+}
+
+void OcclusionCuller::recordEarly(VkCommandBuffer commandBuffer, int currentImage) {
+	vkCmdFillBuffer(commandBuffer, statsBuffers[currentImage], 0, VK_WHOLE_SIZE, 0);
+
+	// the late pass of the previous frame has written the visibility
+	VkMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+	vkCmdPipelineBarrier(commandBuffer,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+	uint32_t late = 0;
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 0, 1,
+							&cullSets[currentImage], 0, nullptr);
+	vkCmdPushConstants(commandBuffer, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(late), &late);
+	vkCmdDispatch(commandBuffer, (static_cast<uint32_t>(objects.size()) + 63) / 64, 1, 1);
+
+	barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void OcclusionCuller::recordCull(VkCommandBuffer commandBuffer, int currentImage) {
+	VkMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipeline);
+	uint32_t sourceWidth = BP->swapChainExtent.width, sourceHeight = BP->swapChainExtent.height;
+	uint32_t levelWidth = width, levelHeight = height;
+	for (uint32_t l = 0; l < levels; l++) {
+		uint32_t sizes[4] = { sourceWidth, sourceHeight, levelWidth, levelHeight };
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipelineLayout, 0, 1,
+								&reduceSets[l], 0, nullptr);
+		vkCmdPushConstants(commandBuffer, reducePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(sizes), sizes);
+		vkCmdDispatch(commandBuffer, (levelWidth + 7) / 8, (levelHeight + 7) / 8, 1);
+		// the next level reads this one
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+		sourceWidth = levelWidth;
+		sourceHeight = levelHeight;
+		levelWidth = std::max(1u, levelWidth / 2);
+		levelHeight = std::max(1u, levelHeight / 2);
+	}
+
+	uint32_t late = 1;
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 0, 1,
+							&cullSets[currentImage], 0, nullptr);
+	vkCmdPushConstants(commandBuffer, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(late), &late);
+	vkCmdDispatch(commandBuffer, (static_cast<uint32_t>(objects.size()) + 63) / 64, 1, 1);
+
+	// late draws, and the statistics read by collect() after the fence
+	barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+void OcclusionCuller::drawIndexed(VkCommandBuffer commandBuffer, int currentImage, uint32_t object, bool late) {
+	vkCmdDrawIndexedIndirect(commandBuffer, late ? lateDraws[currentImage] : earlyDraws[currentImage],
+							 object * sizeof(VkDrawIndexedIndirectCommand), 1,
+							 sizeof(VkDrawIndexedIndirectCommand));
+}
+
+void OcclusionCuller::collect(int currentImage) {
+	if (!pending[currentImage]) return;
+	pending[currentImage] = false;
+
+	OcclusionStats stats;
+	void* data;
+	vkMapMemory(BP->device, statsMemory[currentImage], 0, sizeof(stats), 0, &data);
+	memcpy(&stats, data, sizeof(stats));
+	vkUnmapMemory(BP->device, statsMemory[currentImage]);
+	tested += stats.tested;
+	frustumCulled += stats.frustumCulled;
+	occluded += stats.occluded;
+	drawnLate += stats.drawnLate;
+}
+
+double OcclusionCuller::occludedPercent() const {
+	return tested == 0 ? 0.0 : 100.0 * occluded / tested;
+}
+
+void OcclusionCuller::cleanup() {
+	if (!enabled()) return;
+	cleanupPyramid();
+	vkDestroySampler(BP->device, sampler, nullptr);
+	vkDestroyBuffer(BP->device, visibility, nullptr);
+	vkFreeMemory(BP->device, visibilityMemory, nullptr);
+	cleanupImageResources();
+	vkDestroyPipeline(BP->device, reducePipeline, nullptr);
+	vkDestroyPipeline(BP->device, cullPipeline, nullptr);
+	vkDestroyPipelineLayout(BP->device, reducePipelineLayout, nullptr);
+	vkDestroyPipelineLayout(BP->device, cullPipelineLayout, nullptr);
+	reduceLayout.cleanup();
+	cullLayout.cleanup();
+	vkDestroyRenderPass(BP->device, earlyPass, nullptr);
+	vkDestroyRenderPass(BP->device, latePass, nullptr);
+	earlyPass = VK_NULL_HANDLE;
+}
+
+
+
+void BenchmarkScript::load(const std::string &file) {
+	std::ifstream in(file);
+	if (!in.is_open()) {
+		throw std::runtime_error("failed to open benchmark script " + file + "!");
+	}
+
+	nlohmann::json j;
+	try {
+		in >> j;
+		name = j.value("name", file);
+		warmupFrames = j.value("warmupFrames", 0);
+		frames = j.at("frames").get<uint64_t>();
+		dt = j.value("dt", 1.0f / 60.0f);
+
+		events.clear();
+		for (const auto &e : j.at("events")) {
+			uint64_t frame = e.at("frame").get<uint64_t>();
+			int key = keyFromName(e.at("key").get<std::string>());
+			std::string action = e.at("action").get<std::string>();
+
+			if (action == "press" || action == "tap") {
+				events.push_back({ frame, key, GLFW_PRESS });
+			}
+			if (action == "release" || action == "tap") {
+				events.push_back({ frame, key, GLFW_RELEASE });
+			} else if (action != "press") {
+				throw std::runtime_error("unknown action " + action);
+			}
+		}
+	} catch (const std::exception &e) {
+		throw std::runtime_error("invalid benchmark script " + file + ": " + e.what());
+	}
+
+	std::stable_sort(events.begin(), events.end(),
+		[](const BenchmarkEvent &a, const BenchmarkEvent &b) { return a.frame < b.frame; });
+}
+
+int BenchmarkScript::keyFromName(const std::string &keyName) {
+	static const std::map<std::string, int> namedKeys = {
+		{"SPACE", GLFW_KEY_SPACE},
+		{"LEFT", GLFW_KEY_LEFT},
+		{"RIGHT", GLFW_KEY_RIGHT},
+		{"UP", GLFW_KEY_UP},
+		{"DOWN", GLFW_KEY_DOWN}
+	};
+
+	// GLFW letter and digit key codes are their ASCII values
+	if (keyName.size() == 1 && ((keyName[0] >= 'A' && keyName[0] <= 'Z') ||
+								(keyName[0] >= '0' && keyName[0] <= '9'))) {
+		return keyName[0];
+	}
+	auto it = namedKeys.find(keyName);
+	if (it == namedKeys.end()) {
+		throw std::runtime_error("unknown key " + keyName);
+	}
+	return it->second;
+}
+
+nlohmann::json SummarizeTimes(std::vector<double> samples) {
+	if (samples.empty()) {
+		return nullptr;
+	}
+	std::sort(samples.begin(), samples.end());
+
+	// nearest rank percentile
+	auto percentile = [&samples](double p) {
+		size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+		return samples[std::max<size_t>(rank, 1) - 1];
+	};
+
+	double sum = 0.0;
+	for (double v : samples) {
+		sum += v;
+	}
+
+	return {
+		{"min", samples.front()},
+		{"avg", sum / samples.size()},
+		{"p50", percentile(50)},
+		{"p95", percentile(95)},
+		{"p99", percentile(99)},
+		{"max", samples.back()},
+		{"count", samples.size()}
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+// Calls body(begin, end) on contiguous ranges covering [0, count), one range
+// per hardware thread (the calling thread takes the first one). Ranges are at
+// least minPerTask items long, so small inputs run inline.
+template <typename Body>
+void ParallelFor(size_t count, Body body, size_t minPerTask = 1) {
+	if (count == 0) return;
+
+	size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	size_t tasks = std::min(threads, (count + minPerTask - 1) / std::max<size_t>(1, minPerTask));
+	if (tasks <= 1) {
+		body(size_t(0), count);
+		return;
+	}
+
+	size_t perTask = (count + tasks - 1) / tasks;
+	std::vector<std::future<void>> workers;
+	for (size_t begin = perTask; begin < count; begin += perTask) {
+		size_t end = std::min(count, begin + perTask);
+		workers.push_back(std::async(std::launch::async, [&body, begin, end]() { body(begin, end); }));
+	}
+	body(size_t(0), std::min(count, perTask));
+	for (std::future<void> &w : workers) {
+		// rethrows the exceptions of the workers
+		w.get();
+	}
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+// CPU occlusion culling, without GPU compute: the largest occluders are
+// rasterized into a small depth buffer, then the bounding box of every object
+// is tested against it before the command buffers are recorded. The buffer is
+// split in tiles rasterized in parallel, and the inner loops work on 4 pixels
+// at a time with a coverage mask.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Parallel.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#else
+#define SOFTWARE_OCCLUSION_SSE2 0
+#endif
+
+// the width is a multiple of the tile width, the tile width a multiple of 4
+const uint32_t SOFTWARE_OCCLUSION_WIDTH = 320;
+const uint32_t SOFTWARE_OCCLUSION_HEIGHT = 192;
+const uint32_t SOFTWARE_OCCLUSION_TILE_WIDTH = 64;
+const uint32_t SOFTWARE_OCCLUSION_TILE_HEIGHT = 32;
+const uint32_t SOFTWARE_OCCLUSION_TILES_X = SOFTWARE_OCCLUSION_WIDTH / SOFTWARE_OCCLUSION_TILE_WIDTH;
+const uint32_t SOFTWARE_OCCLUSION_TILES_Y = SOFTWARE_OCCLUSION_HEIGHT / SOFTWARE_OCCLUSION_TILE_HEIGHT;
+// the occluders are sampled at the pixel centers: the tested rectangle grows
+// by this many pixels and its depth moves this much nearer, so that a box is
+// never culled behind a pixel the occluders only partly cover
+const int SOFTWARE_OCCLUSION_GUARD_PIXELS = 1;
+const float SOFTWARE_OCCLUSION_DEPTH_BIAS = 1e-4f;
+
+enum class OcclusionResult { VISIBLE, OUTSIDE_VIEW, OCCLUDED };
+
+struct SoftwareOcclusion {
+	// depth in [0, 1] as in Vulkan (0 near), cleared to 1
+	std::vector<float> depth;
+	std::vector<float> tileMaxDepth;	// farthest depth of each tile, for the early out of the tests
+	bool multithreaded = true;
+
+	// the edge functions and the depth plane of a screen triangle, ax + by + c
+	struct Triangle {
+		float edgeA[3], edgeB[3], edgeC[3];
+		float depthA, depthB, depthC;
+		int minX, minY, maxX, maxY;		// pixels, inclusive
+	};
+	std::vector<Triangle> triangles;
+	std::vector<std::vector<uint32_t>> bins;	// triangles touching each tile
+
+	glm::mat4 viewProj = glm::mat4(1.0f);
+
+	// timings of the last frame, and totals of the tests
+	double rasterizeMs = 0.0;
+	double testMs = 0.0;
+	uint64_t tested = 0, outsideView = 0, occluded = 0;
+
+	void begin(const glm::mat4 &viewProjection) {
+		viewProj = viewProjection;
+		triangles.clear();
+		testMs = 0.0;
+	}
+
+	// V has a glm::vec3 pos member, like Vertex
+	template <typename V>
+	void addOccluder(const std::vector<V> &vertices, const std::vector<uint32_t> &indices, const glm::mat4 &world) {
+		glm::mat4 m = viewProj * world;
+		std::vector<glm::vec4> clip(vertices.size());
+		for (size_t i = 0; i < vertices.size(); i++) {
+			clip[i] = m * glm::vec4(vertices[i].pos, 1.0f);
+		}
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			addClipTriangle(clip[indices[i]], clip[indices[i + 1]], clip[indices[i + 2]]);
+		}
+	}
+
+	// clips against the near plane (z >= 0), which leaves 0, 1 or 2 triangles
+	void addClipTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c) {
+		const glm::vec4 in[3] = { a, b, c };
+		glm::vec4 out[4];
+		int count = 0;
+		for (int i = 0; i < 3; i++) {
+			const glm::vec4 &p = in[i], &q = in[(i + 1) % 3];
+			if (p.z >= 0.0f) out[count++] = p;
+			if ((p.z >= 0.0f) != (q.z >= 0.0f)) {
+				out[count++] = glm::mix(p, q, p.z / (p.z - q.z));
+			}
+		}
+		for (int i = 1; i + 1 < count; i++) {
+			addScreenTriangle(out[0], out[i], out[i + 1]);
+		}
+	}
+
+	void addScreenTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c) {
+		const glm::vec4 *clip[3] = { &a, &b, &c };
+		float x[3], y[3], z[3];
+		for (int i = 0; i < 3; i++) {
+			float w = std::max(clip[i]->w, 1e-6f);
+			x[i] = (clip[i]->x / w * 0.5f + 0.5f) * SOFTWARE_OCCLUSION_WIDTH;
+			y[i] = (clip[i]->y / w * 0.5f + 0.5f) * SOFTWARE_OCCLUSION_HEIGHT;
+			z[i] = clip[i]->z / w;
+		}
+
+		float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if (area == 0.0f || std::isnan(area)) return;
+
+		Triangle t;
+		float minX = std::min({ x[0], x[1], x[2] }), maxX = std::max({ x[0], x[1], x[2] });
+		float minY = std::min({ y[0], y[1], y[2] }), maxY = std::max({ y[0], y[1], y[2] });
+		// pixel centers inside the bounding box
+		t.minX = std::max(0, static_cast<int>(std::ceil(minX - 0.5f)));
+		t.minY = std::max(0, static_cast<int>(std::ceil(minY - 0.5f)));
+		t.maxX = std::min(static_cast<int>(SOFTWARE_OCCLUSION_WIDTH) - 1, static_cast<int>(std::floor(maxX - 0.5f)));
+		t.maxY = std::min(static_cast<int>(SOFTWARE_OCCLUSION_HEIGHT) - 1, static_cast<int>(std::floor(maxY - 0.5f)));
+		if (t.minX > t.maxX || t.minY > t.maxY) return;
+
+		// both windings are kept: the edge functions are positive inside
+		float sign = area > 0.0f ? 1.0f : -1.0f;
+		for (int e = 0; e < 3; e++) {
+			int p = (e + 1) % 3, q = (e + 2) % 3;
+			t.edgeA[e] = sign * -(y[q] - y[p]);
+			t.edgeB[e] = sign * (x[q] - x[p]);
+			t.edgeC[e] = sign * (x[p] * (y[q] - y[p]) - y[p] * (x[q] - x[p]));
+		}
+		// z / w is linear in screen space
+		t.depthA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+		t.depthB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+		t.depthC = z[0] - t.depthA * x[0] - t.depthB * y[0];
+		triangles.push_back(t);
+	}
+
+	void rasterize() {
+		auto start = std::chrono::high_resolution_clock::now();
+		depth.resize(SOFTWARE_OCCLUSION_WIDTH * SOFTWARE_OCCLUSION_HEIGHT);
+		tileMaxDepth.resize(SOFTWARE_OCCLUSION_TILES_X * SOFTWARE_OCCLUSION_TILES_Y);
+
+		bins.resize(SOFTWARE_OCCLUSION_TILES_X * SOFTWARE_OCCLUSION_TILES_Y);
+		for (std::vector<uint32_t> &bin : bins) bin.clear();
+		for (uint32_t i = 0; i < triangles.size(); i++) {
+			const Triangle &t = triangles[i];
+			for (int ty = t.minY / SOFTWARE_OCCLUSION_TILE_HEIGHT; ty <= t.maxY / (int) SOFTWARE_OCCLUSION_TILE_HEIGHT; ty++) {
+				for (int tx = t.minX / SOFTWARE_OCCLUSION_TILE_WIDTH; tx <= t.maxX / (int) SOFTWARE_OCCLUSION_TILE_WIDTH; tx++) {
+					bins[ty * SOFTWARE_OCCLUSION_TILES_X + tx].push_back(i);
+				}
+			}
+		}
+
+		// the tiles write disjoint pixels
+		auto tiles = [this](size_t begin, size_t end) {
+			for (size_t tile = begin; tile < end; tile++) {
+				rasterizeTile(static_cast<uint32_t>(tile));
+			}
+		};
+		if (multithreaded) {
+			ParallelFor(bins.size(), tiles);
+		} else {
+			tiles(0, bins.size());
+		}
+
+		rasterizeMs = std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void rasterizeTile(uint32_t tile) {
+		int x0 = (tile % SOFTWARE_OCCLUSION_TILES_X) * SOFTWARE_OCCLUSION_TILE_WIDTH;
+		int y0 = (tile / SOFTWARE_OCCLUSION_TILES_X) * SOFTWARE_OCCLUSION_TILE_HEIGHT;
+		int x1 = x0 + SOFTWARE_OCCLUSION_TILE_WIDTH - 1;
+		int y1 = y0 + SOFTWARE_OCCLUSION_TILE_HEIGHT - 1;
+		for (int y = y0; y <= y1; y++) {
+			std::fill_n(&depth[y * SOFTWARE_OCCLUSION_WIDTH + x0], SOFTWARE_OCCLUSION_TILE_WIDTH, 1.0f);
+		}
+
+		for (uint32_t i : bins[tile]) {
+			const Triangle &t = triangles[i];
+			int minY = std::max(t.minY, y0), maxY = std::min(t.maxY, y1);
+			// groups of 4 pixels aligned to the row
+			int minX = std::max(t.minX, x0) & ~3, maxX = std::min(t.maxX, x1);
+			for (int y = minY; y <= maxY; y++) {
+				float py = y + 0.5f;
+				float *row = &depth[y * SOFTWARE_OCCLUSION_WIDTH];
+#if SOFTWARE_OCCLUSION_SSE2
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+				__m128 rowEdge[3], edgeA[3];
+				for (int e = 0; e < 3; e++) {
+					rowEdge[e] = _mm_set1_ps(t.edgeB[e] * py + t.edgeC[e]);
+					edgeA[e] = _mm_set1_ps(t.edgeA[e]);
+				}
+				const __m128 rowDepth = _mm_set1_ps(t.depthB * py + t.depthC);
+				const __m128 depthA = _mm_set1_ps(t.depthA);
+				for (int x = minX; x <= maxX; x += 4) {
+					__m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+					__m128 mask = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], px), rowEdge[0]), zero);
+					mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[1], px), rowEdge[1]), zero));
+					mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[2], px), rowEdge[2]), zero));
+					if (_mm_movemask_ps(mask) == 0) continue;
+					__m128 z = _mm_add_ps(_mm_mul_ps(depthA, px), rowDepth);
+					__m128 old = _mm_loadu_ps(row + x);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, _mm_min_ps(old, z)), _mm_andnot_ps(mask, old)));
+				}
+#else
+				for (int x = minX; x <= maxX; x++) {
+					float px = x + 0.5f;
+					bool inside = true;
+					for (int e = 0; e < 3; e++) {
+						inside = inside && t.edgeA[e] * px + t.edgeB[e] * py + t.edgeC[e] >= 0.0f;
+					}
+					if (inside) {
+						row[x] = std::min(row[x], t.depthA * px + t.depthB * py + t.depthC);
+					}
+				}
+#endif
+			}
+		}
+
+		float farthest = 0.0f;
+		for (int y = y0; y <= y1; y++) {
+			const float *row = &depth[y * SOFTWARE_OCCLUSION_WIDTH];
+			farthest = std::max(farthest, *std::max_element(row + x0, row + x1 + 1));
+		}
+		tileMaxDepth[tile] = farthest;
+	}
+
+	// an object is occluded when every pixel its box covers is nearer than the box
+	OcclusionResult test(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) {
+		auto start = std::chrono::high_resolution_clock::now();
+		OcclusionResult result = testBox(boundsMin, boundsMax);
+		testMs += std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - start).count();
+		tested++;
+		if (result == OcclusionResult::OUTSIDE_VIEW) outsideView++;
+		if (result == OcclusionResult::OCCLUDED) occluded++;
+		return result;
+	}
+
+	OcclusionResult testBox(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) const {
+		glm::vec3 ndcMin(INFINITY), ndcMax(-INFINITY);
+		for (int corner = 0; corner < 8; corner++) {
+			glm::vec3 p(corner & 1 ? boundsMax.x : boundsMin.x,
+						corner & 2 ? boundsMax.y : boundsMin.y,
+						corner & 4 ? boundsMax.z : boundsMin.z);
+			glm::vec4 clip = viewProj * glm::vec4(p, 1.0f);
+			// crosses the near plane: no safe screen rectangle
+			if (clip.w <= 0.0f || clip.z < 0.0f) return OcclusionResult::VISIBLE;
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			ndcMin = glm::min(ndcMin, ndc);
+			ndcMax = glm::max(ndcMax, ndc);
+		}
+		if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f || ndcMin.z > 1.0f) {
+			return OcclusionResult::OUTSIDE_VIEW;
+		}
+
+		// every pixel the rectangle touches, and the guard band around it
+		const int guard = SOFTWARE_OCCLUSION_GUARD_PIXELS;
+		int x0 = std::max(0, static_cast<int>(std::floor((ndcMin.x * 0.5f + 0.5f) * SOFTWARE_OCCLUSION_WIDTH)) - guard);
+		int y0 = std::max(0, static_cast<int>(std::floor((ndcMin.y * 0.5f + 0.5f) * SOFTWARE_OCCLUSION_HEIGHT)) - guard);
+		int x1 = std::min(static_cast<int>(SOFTWARE_OCCLUSION_WIDTH) - 1,
+				static_cast<int>(std::floor((ndcMax.x * 0.5f + 0.5f) * SOFTWARE_OCCLUSION_WIDTH)) + guard);
+		int y1 = std::min(static_cast<int>(SOFTWARE_OCCLUSION_HEIGHT) - 1,
+				static_cast<int>(std::floor((ndcMax.y * 0.5f + 0.5f) * SOFTWARE_OCCLUSION_HEIGHT)) + guard);
+		float nearest = ndcMin.z - SOFTWARE_OCCLUSION_DEPTH_BIAS;
+
+		for (int ty = y0 / SOFTWARE_OCCLUSION_TILE_HEIGHT; ty <= y1 / (int) SOFTWARE_OCCLUSION_TILE_HEIGHT; ty++) {
+			for (int tx = x0 / SOFTWARE_OCCLUSION_TILE_WIDTH; tx <= x1 / (int) SOFTWARE_OCCLUSION_TILE_WIDTH; tx++) {
+				// the whole tile is nearer than the box
+				if (tileMaxDepth[ty * SOFTWARE_OCCLUSION_TILES_X + tx] < nearest) continue;
+				int minX = std::max(x0, tx * (int) SOFTWARE_OCCLUSION_TILE_WIDTH);
+				int maxX = std::min(x1, (tx + 1) * (int) SOFTWARE_OCCLUSION_TILE_WIDTH - 1);
+				int minY = std::max(y0, ty * (int) SOFTWARE_OCCLUSION_TILE_HEIGHT);
+				int maxY = std::min(y1, (ty + 1) * (int) SOFTWARE_OCCLUSION_TILE_HEIGHT - 1);
+				for (int y = minY; y <= maxY; y++) {
+					if (anyFarther(&depth[y * SOFTWARE_OCCLUSION_WIDTH], minX, maxX, nearest)) {
+						return OcclusionResult::VISIBLE;
+					}
+				}
+			}
+		}
+		return OcclusionResult::OCCLUDED;
+	}
+
+	// some pixel of row[minX..maxX] is at or behind z
+	static bool anyFarther(const float *row, int minX, int maxX, float z) {
+		int x = minX;
+#if SOFTWARE_OCCLUSION_SSE2
+		const __m128 nearest = _mm_set1_ps(z);
+		for (; x + 3 <= maxX; x += 4) {
+			if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), nearest)) != 0) return true;
+		}
+#endif
+		for (; x <= maxX; x++) {
+			if (row[x] >= z) return true;
+		}
+		return false;
+	}
+
+	double occludedPercent() const {
+		return tested == 0 ? 0.0 : 100.0 * occluded / tested;
+	}
+};
@@ -0,0 +1,235 @@
+#pragma once
+
+// Texture container: a small header, a table of the mip levels, then every
+// level already in the format the image is created with, so loading is one
+// read into the staging buffer and one copy, with no decode and no blits.
+// Containers are baked offline (--bake-texture) next to the source image, or
+// on the first load into a cache keyed by a hash of the source paths, sizes
+// and modification times and of the format.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// SSSE3 is not in the x64 baseline (MSVC has no flag for it short of
+// /arch:AVX): its path is compiled for every x86 target and picked at run
+// time from CPUID
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <tmmintrin.h>
+#define TEXTURE_CONTAINER_SSSE3 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TEXTURE_CONTAINER_TARGET_SSSE3
+#else
+#define TEXTURE_CONTAINER_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#else
+#define TEXTURE_CONTAINER_SSSE3 0
+#endif
+
+const uint32_t TEXTURE_CONTAINER_MAGIC = 0x58544754;	// "TGTX"
+const uint32_t TEXTURE_CONTAINER_VERSION = 1;
+const char *const TEXTURE_CONTAINER_EXTENSION = ".tgtx";
+const char *const TEXTURE_CACHE_DIR = "texture_cache";	// TANGRAM_TEXTURE_CACHE overrides it
+
+struct TextureContainerHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t format;		// VkFormat
+	uint32_t width;
+	uint32_t height;
+	uint32_t levels;
+	uint32_t layers;
+	uint32_t bytesPerBlock;	// 4 for RGBA8, 8 or 16 for the 4x4 blocks of BCn
+};
+
+// where level i starts after the level table, and its size (all layers)
+struct TextureContainerLevel {
+	uint64_t offset;
+	uint64_t size;
+};
+
+struct TextureContainer {
+	TextureContainerHeader header{};
+	std::vector<TextureContainerLevel> levels;
+	std::string path;
+	uint64_t dataOffset = 0;
+	uint64_t dataSize = 0;
+
+	// reads the header and the level table only
+	bool open(const std::string &file) {
+		std::ifstream in(file, std::ios::binary);
+		if (!in.is_open()) return false;
+		in.read(reinterpret_cast<char *>(&header), sizeof(header));
+		if (!in || header.magic != TEXTURE_CONTAINER_MAGIC || header.version != TEXTURE_CONTAINER_VERSION ||
+			header.levels == 0 || header.levels > 32) {
+			return false;
+		}
+		levels.resize(header.levels);
+		in.read(reinterpret_cast<char *>(levels.data()), sizeof(TextureContainerLevel) * levels.size());
+		if (!in) return false;
+		path = file;
+		dataOffset = sizeof(header) + sizeof(TextureContainerLevel) * levels.size();
+		dataSize = levels.back().offset + levels.back().size;
+
+		// a truncated file, or a table that does not match the header
+		std::error_code ec;
+		uint64_t fileSize = std::filesystem::file_size(file, ec);
+		if (ec || dataSize < levels.back().offset || dataOffset + dataSize > fileSize) return false;
+		std::vector<TextureContainerLevel> expected = levelTable(header);
+		for (uint32_t level = 0; level < header.levels; level++) {
+			if (levels[level].offset != expected[level].offset || levels[level].size != expected[level].size) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// every level from first on (the smallest ones are last), in one read,
+	// e.g. straight into a mapped staging buffer
+	void readData(void *destination, uint32_t first = 0) const {
+		std::ifstream in(path, std::ios::binary);
+		in.seekg(dataOffset + levels[first].offset);
+		in.read(static_cast<char *>(destination), dataSize - levels[first].offset);
+		if (!in) {
+			throw std::runtime_error("failed to read texture container " + path + "!");
+		}
+	}
+
+	// the levels one after the other, each with all its layers, as they are
+	// written and uploaded
+	static std::vector<TextureContainerLevel> levelTable(const TextureContainerHeader &header) {
+		std::vector<TextureContainerLevel> table;
+		uint64_t offset = 0;
+		for (uint32_t level = 0; level < header.levels; level++) {
+			uint64_t w = std::max(1u, header.width >> level), h = std::max(1u, header.height >> level);
+			// bytesPerBlock 4 is an RGBA8 texel, the larger ones 4x4 blocks
+			uint64_t size = header.bytesPerBlock == 4 ? w * h * 4 : ((w + 3) / 4) * ((h + 3) / 4) * header.bytesPerBlock;
+			table.push_back({ offset, size * header.layers });
+			offset += size * header.layers;
+		}
+		return table;
+	}
+
+	// data: every level, laid out as in levelTable
+	static bool write(const std::string &file, TextureContainerHeader header, const uint8_t *data) {
+		header.magic = TEXTURE_CONTAINER_MAGIC;
+		header.version = TEXTURE_CONTAINER_VERSION;
+		std::vector<TextureContainerLevel> table = levelTable(header);
+
+		// written aside and renamed, so a reader never sees half a file
+		std::string temporary = file + ".tmp";
+		{
+			std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+			if (!out.is_open()) return false;
+			out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+			out.write(reinterpret_cast<const char *>(table.data()), sizeof(TextureContainerLevel) * table.size());
+			out.write(reinterpret_cast<const char *>(data), table.back().offset + table.back().size);
+			if (!out) return false;
+		}
+		std::error_code ec;
+		std::filesystem::rename(temporary, file, ec);
+		return !ec;
+	}
+};
+
+// FNV-1a
+inline uint64_t HashBytes(const void *data, size_t size, uint64_t hash = 0xcbf29ce484222325ull) {
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+	}
+	return hash;
+}
+
+// cache file of the source images of a texture (one per layer): changes when
+// one of them is edited or replaced
+inline std::string TextureCachePath(const std::vector<std::string> &sources, const std::string &variant) {
+	uint64_t hash = HashBytes(variant.data(), variant.size());
+	hash = HashBytes(&TEXTURE_CONTAINER_VERSION, sizeof(TEXTURE_CONTAINER_VERSION), hash);
+	std::filesystem::path first;
+	for (const std::string &source : sources) {
+		std::error_code ec;
+		std::filesystem::path resolved = std::filesystem::absolute(source, ec);
+		uint64_t size = std::filesystem::file_size(resolved, ec);
+		int64_t time = std::filesystem::last_write_time(resolved, ec).time_since_epoch().count();
+
+		std::string name = resolved.generic_string();
+		hash = HashBytes(name.data(), name.size() + 1, hash);
+		hash = HashBytes(&size, sizeof(size), hash);
+		hash = HashBytes(&time, sizeof(time), hash);
+		if (first.empty()) first = resolved;
+	}
+
+	const char *dir = std::getenv("TANGRAM_TEXTURE_CACHE");
+	char hex[17];
+	snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+	return (std::filesystem::path(dir != nullptr ? dir : TEXTURE_CACHE_DIR) /
+			(first.stem().string() + "-" + hex + TEXTURE_CONTAINER_EXTENSION)).string();
+}
+
+#if TEXTURE_CONTAINER_SSSE3
+inline bool CpuHasSSSE3() {
+	static const bool supported = [] {
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 9)) != 0;
+#else
+		return __builtin_cpu_supports("ssse3") != 0;
+#endif
+	}();
+	return supported;
+}
+
+// RGB to RGBA8, 4 texels at a time; returns how many texels it converted
+TEXTURE_CONTAINER_TARGET_SSSE3
+inline size_t ExpandRGBToRGBA8SSSE3(const uint8_t *source, size_t count, uint8_t *destination) {
+	const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+	size_t i = 0;
+	// each load reads 16 bytes for the 12 of 4 texels: stop before the end
+	for (; i + 6 <= count; i += 4) {
+		__m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 3));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i * 4),
+						 _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+	}
+	return i;
+}
+#endif
+
+// count texels of 1 to 4 channels (as decoded by stb_image) to RGBA8, e.g.
+// straight into the level 0 of a mip chain. RGB is shuffled 4 texels at a
+// time with SSSE3 when the CPU has it.
+inline void ExpandToRGBA8(const uint8_t *source, int channels, size_t count, uint8_t *destination) {
+	if (channels == 4) {
+		memcpy(destination, source, count * 4);
+		return;
+	}
+	size_t i = 0;
+#if TEXTURE_CONTAINER_SSSE3
+	if (channels == 3 && CpuHasSSSE3()) {
+		i = ExpandRGBToRGBA8SSSE3(source, count, destination);
+	}
+#endif
+	for (; i < count; i++) {
+		const uint8_t *s = source + i * channels;
+		uint8_t *d = destination + i * 4;
+		if (channels <= 2) {
+			d[0] = d[1] = d[2] = s[0];
+			d[3] = channels == 2 ? s[1] : 255;
+		} else {
+			d[0] = s[0];
+			d[1] = s[1];
+			d[2] = s[2];
+			d[3] = 255;
+		}
+	}
+}
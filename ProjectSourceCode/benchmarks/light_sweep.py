@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+"""Frame time against the number of lights.
+
+Runs a benchmark script once per light count (--lights N) and prints the CPU
+frame time, the GPU frame time and the CPU time spent assigning the lights to
+the clusters, from the results JSON of each run.
+
+    python3 light_sweep.py path/to/game [--script tour.json] [--counts 0,16,64,256,1000] [--headless]
+"""
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def stat(results, key, field="p50"):
+    value = results.get(key)
+    return value[field] if value else float("nan")
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser()
+    parser.add_argument("game", help="the Tangram executable")
+    parser.add_argument("--script", default=os.path.join(here, "tour.json"))
+    parser.add_argument("--counts", default="0,16,64,256,1000")
+    parser.add_argument("--headless", action="store_true")
+    args = parser.parse_args()
+
+    print("%8s %14s %14s %18s" % ("lights", "cpu p50 ms", "gpu p50 ms", "assignment p50 ms"))
+    for count in [int(c) for c in args.counts.split(",")]:
+        out = os.path.join(tempfile.gettempdir(), "light_sweep_%d.json" % count)
+        cmd = [args.game, "--benchmark", args.script, "--benchmark-out", out, "--lights", str(count)]
+        if args.headless:
+            cmd.append("--headless")
+        if subprocess.call(cmd, stdout=subprocess.DEVNULL) != 0:
+            print("%8d failed: %s" % (count, " ".join(cmd)))
+            return 1
+        with open(out) as f:
+            results = json.load(f)
+        print("%8d %14.3f %14.3f %18.3f" % (results["lights"],
+                                              stat(results, "cpuFrameMs"),
+                                              stat(results, "gpuFrameMs"),
+                                              stat(results, "lightAssignmentMs")))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
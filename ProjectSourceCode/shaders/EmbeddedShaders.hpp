@@ -0,0 +1,1118 @@
+// Generated by shaders/embed_shaders.py from the .spv files of this folder, do not edit
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace embedded {
+
+constexpr uint32_t HiZReduceComp_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x0000007b, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+	0x00000048, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+	0x0006000f, 0x00000005, 0x00000012, 0x6e69616d, 0x00000000, 0x00000018, 0x00060010, 0x00000012,
+	0x00000011, 0x00000008, 0x00000008, 0x00000001, 0x00030003, 0x00000002, 0x000001c2, 0x00040005,
+	0x00000003, 0x72756f73, 0x00006563, 0x00050005, 0x00000009, 0x74736564, 0x74616e69, 0x006e6f69,
+	0x00040005, 0x0000000f, 0x657a6953, 0x00000073, 0x00060006, 0x0000000f, 0x00000000, 0x72756f73,
+	0x69536563, 0x0000657a, 0x00070006, 0x0000000f, 0x00000001, 0x74736564, 0x74616e69, 0x536e6f69,
+	0x00657a69, 0x00040005, 0x00000010, 0x657a6973, 0x00000073, 0x00040005, 0x00000012, 0x6e69616d,
+	0x00000000, 0x00040005, 0x00000016, 0x65786574, 0x0000006c, 0x00080005, 0x00000018, 0x475f6c67,
+	0x61626f6c, 0x766e496c, 0x7461636f, 0x496e6f69, 0x00000044, 0x00040005, 0x0000002d, 0x73726966,
+	0x00000074, 0x00040005, 0x00000036, 0x7473616c, 0x00000000, 0x00050005, 0x0000004a, 0x74726166,
+	0x74736568, 0x00000000, 0x00030005, 0x0000004d, 0x00000079, 0x00030005, 0x00000059, 0x00000078,
+	0x00040047, 0x00000003, 0x00000022, 0x00000000, 0x00040047, 0x00000003, 0x00000021, 0x00000000,
+	0x00040047, 0x00000009, 0x00000022, 0x00000000, 0x00040047, 0x00000009, 0x00000021, 0x00000001,
+	0x00030047, 0x00000009, 0x00000019, 0x00050048, 0x0000000f, 0x00000000, 0x00000023, 0x00000000,
+	0x00050048, 0x0000000f, 0x00000001, 0x00000023, 0x00000008, 0x00030047, 0x0000000f, 0x00000002,
+	0x00040047, 0x00000018, 0x0000000b, 0x0000001c, 0x00040015, 0x00000002, 0x00000020, 0x00000001,
+	0x0004002b, 0x00000002, 0x00000001, 0x00000008, 0x00030016, 0x00000004, 0x00000020, 0x00090019,
+	0x00000005, 0x00000004, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
+	0x0003001b, 0x00000006, 0x00000005, 0x00040020, 0x00000007, 0x00000000, 0x00000006, 0x0004003b,
+	0x00000007, 0x00000003, 0x00000000, 0x0004002b, 0x00000002, 0x00000008, 0x00000000, 0x00090019,
+	0x0000000a, 0x00000004, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000002, 0x00000003,
+	0x00040020, 0x0000000b, 0x00000000, 0x0000000a, 0x0004003b, 0x0000000b, 0x00000009, 0x00000000,
+	0x0004002b, 0x00000002, 0x0000000c, 0x00000001, 0x00040015, 0x0000000d, 0x00000020, 0x00000000,
+	0x00040017, 0x0000000e, 0x0000000d, 0x00000002, 0x0004001e, 0x0000000f, 0x0000000e, 0x0000000e,
+	0x00040020, 0x00000011, 0x00000009, 0x0000000f, 0x0004003b, 0x00000011, 0x00000010, 0x00000009,
+	0x00020013, 0x00000013, 0x00030021, 0x00000014, 0x00000013, 0x00040020, 0x00000017, 0x00000007,
+	0x0000000e, 0x00040017, 0x00000019, 0x0000000d, 0x00000003, 0x00040020, 0x0000001a, 0x00000001,
+	0x00000019, 0x0004003b, 0x0000001a, 0x00000018, 0x00000001, 0x00040020, 0x0000001f, 0x00000007,
+	0x0000000d, 0x00040020, 0x00000022, 0x00000009, 0x0000000d, 0x00020014, 0x00000024, 0x00040020,
+	0x00000031, 0x00000009, 0x0000000e, 0x0004002b, 0x0000000d, 0x00000038, 0x00000001, 0x0005002c,
+	0x0000000e, 0x00000039, 0x00000038, 0x00000038, 0x00040020, 0x0000004b, 0x00000007, 0x00000004,
+	0x0004002b, 0x00000004, 0x0000004c, 0x00000000, 0x00040017, 0x0000006c, 0x00000002, 0x00000002,
+	0x00040017, 0x0000006f, 0x00000004, 0x00000004, 0x00050036, 0x00000013, 0x00000012, 0x00000000,
+	0x00000014, 0x000200f8, 0x00000015, 0x0004003b, 0x00000017, 0x00000016, 0x00000007, 0x0004003b,
+	0x00000017, 0x0000002d, 0x00000007, 0x0004003b, 0x00000017, 0x00000036, 0x00000007, 0x0004003b,
+	0x0000004b, 0x0000004a, 0x00000007, 0x0004003b, 0x0000001f, 0x0000004d, 0x00000007, 0x0004003b,
+	0x0000001f, 0x00000059, 0x00000007, 0x0004003d, 0x00000019, 0x0000001b, 0x00000018, 0x0007004f,
+	0x0000000e, 0x0000001c, 0x0000001b, 0x0000001b, 0x00000000, 0x00000001, 0x0003003e, 0x00000016,
+	0x0000001c, 0x00050041, 0x0000001f, 0x0000001e, 0x00000016, 0x00000008, 0x0004003d, 0x0000000d,
+	0x0000001d, 0x0000001e, 0x00060041, 0x00000022, 0x00000021, 0x00000010, 0x0000000c, 0x00000008,
+	0x0004003d, 0x0000000d, 0x00000020, 0x00000021, 0x000500ae, 0x00000024, 0x00000023, 0x0000001d,
+	0x00000020, 0x00050041, 0x0000001f, 0x00000026, 0x00000016, 0x0000000c, 0x0004003d, 0x0000000d,
+	0x00000025, 0x00000026, 0x00060041, 0x00000022, 0x00000028, 0x00000010, 0x0000000c, 0x0000000c,
+	0x0004003d, 0x0000000d, 0x00000027, 0x00000028, 0x000500ae, 0x00000024, 0x00000029, 0x00000025,
+	0x00000027, 0x000500a6, 0x00000024, 0x0000002a, 0x00000023, 0x00000029, 0x000300f7, 0x0000002c,
+	0x00000000, 0x000400fa, 0x0000002a, 0x0000002b, 0x0000002c, 0x000200f8, 0x0000002b, 0x000100fd,
+	0x000200f8, 0x0000002c, 0x0004003d, 0x0000000e, 0x0000002e, 0x00000016, 0x00050041, 0x00000031,
+	0x00000030, 0x00000010, 0x00000008, 0x0004003d, 0x0000000e, 0x0000002f, 0x00000030, 0x00050084,
+	0x0000000e, 0x00000032, 0x0000002e, 0x0000002f, 0x00050041, 0x00000031, 0x00000034, 0x00000010,
+	0x0000000c, 0x0004003d, 0x0000000e, 0x00000033, 0x00000034, 0x00050086, 0x0000000e, 0x00000035,
+	0x00000032, 0x00000033, 0x0003003e, 0x0000002d, 0x00000035, 0x0004003d, 0x0000000e, 0x00000037,
+	0x00000016, 0x00050080, 0x0000000e, 0x0000003a, 0x00000037, 0x00000039, 0x00050041, 0x00000031,
+	0x0000003c, 0x00000010, 0x00000008, 0x0004003d, 0x0000000e, 0x0000003b, 0x0000003c, 0x00050084,
+	0x0000000e, 0x0000003d, 0x0000003a, 0x0000003b, 0x00050041, 0x00000031, 0x0000003f, 0x00000010,
+	0x0000000c, 0x0004003d, 0x0000000e, 0x0000003e, 0x0000003f, 0x00050080, 0x0000000e, 0x00000040,
+	0x0000003d, 0x0000003e, 0x00050082, 0x0000000e, 0x00000041, 0x00000040, 0x00000039, 0x00050041,
+	0x00000031, 0x00000043, 0x00000010, 0x0000000c, 0x0004003d, 0x0000000e, 0x00000042, 0x00000043,
+	0x00050086, 0x0000000e, 0x00000044, 0x00000041, 0x00000042, 0x0003003e, 0x00000036, 0x00000044,
+	0x0004003d, 0x0000000e, 0x00000045, 0x00000036, 0x00050041, 0x00000031, 0x00000047, 0x00000010,
+	0x00000008, 0x0004003d, 0x0000000e, 0x00000046, 0x00000047, 0x0007000c, 0x0000000e, 0x00000049,
+	0x00000048, 0x00000026, 0x00000045, 0x00000046, 0x0003003e, 0x00000036, 0x00000049, 0x0003003e,
+	0x0000004a, 0x0000004c, 0x00050041, 0x0000001f, 0x0000004f, 0x0000002d, 0x0000000c, 0x0004003d,
+	0x0000000d, 0x0000004e, 0x0000004f, 0x0003003e, 0x0000004d, 0x0000004e, 0x000200f9, 0x00000050,
+	0x000200f8, 0x00000050, 0x000400f6, 0x00000054, 0x00000053, 0x00000000, 0x000200f9, 0x00000051,
+	0x000200f8, 0x00000051, 0x0004003d, 0x0000000d, 0x00000055, 0x0000004d, 0x00050041, 0x0000001f,
+	0x00000057, 0x00000036, 0x0000000c, 0x0004003d, 0x0000000d, 0x00000056, 0x00000057, 0x000500b0,
+	0x00000024, 0x00000058, 0x00000055, 0x00000056, 0x000400fa, 0x00000058, 0x00000052, 0x00000054,
+	0x000200f8, 0x00000052, 0x00050041, 0x0000001f, 0x0000005b, 0x0000002d, 0x00000008, 0x0004003d,
+	0x0000000d, 0x0000005a, 0x0000005b, 0x0003003e, 0x00000059, 0x0000005a, 0x000200f9, 0x0000005c,
+	0x000200f8, 0x0000005c, 0x000400f6, 0x00000060, 0x0000005f, 0x00000000, 0x000200f9, 0x0000005d,
+	0x000200f8, 0x0000005d, 0x0004003d, 0x0000000d, 0x00000061, 0x00000059, 0x00050041, 0x0000001f,
+	0x00000063, 0x00000036, 0x00000008, 0x0004003d, 0x0000000d, 0x00000062, 0x00000063, 0x000500b0,
+	0x00000024, 0x00000064, 0x00000061, 0x00000062, 0x000400fa, 0x00000064, 0x0000005e, 0x00000060,
+	0x000200f8, 0x0000005e, 0x0004003d, 0x00000004, 0x00000065, 0x0000004a, 0x0004003d, 0x00000006,
+	0x00000066, 0x00000003, 0x0004003d, 0x0000000d, 0x00000067, 0x00000059, 0x0004003d, 0x0000000d,
+	0x00000068, 0x0000004d, 0x0004007c, 0x00000002, 0x00000069, 0x00000067, 0x0004007c, 0x00000002,
+	0x0000006a, 0x00000068, 0x00050050, 0x0000006c, 0x0000006b, 0x00000069, 0x0000006a, 0x00040064,
+	0x00000005, 0x0000006d, 0x00000066, 0x0007005f, 0x0000006f, 0x0000006e, 0x0000006d, 0x0000006b,
+	0x00000002, 0x00000008, 0x00050051, 0x00000004, 0x00000070, 0x0000006e, 0x00000000, 0x0007000c,
+	0x00000004, 0x00000071, 0x00000048, 0x00000028, 0x00000065, 0x00000070, 0x0003003e, 0x0000004a,
+	0x00000071, 0x000200f9, 0x0000005f, 0x000200f8, 0x0000005f, 0x0004003d, 0x0000000d, 0x00000072,
+	0x00000059, 0x00050080, 0x0000000d, 0x00000073, 0x00000072, 0x00000038, 0x0003003e, 0x00000059,
+	0x00000073, 0x000200f9, 0x0000005c, 0x000200f8, 0x00000060, 0x000200f9, 0x00000053, 0x000200f8,
+	0x00000053, 0x0004003d, 0x0000000d, 0x00000074, 0x0000004d, 0x00050080, 0x0000000d, 0x00000075,
+	0x00000074, 0x00000038, 0x0003003e, 0x0000004d, 0x00000075, 0x000200f9, 0x00000050, 0x000200f8,
+	0x00000054, 0x0004003d, 0x0000000a, 0x00000076, 0x00000009, 0x0004003d, 0x0000000e, 0x00000077,
+	0x00000016, 0x0004007c, 0x0000006c, 0x00000078, 0x00000077, 0x0004003d, 0x00000004, 0x00000079,
+	0x0000004a, 0x00070050, 0x0000006f, 0x0000007a, 0x00000079, 0x00000079, 0x00000079, 0x00000079,
+	0x00040063, 0x00000076, 0x00000078, 0x0000007a, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t OcclusionCullComp_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x00000188, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+	0x00000032, 0x0006000b, 0x0000008c, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e,
+	0x00000000, 0x00000001, 0x0006000f, 0x00000005, 0x0000002f, 0x6e69616d, 0x00000000, 0x0000012c,
+	0x00060010, 0x0000002f, 0x00000011, 0x00000040, 0x00000001, 0x00000001, 0x00030003, 0x00000002,
+	0x000001c2, 0x00050005, 0x00000006, 0x6c6c7543, 0x656a624f, 0x00007463, 0x00060006, 0x00000006,
+	0x00000000, 0x6e756f62, 0x694d7364, 0x0000006e, 0x00060006, 0x00000006, 0x00000001, 0x6e756f62,
+	0x614d7364, 0x00000078, 0x00060006, 0x00000006, 0x00000002, 0x65646e69, 0x756f4378, 0x0000746e,
+	0x00040005, 0x00000008, 0x656a624f, 0x00737463, 0x00050006, 0x00000008, 0x00000000, 0x656a626f,
+	0x00737463, 0x00040005, 0x0000000e, 0x61726150, 0x0000736d, 0x00060006, 0x0000000e, 0x00000000,
+	0x77656976, 0x6a6f7250, 0x00000000, 0x00050006, 0x0000000e, 0x00000001, 0x6e756f63, 0x00007374,
+	0x00040005, 0x0000000f, 0x61726170, 0x0000736d, 0x00050005, 0x00000013, 0x69736956, 0x696c6962,
+	0x00007974, 0x00050006, 0x00000013, 0x00000000, 0x69736976, 0x00656c62, 0x00050005, 0x00000017,
+	0x77617244, 0x6d6d6f43, 0x00646e61, 0x00060006, 0x00000017, 0x00000000, 0x65646e69, 0x756f4378,
+	0x0000746e, 0x00070006, 0x00000017, 0x00000001, 0x74736e69, 0x65636e61, 0x6e756f43, 0x00000074,
+	0x00060006, 0x00000017, 0x00000002, 0x73726966, 0x646e4974, 0x00007865, 0x00070006, 0x00000017,
+	0x00000003, 0x74726576, 0x664f7865, 0x74657366, 0x00000000, 0x00070006, 0x00000017, 0x00000004,
+	0x73726966, 0x736e4974, 0x636e6174, 0x00000065, 0x00050005, 0x00000019, 0x6c726145, 0x61724479,
+	0x00007377, 0x00060006, 0x00000019, 0x00000000, 0x6c726165, 0x61724479, 0x00007377, 0x00050005,
+	0x0000001d, 0x6574614c, 0x77617244, 0x00000073, 0x00060006, 0x0000001d, 0x00000000, 0x6574616c,
+	0x77617244, 0x00000073, 0x00040005, 0x00000021, 0x74617453, 0x00000073, 0x00050006, 0x00000021,
+	0x00000000, 0x74736574, 0x00006465, 0x00070006, 0x00000021, 0x00000001, 0x73757266, 0x436d7574,
+	0x656c6c75, 0x00000064, 0x00060006, 0x00000021, 0x00000002, 0x6c63636f, 0x64656475, 0x00000000,
+	0x00060006, 0x00000021, 0x00000003, 0x77617264, 0x74614c6e, 0x00000065, 0x00040005, 0x00000022,
+	0x74617473, 0x00000073, 0x00040005, 0x00000025, 0x61727970, 0x0064696d, 0x00040005, 0x0000002a,
+	0x65646f4d, 0x00000000, 0x00050006, 0x0000002a, 0x00000000, 0x6574616c, 0x00000000, 0x00040005,
+	0x0000002b, 0x65646f6d, 0x00000000, 0x00040005, 0x0000002d, 0x77617264, 0x00000000, 0x00040005,
+	0x0000002e, 0x74736574, 0x00000000, 0x00040005, 0x0000002f, 0x6e69616d, 0x00000000, 0x00050005,
+	0x00000030, 0x77617244, 0x6d6d6f43, 0x00646e61, 0x00060006, 0x00000030, 0x00000000, 0x65646e69,
+	0x756f4378, 0x0000746e, 0x00070006, 0x00000030, 0x00000001, 0x74736e69, 0x65636e61, 0x6e756f43,
+	0x00000074, 0x00060006, 0x00000030, 0x00000002, 0x73726966, 0x646e4974, 0x00007865, 0x00070006,
+	0x00000030, 0x00000003, 0x74726576, 0x664f7865, 0x74657366, 0x00000000, 0x00070006, 0x00000030,
+	0x00000004, 0x73726966, 0x736e4974, 0x636e6174, 0x00000065, 0x00050005, 0x00000033, 0x65646e69,
+	0x756f4378, 0x0000746e, 0x00040005, 0x00000034, 0x77617264, 0x0000006e, 0x00050005, 0x00000036,
+	0x65646e69, 0x756f4378, 0x0000746e, 0x00040005, 0x00000038, 0x77617264, 0x0000006e, 0x00050005,
+	0x00000040, 0x6c6c7543, 0x656a624f, 0x00007463, 0x00060006, 0x00000040, 0x00000000, 0x6e756f62,
+	0x694d7364, 0x0000006e, 0x00060006, 0x00000040, 0x00000001, 0x6e756f62, 0x614d7364, 0x00000078,
+	0x00060006, 0x00000040, 0x00000002, 0x65646e69, 0x756f4378, 0x0000746e, 0x00030005, 0x00000042,
+	0x0000006f, 0x00030005, 0x00000044, 0x0000006f, 0x00040005, 0x00000046, 0x4d63646e, 0x00006e69,
+	0x00040005, 0x0000004b, 0x4d63646e, 0x00007861, 0x00040005, 0x0000004e, 0x6e726f63, 0x00007265,
+	0x00030005, 0x00000058, 0x00000070, 0x00040005, 0x00000073, 0x70696c63, 0x00000000, 0x00030005,
+	0x00000083, 0x0063646e, 0x00040005, 0x000000ad, 0x657a6973, 0x00000000, 0x00040005, 0x000000b6,
+	0x694d7675, 0x0000006e, 0x00040005, 0x000000c0, 0x614d7675, 0x00000078, 0x00040005, 0x000000c6,
+	0x65747865, 0x0000746e, 0x00040005, 0x000000cc, 0x6576656c, 0x0000006c, 0x00050005, 0x000000dd,
+	0x6576656c, 0x7a69536c, 0x00000065, 0x00040005, 0x000000e5, 0x73726966, 0x00000074, 0x00040005,
+	0x000000f0, 0x7473616c, 0x00000000, 0x00050005, 0x000000f9, 0x74726166, 0x74736568, 0x00000000,
+	0x00030005, 0x0000012b, 0x00000069, 0x00080005, 0x0000012c, 0x475f6c67, 0x61626f6c, 0x766e496c,
+	0x7461636f, 0x496e6f69, 0x00000044, 0x00030005, 0x00000138, 0x0000006f, 0x00040005, 0x00000157,
+	0x75736572, 0x0000746c, 0x00050005, 0x0000015a, 0x77617264, 0x6574614c, 0x00000000, 0x00050048,
+	0x00000006, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000006, 0x00000001, 0x00000023,
+	0x00000010, 0x00050048, 0x00000006, 0x00000002, 0x00000023, 0x00000020, 0x00040047, 0x00000007,
+	0x00000006, 0x00000030, 0x00050048, 0x00000008, 0x00000000, 0x00000023, 0x00000000, 0x00030047,
+	0x00000008, 0x00000003, 0x00040048, 0x00000008, 0x00000000, 0x00000018, 0x00040047, 0x00000009,
+	0x00000022, 0x00000000, 0x00040047, 0x00000009, 0x00000021, 0x00000000, 0x00050048, 0x0000000e,
+	0x00000000, 0x00000023, 0x00000000, 0x00040048, 0x0000000e, 0x00000000, 0x00000005, 0x00050048,
+	0x0000000e, 0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x0000000e, 0x00000001, 0x00000023,
+	0x00000040, 0x00030047, 0x0000000e, 0x00000002, 0x00040047, 0x0000000f, 0x00000022, 0x00000000,
+	0x00040047, 0x0000000f, 0x00000021, 0x00000001, 0x00040047, 0x00000012, 0x00000006, 0x00000004,
+	0x00050048, 0x00000013, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000013, 0x00000003,
+	0x00040047, 0x00000014, 0x00000022, 0x00000000, 0x00040047, 0x00000014, 0x00000021, 0x00000002,
+	0x00050048, 0x00000017, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000017, 0x00000001,
+	0x00000023, 0x00000004, 0x00050048, 0x00000017, 0x00000002, 0x00000023, 0x00000008, 0x00050048,
+	0x00000017, 0x00000003, 0x00000023, 0x0000000c, 0x00050048, 0x00000017, 0x00000004, 0x00000023,
+	0x00000010, 0x00040047, 0x00000018, 0x00000006, 0x00000014, 0x00050048, 0x00000019, 0x00000000,
+	0x00000023, 0x00000000, 0x00030047, 0x00000019, 0x00000003, 0x00040048, 0x00000019, 0x00000000,
+	0x00000019, 0x00040047, 0x0000001a, 0x00000022, 0x00000000, 0x00040047, 0x0000001a, 0x00000021,
+	0x00000003, 0x00050048, 0x0000001d, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x0000001d,
+	0x00000003, 0x00040048, 0x0000001d, 0x00000000, 0x00000019, 0x00040047, 0x0000001e, 0x00000022,
+	0x00000000, 0x00040047, 0x0000001e, 0x00000021, 0x00000004, 0x00050048, 0x00000021, 0x00000000,
+	0x00000023, 0x00000000, 0x00050048, 0x00000021, 0x00000001, 0x00000023, 0x00000004, 0x00050048,
+	0x00000021, 0x00000002, 0x00000023, 0x00000008, 0x00050048, 0x00000021, 0x00000003, 0x00000023,
+	0x0000000c, 0x00030047, 0x00000021, 0x00000003, 0x00040047, 0x00000022, 0x00000022, 0x00000000,
+	0x00040047, 0x00000022, 0x00000021, 0x00000005, 0x00040047, 0x00000025, 0x00000022, 0x00000000,
+	0x00040047, 0x00000025, 0x00000021, 0x00000006, 0x00050048, 0x0000002a, 0x00000000, 0x00000023,
+	0x00000000, 0x00030047, 0x0000002a, 0x00000002, 0x00040047, 0x0000012c, 0x0000000b, 0x0000001c,
+	0x00040015, 0x00000002, 0x00000020, 0x00000001, 0x0004002b, 0x00000002, 0x00000001, 0x00000040,
+	0x00030016, 0x00000003, 0x00000020, 0x00040017, 0x00000004, 0x00000003, 0x00000004, 0x00040015,
+	0x00000005, 0x00000020, 0x00000000, 0x0005001e, 0x00000006, 0x00000004, 0x00000004, 0x00000005,
+	0x0003001d, 0x00000007, 0x00000006, 0x0003001e, 0x00000008, 0x00000007, 0x00040020, 0x0000000a,
+	0x00000002, 0x00000008, 0x0004003b, 0x0000000a, 0x00000009, 0x00000002, 0x0004002b, 0x00000002,
+	0x0000000b, 0x00000000, 0x00040018, 0x0000000c, 0x00000004, 0x00000004, 0x00040017, 0x0000000d,
+	0x00000005, 0x00000004, 0x0004001e, 0x0000000e, 0x0000000c, 0x0000000d, 0x00040020, 0x00000010,
+	0x00000002, 0x0000000e, 0x0004003b, 0x00000010, 0x0000000f, 0x00000002, 0x0004002b, 0x00000002,
+	0x00000011, 0x00000001, 0x0003001d, 0x00000012, 0x00000005, 0x0003001e, 0x00000013, 0x00000012,
+	0x00040020, 0x00000015, 0x00000002, 0x00000013, 0x0004003b, 0x00000015, 0x00000014, 0x00000002,
+	0x0004002b, 0x00000002, 0x00000016, 0x00000002, 0x0007001e, 0x00000017, 0x00000005, 0x00000005,
+	0x00000005, 0x00000002, 0x00000005, 0x0003001d, 0x00000018, 0x00000017, 0x0003001e, 0x00000019,
+	0x00000018, 0x00040020, 0x0000001b, 0x00000002, 0x00000019, 0x0004003b, 0x0000001b, 0x0000001a,
+	0x00000002, 0x0004002b, 0x00000002, 0x0000001c, 0x00000003, 0x0003001e, 0x0000001d, 0x00000018,
+	0x00040020, 0x0000001f, 0x00000002, 0x0000001d, 0x0004003b, 0x0000001f, 0x0000001e, 0x00000002,
+	0x0004002b, 0x00000002, 0x00000020, 0x00000004, 0x0006001e, 0x00000021, 0x00000005, 0x00000005,
+	0x00000005, 0x00000005, 0x00040020, 0x00000023, 0x00000002, 0x00000021, 0x0004003b, 0x00000023,
+	0x00000022, 0x00000002, 0x0004002b, 0x00000002, 0x00000024, 0x00000005, 0x00090019, 0x00000026,
+	0x00000003, 0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x0003001b,
+	0x00000027, 0x00000026, 0x00040020, 0x00000028, 0x00000000, 0x00000027, 0x0004003b, 0x00000028,
+	0x00000025, 0x00000000, 0x0004002b, 0x00000002, 0x00000029, 0x00000006, 0x0003001e, 0x0000002a,
+	0x00000005, 0x00040020, 0x0000002c, 0x00000009, 0x0000002a, 0x0004003b, 0x0000002c, 0x0000002b,
+	0x00000009, 0x0007001e, 0x00000030, 0x00000005, 0x00000005, 0x00000005, 0x00000002, 0x00000005,
+	0x00020014, 0x00000031, 0x00050021, 0x00000032, 0x00000030, 0x00000005, 0x00000031, 0x00040020,
+	0x00000037, 0x00000007, 0x00000005, 0x00040020, 0x00000039, 0x00000007, 0x00000031, 0x0004002b,
+	0x00000005, 0x0000003e, 0x00000000, 0x0005001e, 0x00000040, 0x00000004, 0x00000004, 0x00000005,
+	0x00040021, 0x00000041, 0x00000005, 0x00000040, 0x00040020, 0x00000045, 0x00000007, 0x00000040,
+	0x00040017, 0x00000047, 0x00000003, 0x00000003, 0x00040020, 0x00000048, 0x00000007, 0x00000047,
+	0x0004002b, 0x00000003, 0x00000049, 0x7149f2ca, 0x0006002c, 0x00000047, 0x0000004a, 0x00000049,
+	0x00000049, 0x00000049, 0x0004002b, 0x00000003, 0x0000004c, 0xf149f2ca, 0x0006002c, 0x00000047,
+	0x0000004d, 0x0000004c, 0x0000004c, 0x0000004c, 0x00040020, 0x0000004f, 0x00000007, 0x00000002,
+	0x0004002b, 0x00000002, 0x00000056, 0x00000008, 0x00040020, 0x0000005e, 0x00000007, 0x00000003,
+	0x00040020, 0x00000074, 0x00000007, 0x00000004, 0x00040020, 0x00000077, 0x00000002, 0x0000000c,
+	0x0004002b, 0x00000003, 0x00000079, 0x3f800000, 0x0004002b, 0x00000003, 0x0000007e, 0x00000000,
+	0x0004002b, 0x00000005, 0x00000082, 0x00000002, 0x0004002b, 0x00000003, 0x00000095, 0xbf800000,
+	0x00040017, 0x000000ae, 0x00000003, 0x00000002, 0x00040020, 0x000000af, 0x00000007, 0x000000ae,
+	0x00040020, 0x000000b2, 0x00000002, 0x0000000d, 0x00040017, 0x000000b4, 0x00000005, 0x00000002,
+	0x0004002b, 0x00000003, 0x000000b9, 0x3f000000, 0x0005002c, 0x000000ae, 0x000000bb, 0x000000b9,
+	0x000000b9, 0x0005002c, 0x000000ae, 0x000000bd, 0x0000007e, 0x0000007e, 0x0005002c, 0x000000ae,
+	0x000000be, 0x00000079, 0x00000079, 0x00040020, 0x000000d7, 0x00000002, 0x00000005, 0x0004002b,
+	0x00000005, 0x000000d8, 0x00000001, 0x00040017, 0x000000de, 0x00000002, 0x00000002, 0x00040020,
+	0x000000df, 0x00000007, 0x000000de, 0x0005002c, 0x000000de, 0x000000eb, 0x0000000b, 0x0000000b,
+	0x0005002c, 0x000000de, 0x000000ed, 0x00000011, 0x00000011, 0x00020013, 0x00000128, 0x00030021,
+	0x00000129, 0x00000128, 0x00040017, 0x0000012d, 0x00000005, 0x00000003, 0x00040020, 0x0000012e,
+	0x00000001, 0x0000012d, 0x0004003b, 0x0000012e, 0x0000012c, 0x00000001, 0x00040020, 0x00000131,
+	0x00000001, 0x00000005, 0x00040020, 0x0000013c, 0x00000002, 0x00000006, 0x00040020, 0x00000143,
+	0x00000009, 0x00000005, 0x00040020, 0x00000156, 0x00000002, 0x00000017, 0x00050036, 0x00000030,
+	0x0000002d, 0x00000000, 0x00000032, 0x00030037, 0x00000005, 0x00000033, 0x00030037, 0x00000031,
+	0x00000034, 0x000200f8, 0x00000035, 0x0004003b, 0x00000037, 0x00000036, 0x00000007, 0x0004003b,
+	0x00000039, 0x00000038, 0x00000007, 0x0003003e, 0x00000036, 0x00000033, 0x0003003e, 0x00000038,
+	0x00000034, 0x0004003d, 0x00000005, 0x0000003a, 0x00000036, 0x0004003d, 0x00000031, 0x0000003b,
+	0x00000038, 0x000600a9, 0x00000002, 0x0000003c, 0x0000003b, 0x00000011, 0x0000000b, 0x0004007c,
+	0x00000005, 0x0000003d, 0x0000003c, 0x00080050, 0x00000030, 0x0000003f, 0x0000003a, 0x0000003d,
+	0x0000003e, 0x0000000b, 0x0000003e, 0x000200fe, 0x0000003f, 0x00010038, 0x00050036, 0x00000005,
+	0x0000002e, 0x00000000, 0x00000041, 0x00030037, 0x00000040, 0x00000042, 0x000200f8, 0x00000043,
+	0x0004003b, 0x00000045, 0x00000044, 0x00000007, 0x0004003b, 0x00000048, 0x00000046, 0x00000007,
+	0x0004003b, 0x00000048, 0x0000004b, 0x00000007, 0x0004003b, 0x0000004f, 0x0000004e, 0x00000007,
+	0x0004003b, 0x00000048, 0x00000058, 0x00000007, 0x0004003b, 0x00000074, 0x00000073, 0x00000007,
+	0x0004003b, 0x00000048, 0x00000083, 0x00000007, 0x0004003b, 0x000000af, 0x000000ad, 0x00000007,
+	0x0004003b, 0x000000af, 0x000000b6, 0x00000007, 0x0004003b, 0x000000af, 0x000000c0, 0x00000007,
+	0x0004003b, 0x000000af, 0x000000c6, 0x00000007, 0x0004003b, 0x00000037, 0x000000cc, 0x00000007,
+	0x0004003b, 0x000000df, 0x000000dd, 0x00000007, 0x0004003b, 0x000000df, 0x000000e5, 0x00000007,
+	0x0004003b, 0x000000df, 0x000000f0, 0x00000007, 0x0004003b, 0x0000005e, 0x000000f9, 0x00000007,
+	0x0003003e, 0x00000044, 0x00000042, 0x0003003e, 0x00000046, 0x0000004a, 0x0003003e, 0x0000004b,
+	0x0000004d, 0x0003003e, 0x0000004e, 0x0000000b, 0x000200f9, 0x00000050, 0x000200f8, 0x00000050,
+	0x000400f6, 0x00000054, 0x00000053, 0x00000000, 0x000200f9, 0x00000051, 0x000200f8, 0x00000051,
+	0x0004003d, 0x00000002, 0x00000055, 0x0000004e, 0x000500b1, 0x00000031, 0x00000057, 0x00000055,
+	0x00000056, 0x000400fa, 0x00000057, 0x00000052, 0x00000054, 0x000200f8, 0x00000052, 0x0004003d,
+	0x00000002, 0x00000059, 0x0000004e, 0x000500c7, 0x00000002, 0x0000005a, 0x00000059, 0x00000011,
+	0x000500ab, 0x00000031, 0x0000005b, 0x0000005a, 0x0000000b, 0x00060041, 0x0000005e, 0x0000005d,
+	0x00000044, 0x00000011, 0x0000000b, 0x0004003d, 0x00000003, 0x0000005c, 0x0000005d, 0x00060041,
+	0x0000005e, 0x00000060, 0x00000044, 0x0000000b, 0x0000000b, 0x0004003d, 0x00000003, 0x0000005f,
+	0x00000060, 0x000600a9, 0x00000003, 0x00000061, 0x0000005b, 0x0000005c, 0x0000005f, 0x0004003d,
+	0x00000002, 0x00000062, 0x0000004e, 0x000500c7, 0x00000002, 0x00000063, 0x00000062, 0x00000016,
+	0x000500ab, 0x00000031, 0x00000064, 0x00000063, 0x0000000b, 0x00060041, 0x0000005e, 0x00000066,
+	0x00000044, 0x00000011, 0x00000011, 0x0004003d, 0x00000003, 0x00000065, 0x00000066, 0x00060041,
+	0x0000005e, 0x00000068, 0x00000044, 0x0000000b, 0x00000011, 0x0004003d, 0x00000003, 0x00000067,
+	0x00000068, 0x000600a9, 0x00000003, 0x00000069, 0x00000064, 0x00000065, 0x00000067, 0x0004003d,
+	0x00000002, 0x0000006a, 0x0000004e, 0x000500c7, 0x00000002, 0x0000006b, 0x0000006a, 0x00000020,
+	0x000500ab, 0x00000031, 0x0000006c, 0x0000006b, 0x0000000b, 0x00060041, 0x0000005e, 0x0000006e,
+	0x00000044, 0x00000011, 0x00000016, 0x0004003d, 0x00000003, 0x0000006d, 0x0000006e, 0x00060041,
+	0x0000005e, 0x00000070, 0x00000044, 0x0000000b, 0x00000016, 0x0004003d, 0x00000003, 0x0000006f,
+	0x00000070, 0x000600a9, 0x00000003, 0x00000071, 0x0000006c, 0x0000006d, 0x0000006f, 0x00060050,
+	0x00000047, 0x00000072, 0x00000061, 0x00000069, 0x00000071, 0x0003003e, 0x00000058, 0x00000072,
+	0x00050041, 0x00000077, 0x00000076, 0x0000000f, 0x0000000b, 0x0004003d, 0x0000000c, 0x00000075,
+	0x00000076, 0x0004003d, 0x00000047, 0x00000078, 0x00000058, 0x00050050, 0x00000004, 0x0000007a,
+	0x00000078, 0x00000079, 0x00050091, 0x00000004, 0x0000007b, 0x00000075, 0x0000007a, 0x0003003e,
+	0x00000073, 0x0000007b, 0x00050041, 0x0000005e, 0x0000007d, 0x00000073, 0x0000001c, 0x0004003d,
+	0x00000003, 0x0000007c, 0x0000007d, 0x000500bc, 0x00000031, 0x0000007f, 0x0000007c, 0x0000007e,
+	0x000300f7, 0x00000081, 0x00000000, 0x000400fa, 0x0000007f, 0x00000080, 0x00000081, 0x000200f8,
+	0x00000080, 0x000200fe, 0x00000082, 0x000200f8, 0x00000081, 0x0004003d, 0x00000004, 0x00000084,
+	0x00000073, 0x0008004f, 0x00000047, 0x00000085, 0x00000084, 0x00000084, 0x00000000, 0x00000001,
+	0x00000002, 0x00050041, 0x0000005e, 0x00000087, 0x00000073, 0x0000001c, 0x0004003d, 0x00000003,
+	0x00000086, 0x00000087, 0x00060050, 0x00000047, 0x00000088, 0x00000086, 0x00000086, 0x00000086,
+	0x00050088, 0x00000047, 0x00000089, 0x00000085, 0x00000088, 0x0003003e, 0x00000083, 0x00000089,
+	0x0004003d, 0x00000047, 0x0000008a, 0x00000046, 0x0004003d, 0x00000047, 0x0000008b, 0x00000083,
+	0x0007000c, 0x00000047, 0x0000008d, 0x0000008c, 0x00000025, 0x0000008a, 0x0000008b, 0x0003003e,
+	0x00000046, 0x0000008d, 0x0004003d, 0x00000047, 0x0000008e, 0x0000004b, 0x0004003d, 0x00000047,
+	0x0000008f, 0x00000083, 0x0007000c, 0x00000047, 0x00000090, 0x0000008c, 0x00000028, 0x0000008e,
+	0x0000008f, 0x0003003e, 0x0000004b, 0x00000090, 0x000200f9, 0x00000053, 0x000200f8, 0x00000053,
+	0x0004003d, 0x00000002, 0x00000091, 0x0000004e, 0x00050080, 0x00000002, 0x00000092, 0x00000091,
+	0x00000011, 0x0003003e, 0x0000004e, 0x00000092, 0x000200f9, 0x00000050, 0x000200f8, 0x00000054,
+	0x00050041, 0x0000005e, 0x00000094, 0x0000004b, 0x0000000b, 0x0004003d, 0x00000003, 0x00000093,
+	0x00000094, 0x000500b8, 0x00000031, 0x00000096, 0x00000093, 0x00000095, 0x00050041, 0x0000005e,
+	0x00000098, 0x00000046, 0x0000000b, 0x0004003d, 0x00000003, 0x00000097, 0x00000098, 0x000500ba,
+	0x00000031, 0x00000099, 0x00000097, 0x00000079, 0x000500a6, 0x00000031, 0x0000009a, 0x00000096,
+	0x00000099, 0x00050041, 0x0000005e, 0x0000009c, 0x0000004b, 0x00000011, 0x0004003d, 0x00000003,
+	0x0000009b, 0x0000009c, 0x000500b8, 0x00000031, 0x0000009d, 0x0000009b, 0x00000095, 0x000500a6,
+	0x00000031, 0x0000009e, 0x0000009a, 0x0000009d, 0x00050041, 0x0000005e, 0x000000a0, 0x00000046,
+	0x00000011, 0x0004003d, 0x00000003, 0x0000009f, 0x000000a0, 0x000500ba, 0x00000031, 0x000000a1,
+	0x0000009f, 0x00000079, 0x000500a6, 0x00000031, 0x000000a2, 0x0000009e, 0x000000a1, 0x00050041,
+	0x0000005e, 0x000000a4, 0x00000046, 0x00000016, 0x0004003d, 0x00000003, 0x000000a3, 0x000000a4,
+	0x000500ba, 0x00000031, 0x000000a5, 0x000000a3, 0x00000079, 0x000500a6, 0x00000031, 0x000000a6,
+	0x000000a2, 0x000000a5, 0x00050041, 0x0000005e, 0x000000a8, 0x0000004b, 0x00000016, 0x0004003d,
+	0x00000003, 0x000000a7, 0x000000a8, 0x000500b8, 0x00000031, 0x000000a9, 0x000000a7, 0x0000007e,
+	0x000500a6, 0x00000031, 0x000000aa, 0x000000a6, 0x000000a9, 0x000300f7, 0x000000ac, 0x00000000,
+	0x000400fa, 0x000000aa, 0x000000ab, 0x000000ac, 0x000200f8, 0x000000ab, 0x000200fe, 0x0000003e,
+	0x000200f8, 0x000000ac, 0x00050041, 0x000000b2, 0x000000b1, 0x0000000f, 0x00000011, 0x0004003d,
+	0x0000000d, 0x000000b0, 0x000000b1, 0x0007004f, 0x000000b4, 0x000000b3, 0x000000b0, 0x000000b0,
+	0x00000001, 0x00000002, 0x00040070, 0x000000ae, 0x000000b5, 0x000000b3, 0x0003003e, 0x000000ad,
+	0x000000b5, 0x0004003d, 0x00000047, 0x000000b7, 0x00000046, 0x0007004f, 0x000000ae, 0x000000b8,
+	0x000000b7, 0x000000b7, 0x00000000, 0x00000001, 0x0005008e, 0x000000ae, 0x000000ba, 0x000000b8,
+	0x000000b9, 0x00050081, 0x000000ae, 0x000000bc, 0x000000ba, 0x000000bb, 0x0008000c, 0x000000ae,
+	0x000000bf, 0x0000008c, 0x0000002b, 0x000000bc, 0x000000bd, 0x000000be, 0x0003003e, 0x000000b6,
+	0x000000bf, 0x0004003d, 0x00000047, 0x000000c1, 0x0000004b, 0x0007004f, 0x000000ae, 0x000000c2,
+	0x000000c1, 0x000000c1, 0x00000000, 0x00000001, 0x0005008e, 0x000000ae, 0x000000c3, 0x000000c2,
+	0x000000b9, 0x00050081, 0x000000ae, 0x000000c4, 0x000000c3, 0x000000bb, 0x0008000c, 0x000000ae,
+	0x000000c5, 0x0000008c, 0x0000002b, 0x000000c4, 0x000000bd, 0x000000be, 0x0003003e, 0x000000c0,
+	0x000000c5, 0x0004003d, 0x000000ae, 0x000000c7, 0x000000c0, 0x0004003d, 0x000000ae, 0x000000c8,
+	0x000000b6, 0x00050083, 0x000000ae, 0x000000c9, 0x000000c7, 0x000000c8, 0x0004003d, 0x000000ae,
+	0x000000ca, 0x000000ad, 0x00050085, 0x000000ae, 0x000000cb, 0x000000c9, 0x000000ca, 0x0003003e,
+	0x000000c6, 0x000000cb, 0x00050041, 0x0000005e, 0x000000ce, 0x000000c6, 0x0000000b, 0x0004003d,
+	0x00000003, 0x000000cd, 0x000000ce, 0x00050041, 0x0000005e, 0x000000d0, 0x000000c6, 0x00000011,
+	0x0004003d, 0x00000003, 0x000000cf, 0x000000d0, 0x0007000c, 0x00000003, 0x000000d1, 0x0000008c,
+	0x00000028, 0x000000cd, 0x000000cf, 0x0007000c, 0x00000003, 0x000000d2, 0x0000008c, 0x00000028,
+	0x000000d1, 0x00000079, 0x0006000c, 0x00000003, 0x000000d3, 0x0000008c, 0x0000001e, 0x000000d2,
+	0x0006000c, 0x00000003, 0x000000d4, 0x0000008c, 0x00000009, 0x000000d3, 0x00060041, 0x000000d7,
+	0x000000d6, 0x0000000f, 0x00000011, 0x0000001c, 0x0004003d, 0x00000005, 0x000000d5, 0x000000d6,
+	0x00050082, 0x00000005, 0x000000d9, 0x000000d5, 0x000000d8, 0x00040070, 0x00000003, 0x000000da,
+	0x000000d9, 0x0008000c, 0x00000003, 0x000000db, 0x0000008c, 0x0000002b, 0x000000d4, 0x0000007e,
+	0x000000da, 0x0004006d, 0x00000005, 0x000000dc, 0x000000db, 0x0003003e, 0x000000cc, 0x000000dc,
+	0x0004003d, 0x00000027, 0x000000e0, 0x00000025, 0x0004003d, 0x00000005, 0x000000e1, 0x000000cc,
+	0x0004007c, 0x00000002, 0x000000e2, 0x000000e1, 0x00040064, 0x00000026, 0x000000e3, 0x000000e0,
+	0x00050067, 0x000000de, 0x000000e4, 0x000000e3, 0x000000e2, 0x0003003e, 0x000000dd, 0x000000e4,
+	0x0004003d, 0x000000ae, 0x000000e6, 0x000000b6, 0x0004003d, 0x000000de, 0x000000e7, 0x000000dd,
+	0x0004006f, 0x000000ae, 0x000000e8, 0x000000e7, 0x00050085, 0x000000ae, 0x000000e9, 0x000000e6,
+	0x000000e8, 0x0004006e, 0x000000de, 0x000000ea, 0x000000e9, 0x0004003d, 0x000000de, 0x000000ec,
+	0x000000dd, 0x00050082, 0x000000de, 0x000000ee, 0x000000ec, 0x000000ed, 0x0008000c, 0x000000de,
+	0x000000ef, 0x0000008c, 0x0000002d, 0x000000ea, 0x000000eb, 0x000000ee, 0x0003003e, 0x000000e5,
+	0x000000ef, 0x0004003d, 0x000000ae, 0x000000f1, 0x000000c0, 0x0004003d, 0x000000de, 0x000000f2,
+	0x000000dd, 0x0004006f, 0x000000ae, 0x000000f3, 0x000000f2, 0x00050085, 0x000000ae, 0x000000f4,
+	0x000000f1, 0x000000f3, 0x0004006e, 0x000000de, 0x000000f5, 0x000000f4, 0x0004003d, 0x000000de,
+	0x000000f6, 0x000000dd, 0x00050082, 0x000000de, 0x000000f7, 0x000000f6, 0x000000ed, 0x0008000c,
+	0x000000de, 0x000000f8, 0x0000008c, 0x0000002d, 0x000000f5, 0x000000eb, 0x000000f7, 0x0003003e,
+	0x000000f0, 0x000000f8, 0x0004003d, 0x00000027, 0x000000fa, 0x00000025, 0x0004003d, 0x000000de,
+	0x000000fb, 0x000000e5, 0x0004003d, 0x00000005, 0x000000fc, 0x000000cc, 0x0004007c, 0x00000002,
+	0x000000fd, 0x000000fc, 0x00040064, 0x00000026, 0x000000fe, 0x000000fa, 0x0007005f, 0x00000004,
+	0x000000ff, 0x000000fe, 0x000000fb, 0x00000002, 0x000000fd, 0x00050051, 0x00000003, 0x00000100,
+	0x000000ff, 0x00000000, 0x0004003d, 0x00000027, 0x00000101, 0x00000025, 0x00050041, 0x0000004f,
+	0x00000103, 0x000000f0, 0x0000000b, 0x0004003d, 0x00000002, 0x00000102, 0x00000103, 0x00050041,
+	0x0000004f, 0x00000105, 0x000000e5, 0x00000011, 0x0004003d, 0x00000002, 0x00000104, 0x00000105,
+	0x00050050, 0x000000de, 0x00000106, 0x00000102, 0x00000104, 0x0004003d, 0x00000005, 0x00000107,
+	0x000000cc, 0x0004007c, 0x00000002, 0x00000108, 0x00000107, 0x00040064, 0x00000026, 0x00000109,
+	0x00000101, 0x0007005f, 0x00000004, 0x0000010a, 0x00000109, 0x00000106, 0x00000002, 0x00000108,
+	0x00050051, 0x00000003, 0x0000010b, 0x0000010a, 0x00000000, 0x0007000c, 0x00000003, 0x0000010c,
+	0x0000008c, 0x00000028, 0x00000100, 0x0000010b, 0x0004003d, 0x00000027, 0x0000010d, 0x00000025,
+	0x00050041, 0x0000004f, 0x0000010f, 0x000000e5, 0x0000000b, 0x0004003d, 0x00000002, 0x0000010e,
+	0x0000010f, 0x00050041, 0x0000004f, 0x00000111, 0x000000f0, 0x00000011, 0x0004003d, 0x00000002,
+	0x00000110, 0x00000111, 0x00050050, 0x000000de, 0x00000112, 0x0000010e, 0x00000110, 0x0004003d,
+	0x00000005, 0x00000113, 0x000000cc, 0x0004007c, 0x00000002, 0x00000114, 0x00000113, 0x00040064,
+	0x00000026, 0x00000115, 0x0000010d, 0x0007005f, 0x00000004, 0x00000116, 0x00000115, 0x00000112,
+	0x00000002, 0x00000114, 0x00050051, 0x00000003, 0x00000117, 0x00000116, 0x00000000, 0x0004003d,
+	0x00000027, 0x00000118, 0x00000025, 0x0004003d, 0x000000de, 0x00000119, 0x000000f0, 0x0004003d,
+	0x00000005, 0x0000011a, 0x000000cc, 0x0004007c, 0x00000002, 0x0000011b, 0x0000011a, 0x00040064,
+	0x00000026, 0x0000011c, 0x00000118, 0x0007005f, 0x00000004, 0x0000011d, 0x0000011c, 0x00000119,
+	0x00000002, 0x0000011b, 0x00050051, 0x00000003, 0x0000011e, 0x0000011d, 0x00000000, 0x0007000c,
+	0x00000003, 0x0000011f, 0x0000008c, 0x00000028, 0x00000117, 0x0000011e, 0x0007000c, 0x00000003,
+	0x00000120, 0x0000008c, 0x00000028, 0x0000010c, 0x0000011f, 0x0003003e, 0x000000f9, 0x00000120,
+	0x00050041, 0x0000005e, 0x00000122, 0x00000046, 0x00000016, 0x0004003d, 0x00000003, 0x00000121,
+	0x00000122, 0x0007000c, 0x00000003, 0x00000123, 0x0000008c, 0x00000028, 0x00000121, 0x0000007e,
+	0x0004003d, 0x00000003, 0x00000124, 0x000000f9, 0x000500bc, 0x00000031, 0x00000125, 0x00000123,
+	0x00000124, 0x000600a9, 0x00000002, 0x00000126, 0x00000125, 0x00000016, 0x00000011, 0x0004007c,
+	0x00000005, 0x00000127, 0x00000126, 0x000200fe, 0x00000127, 0x00010038, 0x00050036, 0x00000128,
+	0x0000002f, 0x00000000, 0x00000129, 0x000200f8, 0x0000012a, 0x0004003b, 0x00000037, 0x0000012b,
+	0x00000007, 0x0004003b, 0x00000045, 0x00000138, 0x00000007, 0x0004003b, 0x00000037, 0x00000157,
+	0x00000007, 0x0004003b, 0x00000039, 0x0000015a, 0x00000007, 0x00050041, 0x00000131, 0x00000130,
+	0x0000012c, 0x0000000b, 0x0004003d, 0x00000005, 0x0000012f, 0x00000130, 0x0003003e, 0x0000012b,
+	0x0000012f, 0x0004003d, 0x00000005, 0x00000132, 0x0000012b, 0x00060041, 0x000000d7, 0x00000134,
+	0x0000000f, 0x00000011, 0x0000000b, 0x0004003d, 0x00000005, 0x00000133, 0x00000134, 0x000500ae,
+	0x00000031, 0x00000135, 0x00000132, 0x00000133, 0x000300f7, 0x00000137, 0x00000000, 0x000400fa,
+	0x00000135, 0x00000136, 0x00000137, 0x000200f8, 0x00000136, 0x000100fd, 0x000200f8, 0x00000137,
+	0x0004003d, 0x00000005, 0x00000139, 0x0000012b, 0x00060041, 0x0000013c, 0x0000013b, 0x00000009,
+	0x0000000b, 0x00000139, 0x0004003d, 0x00000006, 0x0000013a, 0x0000013b, 0x00050051, 0x00000004,
+	0x0000013d, 0x0000013a, 0x00000000, 0x00050051, 0x00000004, 0x0000013e, 0x0000013a, 0x00000001,
+	0x00050051, 0x00000005, 0x0000013f, 0x0000013a, 0x00000002, 0x00060050, 0x00000040, 0x00000140,
+	0x0000013d, 0x0000013e, 0x0000013f, 0x0003003e, 0x00000138, 0x00000140, 0x00050041, 0x00000143,
+	0x00000142, 0x0000002b, 0x0000000b, 0x0004003d, 0x00000005, 0x00000141, 0x00000142, 0x000500aa,
+	0x00000031, 0x00000144, 0x00000141, 0x0000003e, 0x000300f7, 0x00000146, 0x00000000, 0x000400fa,
+	0x00000144, 0x00000145, 0x00000146, 0x000200f8, 0x00000145, 0x0004003d, 0x00000005, 0x00000147,
+	0x0000012b, 0x00050041, 0x00000037, 0x00000149, 0x00000138, 0x00000016, 0x0004003d, 0x00000005,
+	0x00000148, 0x00000149, 0x0004003d, 0x00000005, 0x0000014a, 0x0000012b, 0x00060041, 0x000000d7,
+	0x0000014c, 0x00000014, 0x0000000b, 0x0000014a, 0x0004003d, 0x00000005, 0x0000014b, 0x0000014c,
+	0x000500ab, 0x00000031, 0x0000014d, 0x0000014b, 0x0000003e, 0x00060039, 0x00000030, 0x0000014e,
+	0x0000002d, 0x00000148, 0x0000014d, 0x00050051, 0x00000005, 0x0000014f, 0x0000014e, 0x00000000,
+	0x00050051, 0x00000005, 0x00000150, 0x0000014e, 0x00000001, 0x00050051, 0x00000005, 0x00000151,
+	0x0000014e, 0x00000002, 0x00050051, 0x00000002, 0x00000152, 0x0000014e, 0x00000003, 0x00050051,
+	0x00000005, 0x00000153, 0x0000014e, 0x00000004, 0x00080050, 0x00000017, 0x00000154, 0x0000014f,
+	0x00000150, 0x00000151, 0x00000152, 0x00000153, 0x00060041, 0x00000156, 0x00000155, 0x0000001a,
+	0x0000000b, 0x00000147, 0x0003003e, 0x00000155, 0x00000154, 0x000100fd, 0x000200f8, 0x00000146,
+	0x0004003d, 0x00000040, 0x00000158, 0x00000138, 0x00050039, 0x00000005, 0x00000159, 0x0000002e,
+	0x00000158, 0x0003003e, 0x00000157, 0x00000159, 0x0004003d, 0x00000005, 0x0000015b, 0x00000157,
+	0x000500aa, 0x00000031, 0x0000015c, 0x0000015b, 0x00000082, 0x0004003d, 0x00000005, 0x0000015d,
+	0x0000012b, 0x00060041, 0x000000d7, 0x0000015f, 0x00000014, 0x0000000b, 0x0000015d, 0x0004003d,
+	0x00000005, 0x0000015e, 0x0000015f, 0x000500aa, 0x00000031, 0x00000160, 0x0000015e, 0x0000003e,
+	0x000500a7, 0x00000031, 0x00000161, 0x0000015c, 0x00000160, 0x0003003e, 0x0000015a, 0x00000161,
+	0x0004003d, 0x00000005, 0x00000162, 0x0000012b, 0x00050041, 0x00000037, 0x00000164, 0x00000138,
+	0x00000016, 0x0004003d, 0x00000005, 0x00000163, 0x00000164, 0x0004003d, 0x00000031, 0x00000165,
+	0x0000015a, 0x00060039, 0x00000030, 0x00000166, 0x0000002d, 0x00000163, 0x00000165, 0x00050051,
+	0x00000005, 0x00000167, 0x00000166, 0x00000000, 0x00050051, 0x00000005, 0x00000168, 0x00000166,
+	0x00000001, 0x00050051, 0x00000005, 0x00000169, 0x00000166, 0x00000002, 0x00050051, 0x00000002,
+	0x0000016a, 0x00000166, 0x00000003, 0x00050051, 0x00000005, 0x0000016b, 0x00000166, 0x00000004,
+	0x00080050, 0x00000017, 0x0000016c, 0x00000167, 0x00000168, 0x00000169, 0x0000016a, 0x0000016b,
+	0x00060041, 0x00000156, 0x0000016d, 0x0000001e, 0x0000000b, 0x00000162, 0x0003003e, 0x0000016d,
+	0x0000016c, 0x0004003d, 0x00000005, 0x0000016e, 0x0000012b, 0x0004003d, 0x00000005, 0x0000016f,
+	0x00000157, 0x000500aa, 0x00000031, 0x00000170, 0x0000016f, 0x00000082, 0x000600a9, 0x00000002,
+	0x00000171, 0x00000170, 0x00000011, 0x0000000b, 0x0004007c, 0x00000005, 0x00000172, 0x00000171,
+	0x00060041, 0x000000d7, 0x00000173, 0x00000014, 0x0000000b, 0x0000016e, 0x0003003e, 0x00000173,
+	0x00000172, 0x00050041, 0x000000d7, 0x00000174, 0x00000022, 0x0000000b, 0x000700ea, 0x00000005,
+	0x00000175, 0x00000174, 0x000000d8, 0x0000003e, 0x000000d8, 0x0004003d, 0x00000005, 0x00000176,
+	0x00000157, 0x000500aa, 0x00000031, 0x00000177, 0x00000176, 0x0000003e, 0x000300f7, 0x00000179,
+	0x00000000, 0x000400fa, 0x00000177, 0x00000178, 0x0000017a, 0x000200f8, 0x00000178, 0x00050041,
+	0x000000d7, 0x0000017b, 0x00000022, 0x00000011, 0x000700ea, 0x00000005, 0x0000017c, 0x0000017b,
+	0x000000d8, 0x0000003e, 0x000000d8, 0x000200f9, 0x00000179, 0x000200f8, 0x0000017a, 0x0004003d,
+	0x00000005, 0x0000017d, 0x00000157, 0x000500aa, 0x00000031, 0x0000017e, 0x0000017d, 0x000000d8,
+	0x000300f7, 0x00000180, 0x00000000, 0x000400fa, 0x0000017e, 0x0000017f, 0x00000180, 0x000200f8,
+	0x0000017f, 0x00050041, 0x000000d7, 0x00000181, 0x00000022, 0x00000016, 0x000700ea, 0x00000005,
+	0x00000182, 0x00000181, 0x000000d8, 0x0000003e, 0x000000d8, 0x000200f9, 0x00000180, 0x000200f8,
+	0x00000180, 0x000200f9, 0x00000179, 0x000200f8, 0x00000179, 0x0004003d, 0x00000031, 0x00000183,
+	0x0000015a, 0x000300f7, 0x00000185, 0x00000000, 0x000400fa, 0x00000183, 0x00000184, 0x00000185,
+	0x000200f8, 0x00000184, 0x00050041, 0x000000d7, 0x00000186, 0x00000022, 0x0000001c, 0x000700ea,
+	0x00000005, 0x00000187, 0x00000186, 0x000000d8, 0x0000003e, 0x000000d8, 0x000200f9, 0x00000185,
+	0x000200f8, 0x00000185, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t ShadowFrag_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x00000005, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+	0x00000000, 0x00000001, 0x0005000f, 0x00000004, 0x00000001, 0x6e69616d, 0x00000000, 0x00030010,
+	0x00000001, 0x00000007, 0x00030003, 0x00000002, 0x000001c2, 0x00040005, 0x00000001, 0x6e69616d,
+	0x00000000, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002, 0x00050036, 0x00000002,
+	0x00000001, 0x00000000, 0x00000003, 0x000200f8, 0x00000004, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t ShadowVert_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x00000027, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+	0x00000000, 0x00000001, 0x0009000f, 0x00000000, 0x00000016, 0x6e69616d, 0x00000000, 0x0000000f,
+	0x00000011, 0x00000012, 0x0000001a, 0x00030003, 0x00000002, 0x000001c2, 0x00090005, 0x00000005,
+	0x626f6c67, 0x6e556c61, 0x726f6669, 0x6675426d, 0x4f726566, 0x63656a62, 0x00000074, 0x00050006,
+	0x00000005, 0x00000000, 0x77656976, 0x00000000, 0x00050006, 0x00000005, 0x00000001, 0x6a6f7270,
+	0x00000000, 0x00070006, 0x00000005, 0x00000002, 0x69626d61, 0x4c746e65, 0x74686769, 0x00000000,
+	0x00050006, 0x00000005, 0x00000003, 0x50657965, 0x0000736f, 0x00070006, 0x00000005, 0x00000004,
+	0x6867696c, 0x65695674, 0x6f725077, 0x0000006a, 0x00040005, 0x00000006, 0x6f627567, 0x00000000,
+	0x00070005, 0x0000000b, 0x66696e55, 0x426d726f, 0x65666675, 0x6a624f72, 0x00746365, 0x00050006,
+	0x0000000b, 0x00000000, 0x65646f6d, 0x0000006c, 0x00070006, 0x0000000b, 0x00000001, 0x6d726f6e,
+	0x614d6c61, 0x78697274, 0x00000000, 0x00050006, 0x0000000b, 0x00000002, 0x6f6c6f63, 0x00000072,
+	0x00060006, 0x0000000b, 0x00000003, 0x656c6573, 0x64657463, 0x00000000, 0x00070006, 0x0000000b,
+	0x00000004, 0x74786574, 0x49657275, 0x7865646e, 0x00000000, 0x00030005, 0x0000000c, 0x006f6275,
+	0x00030005, 0x0000000f, 0x00736f70, 0x00040005, 0x00000011, 0x6d726f6e, 0x00000000, 0x00050005,
+	0x00000012, 0x43786574, 0x64726f6f, 0x00000000, 0x00040005, 0x00000016, 0x6e69616d, 0x00000000,
+	0x00050005, 0x0000001a, 0x505f6c67, 0x7469736f, 0x006e6f69, 0x00050048, 0x00000005, 0x00000000,
+	0x00000023, 0x00000000, 0x00040048, 0x00000005, 0x00000000, 0x00000005, 0x00050048, 0x00000005,
+	0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x00000005, 0x00000001, 0x00000023, 0x00000040,
+	0x00040048, 0x00000005, 0x00000001, 0x00000005, 0x00050048, 0x00000005, 0x00000001, 0x00000007,
+	0x00000010, 0x00050048, 0x00000005, 0x00000002, 0x00000023, 0x00000080, 0x00050048, 0x00000005,
+	0x00000003, 0x00000023, 0x00000090, 0x00050048, 0x00000005, 0x00000004, 0x00000023, 0x000000a0,
+	0x00040048, 0x00000005, 0x00000004, 0x00000005, 0x00050048, 0x00000005, 0x00000004, 0x00000007,
+	0x00000010, 0x00030047, 0x00000005, 0x00000002, 0x00040047, 0x00000006, 0x00000022, 0x00000000,
+	0x00040047, 0x00000006, 0x00000021, 0x00000000, 0x00050048, 0x0000000b, 0x00000000, 0x00000023,
+	0x00000000, 0x00040048, 0x0000000b, 0x00000000, 0x00000005, 0x00050048, 0x0000000b, 0x00000000,
+	0x00000007, 0x00000010, 0x00050048, 0x0000000b, 0x00000001, 0x00000023, 0x00000040, 0x00040048,
+	0x0000000b, 0x00000001, 0x00000005, 0x00050048, 0x0000000b, 0x00000001, 0x00000007, 0x00000010,
+	0x00050048, 0x0000000b, 0x00000002, 0x00000023, 0x00000080, 0x00050048, 0x0000000b, 0x00000003,
+	0x00000023, 0x00000090, 0x00050048, 0x0000000b, 0x00000004, 0x00000023, 0x00000094, 0x00030047,
+	0x0000000b, 0x00000002, 0x00040047, 0x0000000c, 0x00000022, 0x00000001, 0x00040047, 0x0000000c,
+	0x00000021, 0x00000000, 0x00040047, 0x0000000f, 0x0000001e, 0x00000000, 0x00040047, 0x00000011,
+	0x0000001e, 0x00000001, 0x00040047, 0x00000012, 0x0000001e, 0x00000002, 0x00040047, 0x0000001a,
+	0x0000000b, 0x00000000, 0x00030016, 0x00000001, 0x00000020, 0x00040017, 0x00000002, 0x00000001,
+	0x00000004, 0x00040018, 0x00000003, 0x00000002, 0x00000004, 0x00040017, 0x00000004, 0x00000001,
+	0x00000003, 0x0007001e, 0x00000005, 0x00000003, 0x00000003, 0x00000004, 0x00000004, 0x00000003,
+	0x00040020, 0x00000007, 0x00000002, 0x00000005, 0x0004003b, 0x00000007, 0x00000006, 0x00000002,
+	0x00040015, 0x00000009, 0x00000020, 0x00000001, 0x0004002b, 0x00000009, 0x00000008, 0x00000000,
+	0x00040015, 0x0000000a, 0x00000020, 0x00000000, 0x0007001e, 0x0000000b, 0x00000003, 0x00000003,
+	0x00000002, 0x00000001, 0x0000000a, 0x00040020, 0x0000000d, 0x00000002, 0x0000000b, 0x0004003b,
+	0x0000000d, 0x0000000c, 0x00000002, 0x0004002b, 0x00000009, 0x0000000e, 0x00000001, 0x00040020,
+	0x00000010, 0x00000001, 0x00000004, 0x0004003b, 0x00000010, 0x0000000f, 0x00000001, 0x0004003b,
+	0x00000010, 0x00000011, 0x00000001, 0x00040017, 0x00000013, 0x00000001, 0x00000002, 0x00040020,
+	0x00000014, 0x00000001, 0x00000013, 0x0004003b, 0x00000014, 0x00000012, 0x00000001, 0x0004002b,
+	0x00000009, 0x00000015, 0x00000002, 0x00020013, 0x00000017, 0x00030021, 0x00000018, 0x00000017,
+	0x00040020, 0x0000001b, 0x00000003, 0x00000002, 0x0004003b, 0x0000001b, 0x0000001a, 0x00000003,
+	0x0004002b, 0x00000009, 0x0000001c, 0x00000004, 0x00040020, 0x0000001f, 0x00000002, 0x00000003,
+	0x0004002b, 0x00000001, 0x00000024, 0x3f800000, 0x00050036, 0x00000017, 0x00000016, 0x00000000,
+	0x00000018, 0x000200f8, 0x00000019, 0x00050041, 0x0000001f, 0x0000001e, 0x00000006, 0x0000001c,
+	0x0004003d, 0x00000003, 0x0000001d, 0x0000001e, 0x00050041, 0x0000001f, 0x00000021, 0x0000000c,
+	0x00000008, 0x0004003d, 0x00000003, 0x00000020, 0x00000021, 0x00050092, 0x00000003, 0x00000022,
+	0x0000001d, 0x00000020, 0x0004003d, 0x00000004, 0x00000023, 0x0000000f, 0x00050050, 0x00000002,
+	0x00000025, 0x00000023, 0x00000024, 0x00050091, 0x00000002, 0x00000026, 0x00000022, 0x00000025,
+	0x0003003e, 0x0000001a, 0x00000026, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t SkyBoxFrag_spv[] = {
+	0x07230203, 0x00010000, 0x000d000a, 0x0000001a, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+	0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+	0x0007000f, 0x00000004, 0x00000004, 0x6e69616d, 0x00000000, 0x00000009, 0x00000011, 0x00030010,
+	0x00000004, 0x00000007, 0x00030003, 0x00000002, 0x000001c2, 0x00090004, 0x415f4c47, 0x735f4252,
+	0x72617065, 0x5f657461, 0x64616873, 0x6f5f7265, 0x63656a62, 0x00007374, 0x000a0004, 0x475f4c47,
+	0x4c474f4f, 0x70635f45, 0x74735f70, 0x5f656c79, 0x656e696c, 0x7269645f, 0x69746365, 0x00006576,
+	0x00080004, 0x475f4c47, 0x4c474f4f, 0x6e695f45, 0x64756c63, 0x69645f65, 0x74636572, 0x00657669,
+	0x00040005, 0x00000004, 0x6e69616d, 0x00000000, 0x00050005, 0x00000009, 0x4374756f, 0x726f6c6f,
+	0x00000000, 0x00040005, 0x0000000d, 0x62796b73, 0x0000786f, 0x00060005, 0x00000011, 0x67617266,
+	0x43786554, 0x64726f6f, 0x00000000, 0x00040047, 0x00000009, 0x0000001e, 0x00000000, 0x00040047,
+	0x0000000d, 0x00000022, 0x00000000, 0x00040047, 0x0000000d, 0x00000021, 0x00000001, 0x00040047,
+	0x00000011, 0x0000001e, 0x00000000, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002,
+	0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000004, 0x00040020,
+	0x00000008, 0x00000003, 0x00000007, 0x0004003b, 0x00000008, 0x00000009, 0x00000003, 0x00090019,
+	0x0000000a, 0x00000006, 0x00000003, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
+	0x0003001b, 0x0000000b, 0x0000000a, 0x00040020, 0x0000000c, 0x00000000, 0x0000000b, 0x0004003b,
+	0x0000000c, 0x0000000d, 0x00000000, 0x00040017, 0x0000000f, 0x00000006, 0x00000003, 0x00040020,
+	0x00000010, 0x00000001, 0x0000000f, 0x0004003b, 0x00000010, 0x00000011, 0x00000001, 0x0004002b,
+	0x00000006, 0x00000015, 0x3f800000, 0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003,
+	0x000200f8, 0x00000005, 0x0004003d, 0x0000000b, 0x0000000e, 0x0000000d, 0x0004003d, 0x0000000f,
+	0x00000012, 0x00000011, 0x00050057, 0x00000007, 0x00000013, 0x0000000e, 0x00000012, 0x0008004f,
+	0x0000000f, 0x00000014, 0x00000013, 0x00000013, 0x00000000, 0x00000001, 0x00000002, 0x00050051,
+	0x00000006, 0x00000016, 0x00000014, 0x00000000, 0x00050051, 0x00000006, 0x00000017, 0x00000014,
+	0x00000001, 0x00050051, 0x00000006, 0x00000018, 0x00000014, 0x00000002, 0x00070050, 0x00000007,
+	0x00000019, 0x00000016, 0x00000017, 0x00000018, 0x00000015, 0x0003003e, 0x00000009, 0x00000019,
+	0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t SkyBoxVert_spv[] = {
+	0x07230203, 0x00010000, 0x000d000a, 0x0000002a, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+	0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+	0x0008000f, 0x00000000, 0x00000004, 0x6e69616d, 0x00000000, 0x00000009, 0x0000000b, 0x00000025,
+	0x00030003, 0x00000002, 0x000001c2, 0x00090004, 0x415f4c47, 0x735f4252, 0x72617065, 0x5f657461,
+	0x64616873, 0x6f5f7265, 0x63656a62, 0x00007374, 0x000a0004, 0x475f4c47, 0x4c474f4f, 0x70635f45,
+	0x74735f70, 0x5f656c79, 0x656e696c, 0x7269645f, 0x69746365, 0x00006576, 0x00080004, 0x475f4c47,
+	0x4c474f4f, 0x6e695f45, 0x64756c63, 0x69645f65, 0x74636572, 0x00657669, 0x00040005, 0x00000004,
+	0x6e69616d, 0x00000000, 0x00060005, 0x00000009, 0x67617266, 0x43786554, 0x64726f6f, 0x00000000,
+	0x00050005, 0x0000000b, 0x6f506e69, 0x69746973, 0x00006e6f, 0x00030005, 0x0000000f, 0x00736f70,
+	0x00070005, 0x00000011, 0x66696e55, 0x426d726f, 0x65666675, 0x6a624f72, 0x00746365, 0x00050006,
+	0x00000011, 0x00000000, 0x4d70766d, 0x00007461, 0x00030005, 0x00000013, 0x006f6275, 0x00060005,
+	0x00000023, 0x505f6c67, 0x65567265, 0x78657472, 0x00000000, 0x00060006, 0x00000023, 0x00000000,
+	0x505f6c67, 0x7469736f, 0x006e6f69, 0x00070006, 0x00000023, 0x00000001, 0x505f6c67, 0x746e696f,
+	0x657a6953, 0x00000000, 0x00070006, 0x00000023, 0x00000002, 0x435f6c67, 0x4470696c, 0x61747369,
+	0x0065636e, 0x00070006, 0x00000023, 0x00000003, 0x435f6c67, 0x446c6c75, 0x61747369, 0x0065636e,
+	0x00030005, 0x00000025, 0x00000000, 0x00040047, 0x00000009, 0x0000001e, 0x00000000, 0x00040047,
+	0x0000000b, 0x0000001e, 0x00000000, 0x00040048, 0x00000011, 0x00000000, 0x00000005, 0x00050048,
+	0x00000011, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000011, 0x00000000, 0x00000007,
+	0x00000010, 0x00030047, 0x00000011, 0x00000002, 0x00040047, 0x00000013, 0x00000022, 0x00000000,
+	0x00040047, 0x00000013, 0x00000021, 0x00000000, 0x00050048, 0x00000023, 0x00000000, 0x0000000b,
+	0x00000000, 0x00050048, 0x00000023, 0x00000001, 0x0000000b, 0x00000001, 0x00050048, 0x00000023,
+	0x00000002, 0x0000000b, 0x00000003, 0x00050048, 0x00000023, 0x00000003, 0x0000000b, 0x00000004,
+	0x00030047, 0x00000023, 0x00000002, 0x00020013, 0x00000002, 0x00030021, 0x00000003, 0x00000002,
+	0x00030016, 0x00000006, 0x00000020, 0x00040017, 0x00000007, 0x00000006, 0x00000003, 0x00040020,
+	0x00000008, 0x00000003, 0x00000007, 0x0004003b, 0x00000008, 0x00000009, 0x00000003, 0x00040020,
+	0x0000000a, 0x00000001, 0x00000007, 0x0004003b, 0x0000000a, 0x0000000b, 0x00000001, 0x00040017,
+	0x0000000d, 0x00000006, 0x00000004, 0x00040020, 0x0000000e, 0x00000007, 0x0000000d, 0x00040018,
+	0x00000010, 0x0000000d, 0x00000004, 0x0003001e, 0x00000011, 0x00000010, 0x00040020, 0x00000012,
+	0x00000002, 0x00000011, 0x0004003b, 0x00000012, 0x00000013, 0x00000002, 0x00040015, 0x00000014,
+	0x00000020, 0x00000001, 0x0004002b, 0x00000014, 0x00000015, 0x00000000, 0x00040020, 0x00000016,
+	0x00000002, 0x00000010, 0x0004002b, 0x00000006, 0x0000001a, 0x3f800000, 0x00040015, 0x00000020,
+	0x00000020, 0x00000000, 0x0004002b, 0x00000020, 0x00000021, 0x00000001, 0x0004001c, 0x00000022,
+	0x00000006, 0x00000021, 0x0006001e, 0x00000023, 0x0000000d, 0x00000006, 0x00000022, 0x00000022,
+	0x00040020, 0x00000024, 0x00000003, 0x00000023, 0x0004003b, 0x00000024, 0x00000025, 0x00000003,
+	0x00040020, 0x00000028, 0x00000003, 0x0000000d, 0x00050036, 0x00000002, 0x00000004, 0x00000000,
+	0x00000003, 0x000200f8, 0x00000005, 0x0004003b, 0x0000000e, 0x0000000f, 0x00000007, 0x0004003d,
+	0x00000007, 0x0000000c, 0x0000000b, 0x0003003e, 0x00000009, 0x0000000c, 0x00050041, 0x00000016,
+	0x00000017, 0x00000013, 0x00000015, 0x0004003d, 0x00000010, 0x00000018, 0x00000017, 0x0004003d,
+	0x00000007, 0x00000019, 0x0000000b, 0x00050051, 0x00000006, 0x0000001b, 0x00000019, 0x00000000,
+	0x00050051, 0x00000006, 0x0000001c, 0x00000019, 0x00000001, 0x00050051, 0x00000006, 0x0000001d,
+	0x00000019, 0x00000002, 0x00070050, 0x0000000d, 0x0000001e, 0x0000001b, 0x0000001c, 0x0000001d,
+	0x0000001a, 0x00050091, 0x0000000d, 0x0000001f, 0x00000018, 0x0000001e, 0x0003003e, 0x0000000f,
+	0x0000001f, 0x0004003d, 0x0000000d, 0x00000026, 0x0000000f, 0x0009004f, 0x0000000d, 0x00000027,
+	0x00000026, 0x00000026, 0x00000000, 0x00000001, 0x00000003, 0x00000003, 0x00050041, 0x00000028,
+	0x00000029, 0x00000025, 0x00000015, 0x0003003e, 0x00000029, 0x00000027, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t WireframeFrag_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x00000036, 0x00000000, 0x00020011, 0x00000001, 0x0006000b,
+	0x00000023, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+	0x0009000f, 0x00000004, 0x00000018, 0x6e69616d, 0x00000000, 0x0000000e, 0x00000011, 0x00000012,
+	0x00000016, 0x00030010, 0x00000018, 0x00000007, 0x00030003, 0x00000002, 0x000001c2, 0x00090005,
+	0x00000004, 0x626f6c67, 0x6e556c61, 0x726f6669, 0x6675426d, 0x4f726566, 0x63656a62, 0x00000074,
+	0x00050006, 0x00000004, 0x00000000, 0x77656976, 0x00000000, 0x00050006, 0x00000004, 0x00000001,
+	0x6a6f7270, 0x00000000, 0x00040005, 0x00000005, 0x6f627567, 0x00000000, 0x000a0005, 0x00000009,
+	0x65726957, 0x6d617266, 0x696e5565, 0x6d726f66, 0x66667542, 0x624f7265, 0x7463656a, 0x00000000,
+	0x00050006, 0x00000009, 0x00000000, 0x65646f6d, 0x0000006c, 0x00050006, 0x00000009, 0x00000001,
+	0x6f6c6f63, 0x00000072, 0x00030005, 0x0000000a, 0x006f6275, 0x00040005, 0x0000000e, 0x67617266,
+	0x00736f50, 0x00060005, 0x00000011, 0x67617266, 0x79726142, 0x746e6563, 0x00636972, 0x00060005,
+	0x00000012, 0x67617266, 0x43786554, 0x64726f6f, 0x00000000, 0x00050005, 0x00000016, 0x4374756f,
+	0x726f6c6f, 0x00000000, 0x00040005, 0x00000018, 0x6e69616d, 0x00000000, 0x00040005, 0x0000001c,
+	0x65786970, 0x0000736c, 0x00050048, 0x00000004, 0x00000000, 0x00000023, 0x00000000, 0x00040048,
+	0x00000004, 0x00000000, 0x00000005, 0x00050048, 0x00000004, 0x00000000, 0x00000007, 0x00000010,
+	0x00050048, 0x00000004, 0x00000001, 0x00000023, 0x00000040, 0x00040048, 0x00000004, 0x00000001,
+	0x00000005, 0x00050048, 0x00000004, 0x00000001, 0x00000007, 0x00000010, 0x00030047, 0x00000004,
+	0x00000002, 0x00040047, 0x00000005, 0x00000022, 0x00000000, 0x00040047, 0x00000005, 0x00000021,
+	0x00000000, 0x00050048, 0x00000009, 0x00000000, 0x00000023, 0x00000000, 0x00040048, 0x00000009,
+	0x00000000, 0x00000005, 0x00050048, 0x00000009, 0x00000000, 0x00000007, 0x00000010, 0x00050048,
+	0x00000009, 0x00000001, 0x00000023, 0x00000040, 0x00030047, 0x00000009, 0x00000002, 0x00040047,
+	0x0000000a, 0x00000022, 0x00000001, 0x00040047, 0x0000000a, 0x00000021, 0x00000000, 0x00040047,
+	0x0000000e, 0x0000001e, 0x00000000, 0x00040047, 0x00000011, 0x0000001e, 0x00000001, 0x00040047,
+	0x00000012, 0x0000001e, 0x00000002, 0x00040047, 0x00000016, 0x0000001e, 0x00000000, 0x00030016,
+	0x00000001, 0x00000020, 0x00040017, 0x00000002, 0x00000001, 0x00000004, 0x00040018, 0x00000003,
+	0x00000002, 0x00000004, 0x0004001e, 0x00000004, 0x00000003, 0x00000003, 0x00040020, 0x00000006,
+	0x00000002, 0x00000004, 0x0004003b, 0x00000006, 0x00000005, 0x00000002, 0x00040015, 0x00000008,
+	0x00000020, 0x00000001, 0x0004002b, 0x00000008, 0x00000007, 0x00000000, 0x0004001e, 0x00000009,
+	0x00000003, 0x00000002, 0x00040020, 0x0000000b, 0x00000002, 0x00000009, 0x0004003b, 0x0000000b,
+	0x0000000a, 0x00000002, 0x0004002b, 0x00000008, 0x0000000c, 0x00000001, 0x0004002b, 0x00000001,
+	0x0000000d, 0x3f800000, 0x00040017, 0x0000000f, 0x00000001, 0x00000003, 0x00040020, 0x00000010,
+	0x00000001, 0x0000000f, 0x0004003b, 0x00000010, 0x0000000e, 0x00000001, 0x0004003b, 0x00000010,
+	0x00000011, 0x00000001, 0x00040017, 0x00000013, 0x00000001, 0x00000002, 0x00040020, 0x00000014,
+	0x00000001, 0x00000013, 0x0004003b, 0x00000014, 0x00000012, 0x00000001, 0x0004002b, 0x00000008,
+	0x00000015, 0x00000002, 0x00040020, 0x00000017, 0x00000003, 0x00000002, 0x0004003b, 0x00000017,
+	0x00000016, 0x00000003, 0x00020013, 0x00000019, 0x00030021, 0x0000001a, 0x00000019, 0x00040020,
+	0x0000001d, 0x00000007, 0x0000000f, 0x0004002b, 0x00000001, 0x00000021, 0x358637bd, 0x0006002c,
+	0x0000000f, 0x00000022, 0x00000021, 0x00000021, 0x00000021, 0x00040020, 0x00000028, 0x00000007,
+	0x00000001, 0x00020014, 0x00000030, 0x00040020, 0x00000035, 0x00000002, 0x00000002, 0x00050036,
+	0x00000019, 0x00000018, 0x00000000, 0x0000001a, 0x000200f8, 0x0000001b, 0x0004003b, 0x0000001d,
+	0x0000001c, 0x00000007, 0x0004003d, 0x0000000f, 0x0000001e, 0x00000011, 0x0004003d, 0x0000000f,
+	0x0000001f, 0x00000011, 0x000400d1, 0x0000000f, 0x00000020, 0x0000001f, 0x0007000c, 0x0000000f,
+	0x00000024, 0x00000023, 0x00000028, 0x00000020, 0x00000022, 0x00050088, 0x0000000f, 0x00000025,
+	0x0000001e, 0x00000024, 0x0003003e, 0x0000001c, 0x00000025, 0x00050041, 0x00000028, 0x00000027,
+	0x0000001c, 0x00000007, 0x0004003d, 0x00000001, 0x00000026, 0x00000027, 0x00050041, 0x00000028,
+	0x0000002a, 0x0000001c, 0x0000000c, 0x0004003d, 0x00000001, 0x00000029, 0x0000002a, 0x0007000c,
+	0x00000001, 0x0000002b, 0x00000023, 0x00000025, 0x00000026, 0x00000029, 0x00050041, 0x00000028,
+	0x0000002d, 0x0000001c, 0x00000015, 0x0004003d, 0x00000001, 0x0000002c, 0x0000002d, 0x0007000c,
+	0x00000001, 0x0000002e, 0x00000023, 0x00000025, 0x0000002b, 0x0000002c, 0x000500ba, 0x00000030,
+	0x0000002f, 0x0000002e, 0x0000000d, 0x000300f7, 0x00000032, 0x00000000, 0x000400fa, 0x0000002f,
+	0x00000031, 0x00000032, 0x000200f8, 0x00000031, 0x000100fc, 0x000200f8, 0x00000032, 0x00050041,
+	0x00000035, 0x00000034, 0x0000000a, 0x0000000c, 0x0004003d, 0x00000002, 0x00000033, 0x00000034,
+	0x0003003e, 0x00000016, 0x00000033, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t WireframeVert_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x00000035, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+	0x00000000, 0x00000001, 0x000c000f, 0x00000000, 0x0000001a, 0x6e69616d, 0x00000000, 0x0000000d,
+	0x00000010, 0x00000011, 0x00000015, 0x00000017, 0x00000018, 0x0000001e, 0x00030003, 0x00000002,
+	0x000001c2, 0x00090005, 0x00000004, 0x626f6c67, 0x6e556c61, 0x726f6669, 0x6675426d, 0x4f726566,
+	0x63656a62, 0x00000074, 0x00050006, 0x00000004, 0x00000000, 0x77656976, 0x00000000, 0x00050006,
+	0x00000004, 0x00000001, 0x6a6f7270, 0x00000000, 0x00040005, 0x00000005, 0x6f627567, 0x00000000,
+	0x000a0005, 0x00000009, 0x65726957, 0x6d617266, 0x696e5565, 0x6d726f66, 0x66667542, 0x624f7265,
+	0x7463656a, 0x00000000, 0x00050006, 0x00000009, 0x00000000, 0x65646f6d, 0x0000006c, 0x00050006,
+	0x00000009, 0x00000001, 0x6f6c6f63, 0x00000072, 0x00030005, 0x0000000a, 0x006f6275, 0x00030005,
+	0x0000000d, 0x00736f70, 0x00040005, 0x00000010, 0x6d726f6e, 0x00000000, 0x00050005, 0x00000011,
+	0x43786574, 0x64726f6f, 0x00000000, 0x00040005, 0x00000015, 0x67617266, 0x00736f50, 0x00060005,
+	0x00000017, 0x67617266, 0x79726142, 0x746e6563, 0x00636972, 0x00060005, 0x00000018, 0x67617266,
+	0x43786554, 0x64726f6f, 0x00000000, 0x00040005, 0x0000001a, 0x6e69616d, 0x00000000, 0x00050005,
+	0x0000001e, 0x505f6c67, 0x7469736f, 0x006e6f69, 0x00050048, 0x00000004, 0x00000000, 0x00000023,
+	0x00000000, 0x00040048, 0x00000004, 0x00000000, 0x00000005, 0x00050048, 0x00000004, 0x00000000,
+	0x00000007, 0x00000010, 0x00050048, 0x00000004, 0x00000001, 0x00000023, 0x00000040, 0x00040048,
+	0x00000004, 0x00000001, 0x00000005, 0x00050048, 0x00000004, 0x00000001, 0x00000007, 0x00000010,
+	0x00030047, 0x00000004, 0x00000002, 0x00040047, 0x00000005, 0x00000022, 0x00000000, 0x00040047,
+	0x00000005, 0x00000021, 0x00000000, 0x00050048, 0x00000009, 0x00000000, 0x00000023, 0x00000000,
+	0x00040048, 0x00000009, 0x00000000, 0x00000005, 0x00050048, 0x00000009, 0x00000000, 0x00000007,
+	0x00000010, 0x00050048, 0x00000009, 0x00000001, 0x00000023, 0x00000040, 0x00030047, 0x00000009,
+	0x00000002, 0x00040047, 0x0000000a, 0x00000022, 0x00000001, 0x00040047, 0x0000000a, 0x00000021,
+	0x00000000, 0x00040047, 0x0000000d, 0x0000001e, 0x00000000, 0x00040047, 0x00000010, 0x0000001e,
+	0x00000001, 0x00040047, 0x00000011, 0x0000001e, 0x00000002, 0x00040047, 0x00000015, 0x0000001e,
+	0x00000000, 0x00040047, 0x00000017, 0x0000001e, 0x00000001, 0x00040047, 0x00000018, 0x0000001e,
+	0x00000002, 0x00040047, 0x0000001e, 0x0000000b, 0x00000000, 0x00030016, 0x00000001, 0x00000020,
+	0x00040017, 0x00000002, 0x00000001, 0x00000004, 0x00040018, 0x00000003, 0x00000002, 0x00000004,
+	0x0004001e, 0x00000004, 0x00000003, 0x00000003, 0x00040020, 0x00000006, 0x00000002, 0x00000004,
+	0x0004003b, 0x00000006, 0x00000005, 0x00000002, 0x00040015, 0x00000008, 0x00000020, 0x00000001,
+	0x0004002b, 0x00000008, 0x00000007, 0x00000000, 0x0004001e, 0x00000009, 0x00000003, 0x00000002,
+	0x00040020, 0x0000000b, 0x00000002, 0x00000009, 0x0004003b, 0x0000000b, 0x0000000a, 0x00000002,
+	0x0004002b, 0x00000008, 0x0000000c, 0x00000001, 0x00040017, 0x0000000e, 0x00000001, 0x00000003,
+	0x00040020, 0x0000000f, 0x00000001, 0x0000000e, 0x0004003b, 0x0000000f, 0x0000000d, 0x00000001,
+	0x0004003b, 0x0000000f, 0x00000010, 0x00000001, 0x00040017, 0x00000012, 0x00000001, 0x00000002,
+	0x00040020, 0x00000013, 0x00000001, 0x00000012, 0x0004003b, 0x00000013, 0x00000011, 0x00000001,
+	0x0004002b, 0x00000008, 0x00000014, 0x00000002, 0x00040020, 0x00000016, 0x00000003, 0x0000000e,
+	0x0004003b, 0x00000016, 0x00000015, 0x00000003, 0x0004003b, 0x00000016, 0x00000017, 0x00000003,
+	0x00040020, 0x00000019, 0x00000003, 0x00000012, 0x0004003b, 0x00000019, 0x00000018, 0x00000003,
+	0x00020013, 0x0000001b, 0x00030021, 0x0000001c, 0x0000001b, 0x00040020, 0x0000001f, 0x00000003,
+	0x00000002, 0x0004003b, 0x0000001f, 0x0000001e, 0x00000003, 0x00040020, 0x00000022, 0x00000002,
+	0x00000003, 0x0004002b, 0x00000001, 0x0000002a, 0x3f800000, 0x00050036, 0x0000001b, 0x0000001a,
+	0x00000000, 0x0000001c, 0x000200f8, 0x0000001d, 0x00050041, 0x00000022, 0x00000021, 0x00000005,
+	0x0000000c, 0x0004003d, 0x00000003, 0x00000020, 0x00000021, 0x00050041, 0x00000022, 0x00000024,
+	0x00000005, 0x00000007, 0x0004003d, 0x00000003, 0x00000023, 0x00000024, 0x00050092, 0x00000003,
+	0x00000025, 0x00000020, 0x00000023, 0x00050041, 0x00000022, 0x00000027, 0x0000000a, 0x00000007,
+	0x0004003d, 0x00000003, 0x00000026, 0x00000027, 0x00050092, 0x00000003, 0x00000028, 0x00000025,
+	0x00000026, 0x0004003d, 0x0000000e, 0x00000029, 0x0000000d, 0x00050050, 0x00000002, 0x0000002b,
+	0x00000029, 0x0000002a, 0x00050091, 0x00000002, 0x0000002c, 0x00000028, 0x0000002b, 0x0003003e,
+	0x0000001e, 0x0000002c, 0x00050041, 0x00000022, 0x0000002e, 0x0000000a, 0x00000007, 0x0004003d,
+	0x00000003, 0x0000002d, 0x0000002e, 0x0004003d, 0x0000000e, 0x0000002f, 0x0000000d, 0x00050050,
+	0x00000002, 0x00000030, 0x0000002f, 0x0000002a, 0x00050091, 0x00000002, 0x00000031, 0x0000002d,
+	0x00000030, 0x0008004f, 0x0000000e, 0x00000032, 0x00000031, 0x00000031, 0x00000000, 0x00000001,
+	0x00000002, 0x0003003e, 0x00000015, 0x00000032, 0x0004003d, 0x0000000e, 0x00000033, 0x00000010,
+	0x0003003e, 0x00000017, 0x00000033, 0x0004003d, 0x00000012, 0x00000034, 0x00000011, 0x0003003e,
+	0x00000018, 0x00000034, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t frag_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x000001a5, 0x00000000, 0x00020011, 0x00000001, 0x00020011,
+	0x00000032, 0x0006000b, 0x000000a3, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e,
+	0x00000000, 0x00000001, 0x000a000f, 0x00000004, 0x0000003f, 0x6e69616d, 0x00000000, 0x00000035,
+	0x00000037, 0x00000038, 0x0000003b, 0x000000b2, 0x00030010, 0x0000003f, 0x00000007, 0x00030003,
+	0x00000002, 0x000001c2, 0x00050005, 0x00000005, 0x5f455355, 0x54584554, 0x00455255, 0x00050005,
+	0x00000007, 0x5f455355, 0x4847494c, 0x00005354, 0x00060005, 0x00000009, 0x5f455355, 0x43455053,
+	0x52414c55, 0x00000000, 0x00070005, 0x0000000b, 0x5f455355, 0x494d4548, 0x424d415f, 0x544e4549,
+	0x00000000, 0x00050005, 0x0000000f, 0x43455053, 0x574f505f, 0x00005245, 0x00050005, 0x00000010,
+	0x64616873, 0x614d776f, 0x00000070, 0x00050005, 0x00000015, 0x74786574, 0x73657275, 0x00000000,
+	0x00090005, 0x00000021, 0x626f6c67, 0x6e556c61, 0x726f6669, 0x6675426d, 0x4f726566, 0x63656a62,
+	0x00000074, 0x00050006, 0x00000021, 0x00000000, 0x77656976, 0x00000000, 0x00050006, 0x00000021,
+	0x00000001, 0x6a6f7270, 0x00000000, 0x00070006, 0x00000021, 0x00000002, 0x69626d61, 0x4c746e65,
+	0x74686769, 0x00000000, 0x00050006, 0x00000021, 0x00000003, 0x50657965, 0x0000736f, 0x00070006,
+	0x00000021, 0x00000004, 0x6867696c, 0x65695674, 0x6f725077, 0x0000006a, 0x00060006, 0x00000021,
+	0x00000005, 0x73756c63, 0x47726574, 0x00646972, 0x00070006, 0x00000021, 0x00000006, 0x73756c63,
+	0x50726574, 0x6d617261, 0x00000073, 0x00040005, 0x00000022, 0x6f627567, 0x00000000, 0x00040005,
+	0x00000024, 0x6867694c, 0x00000074, 0x00070006, 0x00000024, 0x00000000, 0x69736f70, 0x6e6f6974,
+	0x676e6152, 0x00000065, 0x00060006, 0x00000024, 0x00000001, 0x6f6c6f63, 0x70795472, 0x00000065,
+	0x00080006, 0x00000024, 0x00000002, 0x65726964, 0x6f697463, 0x736f436e, 0x6574754f, 0x00000072,
+	0x00050006, 0x00000024, 0x00000003, 0x61726170, 0x0000736d, 0x00050005, 0x00000026, 0x6867694c,
+	0x66754274, 0x00726566, 0x00050006, 0x00000026, 0x00000000, 0x6867696c, 0x00007374, 0x00060005,
+	0x0000002b, 0x73756c43, 0x42726574, 0x65666675, 0x00000072, 0x00060006, 0x0000002b, 0x00000000,
+	0x73756c63, 0x73726574, 0x00000000, 0x00070005, 0x0000002f, 0x6867694c, 0x646e4974, 0x75427865,
+	0x72656666, 0x00000000, 0x00070006, 0x0000002f, 0x00000000, 0x6867696c, 0x646e4974, 0x73656369,
+	0x00000000, 0x00070005, 0x00000032, 0x66696e55, 0x426d726f, 0x65666675, 0x6a624f72, 0x00746365,
+	0x00050006, 0x00000032, 0x00000000, 0x65646f6d, 0x0000006c, 0x00070006, 0x00000032, 0x00000001,
+	0x6d726f6e, 0x614d6c61, 0x78697274, 0x00000000, 0x00050006, 0x00000032, 0x00000002, 0x6f6c6f63,
+	0x00000072, 0x00060006, 0x00000032, 0x00000003, 0x656c6573, 0x64657463, 0x00000000, 0x00070006,
+	0x00000032, 0x00000004, 0x74786574, 0x49657275, 0x7865646e, 0x00000000, 0x00030005, 0x00000033,
+	0x006f6275, 0x00040005, 0x00000035, 0x67617266, 0x00736f50, 0x00050005, 0x00000037, 0x67617266,
+	0x6d726f4e, 0x00000000, 0x00060005, 0x00000038, 0x67617266, 0x43786554, 0x64726f6f, 0x00000000,
+	0x00050005, 0x0000003b, 0x4374756f, 0x726f6c6f, 0x00000000, 0x00070005, 0x0000003d, 0x746f7073,
+	0x6867696c, 0x73695674, 0x6c696269, 0x00797469, 0x00060005, 0x0000003e, 0x73756c63, 0x49726574,
+	0x7865646e, 0x00000000, 0x00040005, 0x0000003f, 0x6e69616d, 0x00000000, 0x00050005, 0x00000042,
+	0x6867696c, 0x696c4374, 0x00000070, 0x00050005, 0x0000004b, 0x6867696c, 0x63644e74, 0x00000000,
+	0x00030005, 0x00000054, 0x00007675, 0x00040005, 0x0000005c, 0x65786574, 0x0000006c, 0x00050005,
+	0x00000064, 0x69736976, 0x696c6962, 0x00007974, 0x00030005, 0x00000066, 0x00000078, 0x00030005,
+	0x00000070, 0x00000079, 0x00040005, 0x00000093, 0x74706564, 0x00000068, 0x00030005, 0x0000009b,
+	0x0000007a, 0x00040005, 0x000000b0, 0x656c6974, 0x00000000, 0x00060005, 0x000000b2, 0x465f6c67,
+	0x43676172, 0x64726f6f, 0x00000000, 0x00050005, 0x000000d8, 0x66666964, 0x6f6c6f43, 0x00000072,
+	0x00030005, 0x000000ed, 0x0000004e, 0x00040005, 0x000000f0, 0x44657945, 0x00007269, 0x00040005,
+	0x000000f8, 0x69626d61, 0x00746e65, 0x00040005, 0x0000010c, 0x6f6c6f63, 0x00000072, 0x00040005,
+	0x00000113, 0x73756c63, 0x00726574, 0x00030005, 0x00000118, 0x00000069, 0x00040005, 0x00000124,
+	0x6867694c, 0x00000074, 0x00070006, 0x00000124, 0x00000000, 0x69736f70, 0x6e6f6974, 0x676e6152,
+	0x00000065, 0x00060006, 0x00000124, 0x00000001, 0x6f6c6f63, 0x70795472, 0x00000065, 0x00080006,
+	0x00000124, 0x00000002, 0x65726964, 0x6f697463, 0x736f436e, 0x6574754f, 0x00000072, 0x00050006,
+	0x00000124, 0x00000003, 0x61726170, 0x0000736d, 0x00040005, 0x00000123, 0x6867696c, 0x00000074,
+	0x00040005, 0x00000134, 0x694c6f74, 0x00746867, 0x00050005, 0x0000013a, 0x74736964, 0x65636e61,
+	0x00000000, 0x00030005, 0x0000013d, 0x0000446c, 0x00040005, 0x00000142, 0x61636564, 0x00000079,
+	0x00040005, 0x0000014a, 0x646e6977, 0x0000776f, 0x00050005, 0x00000153, 0x6867696c, 0x6c6f4374,
+	0x0000726f, 0x00070005, 0x00000162, 0x746f7073, 0x6867696c, 0x6e6f4374, 0x63614665, 0x00726f74,
+	0x00040005, 0x0000017e, 0x66666964, 0x00657375, 0x00050005, 0x00000185, 0x63657073, 0x72616c75,
+	0x00000000, 0x00030005, 0x00000189, 0x00000052, 0x00040047, 0x00000005, 0x00000001, 0x00000000,
+	0x00040047, 0x00000007, 0x00000001, 0x00000001, 0x00040047, 0x00000009, 0x00000001, 0x00000002,
+	0x00040047, 0x0000000b, 0x00000001, 0x00000003, 0x00040047, 0x0000000f, 0x00000001, 0x00000004,
+	0x00040047, 0x00000010, 0x00000022, 0x00000000, 0x00040047, 0x00000010, 0x00000021, 0x00000001,
+	0x00040047, 0x00000015, 0x00000022, 0x00000000, 0x00040047, 0x00000015, 0x00000021, 0x00000005,
+	0x00050048, 0x00000021, 0x00000000, 0x00000023, 0x00000000, 0x00040048, 0x00000021, 0x00000000,
+	0x00000005, 0x00050048, 0x00000021, 0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x00000021,
+	0x00000001, 0x00000023, 0x00000040, 0x00040048, 0x00000021, 0x00000001, 0x00000005, 0x00050048,
+	0x00000021, 0x00000001, 0x00000007, 0x00000010, 0x00050048, 0x00000021, 0x00000002, 0x00000023,
+	0x00000080, 0x00050048, 0x00000021, 0x00000003, 0x00000023, 0x00000090, 0x00050048, 0x00000021,
+	0x00000004, 0x00000023, 0x000000a0, 0x00040048, 0x00000021, 0x00000004, 0x00000005, 0x00050048,
+	0x00000021, 0x00000004, 0x00000007, 0x00000010, 0x00050048, 0x00000021, 0x00000005, 0x00000023,
+	0x000000e0, 0x00050048, 0x00000021, 0x00000006, 0x00000023, 0x000000f0, 0x00030047, 0x00000021,
+	0x00000002, 0x00040047, 0x00000022, 0x00000022, 0x00000000, 0x00040047, 0x00000022, 0x00000021,
+	0x00000000, 0x00050048, 0x00000024, 0x00000000, 0x00000023, 0x00000000, 0x00050048, 0x00000024,
+	0x00000001, 0x00000023, 0x00000010, 0x00050048, 0x00000024, 0x00000002, 0x00000023, 0x00000020,
+	0x00050048, 0x00000024, 0x00000003, 0x00000023, 0x00000030, 0x00040047, 0x00000025, 0x00000006,
+	0x00000040, 0x00050048, 0x00000026, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x00000026,
+	0x00000003, 0x00040048, 0x00000026, 0x00000000, 0x00000018, 0x00040047, 0x00000027, 0x00000022,
+	0x00000000, 0x00040047, 0x00000027, 0x00000021, 0x00000002, 0x00040047, 0x0000002a, 0x00000006,
+	0x00000008, 0x00050048, 0x0000002b, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x0000002b,
+	0x00000003, 0x00040048, 0x0000002b, 0x00000000, 0x00000018, 0x00040047, 0x0000002c, 0x00000022,
+	0x00000000, 0x00040047, 0x0000002c, 0x00000021, 0x00000003, 0x00040047, 0x0000002e, 0x00000006,
+	0x00000004, 0x00050048, 0x0000002f, 0x00000000, 0x00000023, 0x00000000, 0x00030047, 0x0000002f,
+	0x00000003, 0x00040048, 0x0000002f, 0x00000000, 0x00000018, 0x00040047, 0x00000030, 0x00000022,
+	0x00000000, 0x00040047, 0x00000030, 0x00000021, 0x00000004, 0x00050048, 0x00000032, 0x00000000,
+	0x00000023, 0x00000000, 0x00040048, 0x00000032, 0x00000000, 0x00000005, 0x00050048, 0x00000032,
+	0x00000000, 0x00000007, 0x00000010, 0x00050048, 0x00000032, 0x00000001, 0x00000023, 0x00000040,
+	0x00040048, 0x00000032, 0x00000001, 0x00000005, 0x00050048, 0x00000032, 0x00000001, 0x00000007,
+	0x00000010, 0x00050048, 0x00000032, 0x00000002, 0x00000023, 0x00000080, 0x00050048, 0x00000032,
+	0x00000003, 0x00000023, 0x00000090, 0x00050048, 0x00000032, 0x00000004, 0x00000023, 0x00000094,
+	0x00030047, 0x00000032, 0x00000002, 0x00040047, 0x00000033, 0x00000022, 0x00000001, 0x00040047,
+	0x00000033, 0x00000021, 0x00000000, 0x00040047, 0x00000035, 0x0000001e, 0x00000000, 0x00040047,
+	0x00000037, 0x0000001e, 0x00000001, 0x00040047, 0x00000038, 0x0000001e, 0x00000002, 0x00040047,
+	0x0000003b, 0x0000001e, 0x00000000, 0x00040047, 0x000000b2, 0x0000000b, 0x0000000f, 0x00040015,
+	0x00000002, 0x00000020, 0x00000001, 0x0004002b, 0x00000002, 0x00000001, 0x00000000, 0x00020014,
+	0x00000004, 0x00030029, 0x00000004, 0x00000003, 0x00030030, 0x00000004, 0x00000005, 0x0004002b,
+	0x00000002, 0x00000006, 0x00000001, 0x00030030, 0x00000004, 0x00000007, 0x0004002b, 0x00000002,
+	0x00000008, 0x00000002, 0x00030030, 0x00000004, 0x00000009, 0x0004002b, 0x00000002, 0x0000000a,
+	0x00000003, 0x00030030, 0x00000004, 0x0000000b, 0x0004002b, 0x00000002, 0x0000000c, 0x00000004,
+	0x00030016, 0x0000000e, 0x00000020, 0x0004002b, 0x0000000e, 0x0000000d, 0x43160000, 0x00040032,
+	0x0000000e, 0x0000000f, 0x43160000, 0x00090019, 0x00000011, 0x0000000e, 0x00000001, 0x00000001,
+	0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x0003001b, 0x00000012, 0x00000011, 0x00040020,
+	0x00000013, 0x00000000, 0x00000012, 0x0004003b, 0x00000013, 0x00000010, 0x00000000, 0x0004002b,
+	0x00000002, 0x00000014, 0x00000010, 0x00090019, 0x00000016, 0x0000000e, 0x00000001, 0x00000000,
+	0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x0003001b, 0x00000017, 0x00000016, 0x00040015,
+	0x00000019, 0x00000020, 0x00000000, 0x0004002b, 0x00000019, 0x00000018, 0x00000010, 0x0004001c,
+	0x0000001a, 0x00000017, 0x00000018, 0x00040020, 0x0000001b, 0x00000000, 0x0000001a, 0x0004003b,
+	0x0000001b, 0x00000015, 0x00000000, 0x0004002b, 0x00000002, 0x0000001c, 0x00000005, 0x00040017,
+	0x0000001d, 0x0000000e, 0x00000004, 0x00040018, 0x0000001e, 0x0000001d, 0x00000004, 0x00040017,
+	0x0000001f, 0x0000000e, 0x00000003, 0x00040017, 0x00000020, 0x00000019, 0x00000004, 0x0009001e,
+	0x00000021, 0x0000001e, 0x0000001e, 0x0000001f, 0x0000001f, 0x0000001e, 0x00000020, 0x0000001d,
+	0x00040020, 0x00000023, 0x00000002, 0x00000021, 0x0004003b, 0x00000023, 0x00000022, 0x00000002,
+	0x0006001e, 0x00000024, 0x0000001d, 0x0000001d, 0x0000001d, 0x0000001d, 0x0003001d, 0x00000025,
+	0x00000024, 0x0003001e, 0x00000026, 0x00000025, 0x00040020, 0x00000028, 0x00000002, 0x00000026,
+	0x0004003b, 0x00000028, 0x00000027, 0x00000002, 0x00040017, 0x00000029, 0x00000019, 0x00000002,
+	0x0003001d, 0x0000002a, 0x00000029, 0x0003001e, 0x0000002b, 0x0000002a, 0x00040020, 0x0000002d,
+	0x00000002, 0x0000002b, 0x0004003b, 0x0000002d, 0x0000002c, 0x00000002, 0x0003001d, 0x0000002e,
+	0x00000019, 0x0003001e, 0x0000002f, 0x0000002e, 0x00040020, 0x00000031, 0x00000002, 0x0000002f,
+	0x0004003b, 0x00000031, 0x00000030, 0x00000002, 0x0007001e, 0x00000032, 0x0000001e, 0x0000001e,
+	0x0000001d, 0x0000000e, 0x00000019, 0x00040020, 0x00000034, 0x00000002, 0x00000032, 0x0004003b,
+	0x00000034, 0x00000033, 0x00000002, 0x00040020, 0x00000036, 0x00000001, 0x0000001f, 0x0004003b,
+	0x00000036, 0x00000035, 0x00000001, 0x0004003b, 0x00000036, 0x00000037, 0x00000001, 0x00040017,
+	0x00000039, 0x0000000e, 0x00000002, 0x00040020, 0x0000003a, 0x00000001, 0x00000039, 0x0004003b,
+	0x0000003a, 0x00000038, 0x00000001, 0x00040020, 0x0000003c, 0x00000003, 0x0000001d, 0x0004003b,
+	0x0000003c, 0x0000003b, 0x00000003, 0x00030021, 0x00000040, 0x0000000e, 0x00040020, 0x00000043,
+	0x00000007, 0x0000001d, 0x00040020, 0x00000046, 0x00000002, 0x0000001e, 0x0004002b, 0x0000000e,
+	0x00000048, 0x3f800000, 0x00040020, 0x0000004c, 0x00000007, 0x0000001f, 0x00040020, 0x00000051,
+	0x00000007, 0x0000000e, 0x00040020, 0x00000055, 0x00000007, 0x00000039, 0x0004002b, 0x0000000e,
+	0x00000058, 0x3f000000, 0x0005002c, 0x00000039, 0x0000005a, 0x00000058, 0x00000058, 0x00040017,
+	0x00000060, 0x00000002, 0x00000002, 0x0005002c, 0x00000039, 0x00000062, 0x00000048, 0x00000048,
+	0x0004002b, 0x0000000e, 0x00000065, 0x00000000, 0x00040020, 0x00000067, 0x00000007, 0x00000002,
+	0x0004002b, 0x00000002, 0x00000068, 0xffffffff, 0x0004002b, 0x0000000e, 0x0000008f, 0x41100000,
+	0x00030021, 0x00000091, 0x00000019, 0x00040020, 0x0000009c, 0x00000007, 0x00000019, 0x0004002b,
+	0x00000002, 0x0000009e, 0x00000006, 0x00040020, 0x000000a1, 0x00000002, 0x0000000e, 0x00040020,
+	0x000000aa, 0x00000002, 0x00000019, 0x0004002b, 0x00000019, 0x000000ab, 0x00000001, 0x00040020,
+	0x000000b1, 0x00000007, 0x00000029, 0x00040020, 0x000000b3, 0x00000001, 0x0000001d, 0x0004003b,
+	0x000000b3, 0x000000b2, 0x00000001, 0x00040020, 0x000000b8, 0x00000002, 0x0000001d, 0x00040020,
+	0x000000bd, 0x00000002, 0x00000020, 0x0005002c, 0x00000029, 0x000000c5, 0x000000ab, 0x000000ab,
+	0x00020013, 0x000000d5, 0x00030021, 0x000000d6, 0x000000d5, 0x00040020, 0x000000dd, 0x00000000,
+	0x00000017, 0x00040017, 0x000000e9, 0x00000004, 0x00000003, 0x0004002b, 0x0000000e, 0x000000eb,
+	0x3e99999a, 0x0006002c, 0x0000001f, 0x000000ec, 0x000000eb, 0x000000eb, 0x000000eb, 0x00040020,
+	0x000000f3, 0x00000002, 0x0000001f, 0x0004002b, 0x0000000e, 0x000000f9, 0x3dcccccd, 0x0006002c,
+	0x0000001f, 0x000000fa, 0x000000f9, 0x000000f9, 0x000000f9, 0x0004002b, 0x0000000e, 0x00000106,
+	0x3e4ccccd, 0x0006002c, 0x0000001f, 0x00000107, 0x00000106, 0x00000106, 0x00000106, 0x00040020,
+	0x00000117, 0x00000002, 0x00000029, 0x0004002b, 0x00000019, 0x00000119, 0x00000000, 0x0006001e,
+	0x00000124, 0x0000001d, 0x0000001d, 0x0000001d, 0x0000001d, 0x00040020, 0x00000125, 0x00000007,
+	0x00000124, 0x00040020, 0x0000012e, 0x00000002, 0x00000024, 0x0004002b, 0x0000000e, 0x0000014f,
+	0x40800000, 0x0006002c, 0x0000001f, 0x00000186, 0x00000065, 0x00000065, 0x00000065, 0x0006002c,
+	0x0000001f, 0x000001a0, 0x00000048, 0x00000048, 0x00000048, 0x00050036, 0x0000000e, 0x0000003d,
+	0x00000000, 0x00000040, 0x000200f8, 0x00000041, 0x0004003b, 0x00000043, 0x00000042, 0x00000007,
+	0x0004003b, 0x0000004c, 0x0000004b, 0x00000007, 0x0004003b, 0x00000055, 0x00000054, 0x00000007,
+	0x0004003b, 0x00000055, 0x0000005c, 0x00000007, 0x0004003b, 0x00000051, 0x00000064, 0x00000007,
+	0x0004003b, 0x00000067, 0x00000066, 0x00000007, 0x0004003b, 0x00000067, 0x00000070, 0x00000007,
+	0x00050041, 0x00000046, 0x00000045, 0x00000022, 0x0000000c, 0x0004003d, 0x0000001e, 0x00000044,
+	0x00000045, 0x0004003d, 0x0000001f, 0x00000047, 0x00000035, 0x00050050, 0x0000001d, 0x00000049,
+	0x00000047, 0x00000048, 0x00050091, 0x0000001d, 0x0000004a, 0x00000044, 0x00000049, 0x0003003e,
+	0x00000042, 0x0000004a, 0x0004003d, 0x0000001d, 0x0000004d, 0x00000042, 0x0008004f, 0x0000001f,
+	0x0000004e, 0x0000004d, 0x0000004d, 0x00000000, 0x00000001, 0x00000002, 0x00050041, 0x00000051,
+	0x00000050, 0x00000042, 0x0000000a, 0x0004003d, 0x0000000e, 0x0000004f, 0x00000050, 0x00060050,
+	0x0000001f, 0x00000052, 0x0000004f, 0x0000004f, 0x0000004f, 0x00050088, 0x0000001f, 0x00000053,
+	0x0000004e, 0x00000052, 0x0003003e, 0x0000004b, 0x00000053, 0x0004003d, 0x0000001f, 0x00000056,
+	0x0000004b, 0x0007004f, 0x00000039, 0x00000057, 0x00000056, 0x00000056, 0x00000000, 0x00000001,
+	0x0005008e, 0x00000039, 0x00000059, 0x00000057, 0x00000058, 0x00050081, 0x00000039, 0x0000005b,
+	0x00000059, 0x0000005a, 0x0003003e, 0x00000054, 0x0000005b, 0x0004003d, 0x00000012, 0x0000005d,
+	0x00000010, 0x00040064, 0x00000011, 0x0000005e, 0x0000005d, 0x00050067, 0x00000060, 0x0000005f,
+	0x0000005e, 0x00000001, 0x0004006f, 0x00000039, 0x00000061, 0x0000005f, 0x00050088, 0x00000039,
+	0x00000063, 0x00000062, 0x00000061, 0x0003003e, 0x0000005c, 0x00000063, 0x0003003e, 0x00000064,
+	0x00000065, 0x0003003e, 0x00000066, 0x00000068, 0x000200f9, 0x00000069, 0x000200f8, 0x00000069,
+	0x000400f6, 0x0000006d, 0x0000006c, 0x00000000, 0x000200f9, 0x0000006a, 0x000200f8, 0x0000006a,
+	0x0004003d, 0x00000002, 0x0000006e, 0x00000066, 0x000500b3, 0x00000004, 0x0000006f, 0x0000006e,
+	0x00000006, 0x000400fa, 0x0000006f, 0x0000006b, 0x0000006d, 0x000200f8, 0x0000006b, 0x0003003e,
+	0x00000070, 0x00000068, 0x000200f9, 0x00000071, 0x000200f8, 0x00000071, 0x000400f6, 0x00000075,
+	0x00000074, 0x00000000, 0x000200f9, 0x00000072, 0x000200f8, 0x00000072, 0x0004003d, 0x00000002,
+	0x00000076, 0x00000070, 0x000500b3, 0x00000004, 0x00000077, 0x00000076, 0x00000006, 0x000400fa,
+	0x00000077, 0x00000073, 0x00000075, 0x000200f8, 0x00000073, 0x0004003d, 0x0000000e, 0x00000078,
+	0x00000064, 0x0004003d, 0x00000012, 0x00000079, 0x00000010, 0x0004003d, 0x00000039, 0x0000007a,
+	0x00000054, 0x0004003d, 0x00000002, 0x0000007b, 0x00000066, 0x0004003d, 0x00000002, 0x0000007c,
+	0x00000070, 0x0004006f, 0x0000000e, 0x0000007d, 0x0000007b, 0x0004006f, 0x0000000e, 0x0000007e,
+	0x0000007c, 0x00050050, 0x00000039, 0x0000007f, 0x0000007d, 0x0000007e, 0x0004003d, 0x00000039,
+	0x00000080, 0x0000005c, 0x00050085, 0x00000039, 0x00000081, 0x0000007f, 0x00000080, 0x00050081,
+	0x00000039, 0x00000082, 0x0000007a, 0x00000081, 0x00050041, 0x00000051, 0x00000084, 0x0000004b,
+	0x00000008, 0x0004003d, 0x0000000e, 0x00000083, 0x00000084, 0x00050050, 0x0000001f, 0x00000085,
+	0x00000082, 0x00000083, 0x0007004f, 0x00000039, 0x00000086, 0x00000085, 0x00000085, 0x00000000,
+	0x00000001, 0x00050051, 0x0000000e, 0x00000087, 0x00000085, 0x00000002, 0x00060059, 0x0000000e,
+	0x00000088, 0x00000079, 0x00000086, 0x00000087, 0x00050081, 0x0000000e, 0x00000089, 0x00000078,
+	0x00000088, 0x0003003e, 0x00000064, 0x00000089, 0x000200f9, 0x00000074, 0x000200f8, 0x00000074,
+	0x0004003d, 0x00000002, 0x0000008a, 0x00000070, 0x00050080, 0x00000002, 0x0000008b, 0x0000008a,
+	0x00000006, 0x0003003e, 0x00000070, 0x0000008b, 0x000200f9, 0x00000071, 0x000200f8, 0x00000075,
+	0x000200f9, 0x0000006c, 0x000200f8, 0x0000006c, 0x0004003d, 0x00000002, 0x0000008c, 0x00000066,
+	0x00050080, 0x00000002, 0x0000008d, 0x0000008c, 0x00000006, 0x0003003e, 0x00000066, 0x0000008d,
+	0x000200f9, 0x00000069, 0x000200f8, 0x0000006d, 0x0004003d, 0x0000000e, 0x0000008e, 0x00000064,
+	0x00050088, 0x0000000e, 0x00000090, 0x0000008e, 0x0000008f, 0x000200fe, 0x00000090, 0x00010038,
+	0x00050036, 0x00000019, 0x0000003e, 0x00000000, 0x00000091, 0x000200f8, 0x00000092, 0x0004003b,
+	0x00000051, 0x00000093, 0x00000007, 0x0004003b, 0x0000009c, 0x0000009b, 0x00000007, 0x0004003b,
+	0x000000b1, 0x000000b0, 0x00000007, 0x00050041, 0x00000046, 0x00000095, 0x00000022, 0x00000001,
+	0x0004003d, 0x0000001e, 0x00000094, 0x00000095, 0x0004003d, 0x0000001f, 0x00000096, 0x00000035,
+	0x00050050, 0x0000001d, 0x00000097, 0x00000096, 0x00000048, 0x00050091, 0x0000001d, 0x00000098,
+	0x00000094, 0x00000097, 0x00050051, 0x0000000e, 0x00000099, 0x00000098, 0x00000002, 0x0004007f,
+	0x0000000e, 0x0000009a, 0x00000099, 0x0003003e, 0x00000093, 0x0000009a, 0x0004003d, 0x0000000e,
+	0x0000009d, 0x00000093, 0x00060041, 0x000000a1, 0x000000a0, 0x00000022, 0x0000009e, 0x00000001,
+	0x0004003d, 0x0000000e, 0x0000009f, 0x000000a0, 0x00050088, 0x0000000e, 0x000000a2, 0x0000009d,
+	0x0000009f, 0x0006000c, 0x0000000e, 0x000000a4, 0x000000a3, 0x0000001c, 0x000000a2, 0x00060041,
+	0x000000a1, 0x000000a6, 0x00000022, 0x0000009e, 0x00000006, 0x0004003d, 0x0000000e, 0x000000a5,
+	0x000000a6, 0x00050085, 0x0000000e, 0x000000a7, 0x000000a4, 0x000000a5, 0x00060041, 0x000000aa,
+	0x000000a9, 0x00000022, 0x0000001c, 0x00000008, 0x0004003d, 0x00000019, 0x000000a8, 0x000000a9,
+	0x00050082, 0x00000019, 0x000000ac, 0x000000a8, 0x000000ab, 0x00040070, 0x0000000e, 0x000000ad,
+	0x000000ac, 0x0008000c, 0x0000000e, 0x000000ae, 0x000000a3, 0x0000002b, 0x000000a7, 0x00000065,
+	0x000000ad, 0x0004006d, 0x00000019, 0x000000af, 0x000000ae, 0x0003003e, 0x0000009b, 0x000000af,
+	0x0004003d, 0x0000001d, 0x000000b4, 0x000000b2, 0x0007004f, 0x00000039, 0x000000b5, 0x000000b4,
+	0x000000b4, 0x00000000, 0x00000001, 0x00050041, 0x000000b8, 0x000000b7, 0x00000022, 0x0000009e,
+	0x0004003d, 0x0000001d, 0x000000b6, 0x000000b7, 0x0007004f, 0x00000039, 0x000000b9, 0x000000b6,
+	0x000000b6, 0x00000002, 0x00000003, 0x00050088, 0x00000039, 0x000000ba, 0x000000b5, 0x000000b9,
+	0x00050041, 0x000000bd, 0x000000bc, 0x00000022, 0x0000001c, 0x0004003d, 0x00000020, 0x000000bb,
+	0x000000bc, 0x0007004f, 0x00000029, 0x000000be, 0x000000bb, 0x000000bb, 0x00000000, 0x00000001,
+	0x00040070, 0x00000039, 0x000000bf, 0x000000be, 0x00050085, 0x00000039, 0x000000c0, 0x000000ba,
+	0x000000bf, 0x0004006d, 0x00000029, 0x000000c1, 0x000000c0, 0x00050041, 0x000000bd, 0x000000c3,
+	0x00000022, 0x0000001c, 0x0004003d, 0x00000020, 0x000000c2, 0x000000c3, 0x0007004f, 0x00000029,
+	0x000000c4, 0x000000c2, 0x000000c2, 0x00000000, 0x00000001, 0x00050082, 0x00000029, 0x000000c6,
+	0x000000c4, 0x000000c5, 0x0007000c, 0x00000029, 0x000000c7, 0x000000a3, 0x00000026, 0x000000c1,
+	0x000000c6, 0x0003003e, 0x000000b0, 0x000000c7, 0x0004003d, 0x00000019, 0x000000c8, 0x0000009b,
+	0x00060041, 0x000000aa, 0x000000ca, 0x00000022, 0x0000001c, 0x00000006, 0x0004003d, 0x00000019,
+	0x000000c9, 0x000000ca, 0x00050084, 0x00000019, 0x000000cb, 0x000000c8, 0x000000c9, 0x00050041,
+	0x0000009c, 0x000000cd, 0x000000b0, 0x00000006, 0x0004003d, 0x00000019, 0x000000cc, 0x000000cd,
+	0x00050080, 0x00000019, 0x000000ce, 0x000000cb, 0x000000cc, 0x00060041, 0x000000aa, 0x000000d0,
+	0x00000022, 0x0000001c, 0x00000001, 0x0004003d, 0x00000019, 0x000000cf, 0x000000d0, 0x00050084,
+	0x00000019, 0x000000d1, 0x000000ce, 0x000000cf, 0x00050041, 0x0000009c, 0x000000d3, 0x000000b0,
+	0x00000001, 0x0004003d, 0x00000019, 0x000000d2, 0x000000d3, 0x00050080, 0x00000019, 0x000000d4,
+	0x000000d1, 0x000000d2, 0x000200fe, 0x000000d4, 0x00010038, 0x00050036, 0x000000d5, 0x0000003f,
+	0x00000000, 0x000000d6, 0x000200f8, 0x000000d7, 0x0004003b, 0x0000004c, 0x000000d8, 0x00000007,
+	0x0004003b, 0x0000004c, 0x000000ed, 0x00000007, 0x0004003b, 0x0000004c, 0x000000f0, 0x00000007,
+	0x0004003b, 0x0000004c, 0x000000f8, 0x00000007, 0x0004003b, 0x0000004c, 0x0000010c, 0x00000007,
+	0x0004003b, 0x000000b1, 0x00000113, 0x00000007, 0x0004003b, 0x0000009c, 0x00000118, 0x00000007,
+	0x0004003b, 0x00000125, 0x00000123, 0x00000007, 0x0004003b, 0x0000004c, 0x00000134, 0x00000007,
+	0x0004003b, 0x00000051, 0x0000013a, 0x00000007, 0x0004003b, 0x0000004c, 0x0000013d, 0x00000007,
+	0x0004003b, 0x00000051, 0x00000142, 0x00000007, 0x0004003b, 0x00000051, 0x0000014a, 0x00000007,
+	0x0004003b, 0x0000004c, 0x00000153, 0x00000007, 0x0004003b, 0x00000051, 0x00000162, 0x00000007,
+	0x0004003b, 0x0000004c, 0x0000017e, 0x00000007, 0x0004003b, 0x0000004c, 0x00000185, 0x00000007,
+	0x0004003b, 0x0000004c, 0x00000189, 0x00000007, 0x00050041, 0x000000aa, 0x000000da, 0x00000033,
+	0x0000000c, 0x0004003d, 0x00000019, 0x000000d9, 0x000000da, 0x00050041, 0x000000dd, 0x000000dc,
+	0x00000015, 0x000000d9, 0x0004003d, 0x00000017, 0x000000db, 0x000000dc, 0x0004003d, 0x00000039,
+	0x000000de, 0x00000038, 0x00050057, 0x0000001d, 0x000000df, 0x000000db, 0x000000de, 0x0008004f,
+	0x0000001f, 0x000000e0, 0x000000df, 0x000000df, 0x00000000, 0x00000001, 0x00000002, 0x00050041,
+	0x000000b8, 0x000000e2, 0x00000033, 0x00000008, 0x0004003d, 0x0000001d, 0x000000e1, 0x000000e2,
+	0x0008004f, 0x0000001f, 0x000000e3, 0x000000e1, 0x000000e1, 0x00000000, 0x00000001, 0x00000002,
+	0x00050085, 0x0000001f, 0x000000e4, 0x000000e0, 0x000000e3, 0x00050041, 0x000000b8, 0x000000e6,
+	0x00000033, 0x00000008, 0x0004003d, 0x0000001d, 0x000000e5, 0x000000e6, 0x0008004f, 0x0000001f,
+	0x000000e7, 0x000000e5, 0x000000e5, 0x00000000, 0x00000001, 0x00000002, 0x00060050, 0x000000e9,
+	0x000000e8, 0x00000005, 0x00000005, 0x00000005, 0x000600a9, 0x0000001f, 0x000000ea, 0x000000e8,
+	0x000000e4, 0x000000e7, 0x0003003e, 0x000000d8, 0x000000ea, 0x0004003d, 0x0000001f, 0x000000ee,
+	0x00000037, 0x0006000c, 0x0000001f, 0x000000ef, 0x000000a3, 0x00000045, 0x000000ee, 0x0003003e,
+	0x000000ed, 0x000000ef, 0x00050041, 0x000000f3, 0x000000f2, 0x00000022, 0x0000000a, 0x0004003d,
+	0x0000001f, 0x000000f1, 0x000000f2, 0x0008004f, 0x0000001f, 0x000000f4, 0x000000f1, 0x000000f1,
+	0x00000000, 0x00000001, 0x00000002, 0x0004003d, 0x0000001f, 0x000000f5, 0x00000035, 0x00050083,
+	0x0000001f, 0x000000f6, 0x000000f4, 0x000000f5, 0x0006000c, 0x0000001f, 0x000000f7, 0x000000a3,
+	0x00000045, 0x000000f6, 0x0003003e, 0x000000f0, 0x000000f7, 0x00050041, 0x00000051, 0x000000fc,
+	0x000000ed, 0x00000006, 0x0004003d, 0x0000000e, 0x000000fb, 0x000000fc, 0x00050081, 0x0000000e,
+	0x000000fd, 0x00000048, 0x000000fb, 0x0005008e, 0x0000001f, 0x000000fe, 0x000000fa, 0x000000fd,
+	0x00050041, 0x00000051, 0x00000100, 0x000000ed, 0x00000006, 0x0004003d, 0x0000000e, 0x000000ff,
+	0x00000100, 0x00050083, 0x0000000e, 0x00000101, 0x00000048, 0x000000ff, 0x0005008e, 0x0000001f,
+	0x00000102, 0x000000ec, 0x00000101, 0x00050081, 0x0000001f, 0x00000103, 0x000000fe, 0x00000102,
+	0x0004003d, 0x0000001f, 0x00000104, 0x000000d8, 0x00050085, 0x0000001f, 0x00000105, 0x00000103,
+	0x00000104, 0x0004003d, 0x0000001f, 0x00000108, 0x000000d8, 0x00050085, 0x0000001f, 0x00000109,
+	0x00000107, 0x00000108, 0x00060050, 0x000000e9, 0x0000010a, 0x0000000b, 0x0000000b, 0x0000000b,
+	0x000600a9, 0x0000001f, 0x0000010b, 0x0000010a, 0x00000105, 0x00000109, 0x0003003e, 0x000000f8,
+	0x0000010b, 0x0004003d, 0x0000001f, 0x0000010d, 0x000000f8, 0x00050041, 0x000000f3, 0x0000010f,
+	0x00000022, 0x00000008, 0x0004003d, 0x0000001f, 0x0000010e, 0x0000010f, 0x00050085, 0x0000001f,
+	0x00000110, 0x0000010d, 0x0000010e, 0x0003003e, 0x0000010c, 0x00000110, 0x000300f7, 0x00000112,
+	0x00000000, 0x000400fa, 0x00000007, 0x00000111, 0x00000112, 0x000200f8, 0x00000111, 0x00040039,
+	0x00000019, 0x00000114, 0x0000003e, 0x00060041, 0x00000117, 0x00000116, 0x0000002c, 0x00000001,
+	0x00000114, 0x0004003d, 0x00000029, 0x00000115, 0x00000116, 0x0003003e, 0x00000113, 0x00000115,
+	0x0003003e, 0x00000118, 0x00000119, 0x000200f9, 0x0000011a, 0x000200f8, 0x0000011a, 0x000400f6,
+	0x0000011e, 0x0000011d, 0x00000000, 0x000200f9, 0x0000011b, 0x000200f8, 0x0000011b, 0x0004003d,
+	0x00000019, 0x0000011f, 0x00000118, 0x00050041, 0x0000009c, 0x00000121, 0x00000113, 0x00000006,
+	0x0004003d, 0x00000019, 0x00000120, 0x00000121, 0x000500b0, 0x00000004, 0x00000122, 0x0000011f,
+	0x00000120, 0x000400fa, 0x00000122, 0x0000011c, 0x0000011e, 0x000200f8, 0x0000011c, 0x00050041,
+	0x0000009c, 0x00000127, 0x00000113, 0x00000001, 0x0004003d, 0x00000019, 0x00000126, 0x00000127,
+	0x0004003d, 0x00000019, 0x00000128, 0x00000118, 0x00050080, 0x00000019, 0x00000129, 0x00000126,
+	0x00000128, 0x00060041, 0x000000aa, 0x0000012b, 0x00000030, 0x00000001, 0x00000129, 0x0004003d,
+	0x00000019, 0x0000012a, 0x0000012b, 0x00060041, 0x0000012e, 0x0000012d, 0x00000027, 0x00000001,
+	0x0000012a, 0x0004003d, 0x00000024, 0x0000012c, 0x0000012d, 0x00050051, 0x0000001d, 0x0000012f,
+	0x0000012c, 0x00000000, 0x00050051, 0x0000001d, 0x00000130, 0x0000012c, 0x00000001, 0x00050051,
+	0x0000001d, 0x00000131, 0x0000012c, 0x00000002, 0x00050051, 0x0000001d, 0x00000132, 0x0000012c,
+	0x00000003, 0x00070050, 0x00000124, 0x00000133, 0x0000012f, 0x00000130, 0x00000131, 0x00000132,
+	0x0003003e, 0x00000123, 0x00000133, 0x00050041, 0x00000043, 0x00000136, 0x00000123, 0x00000001,
+	0x0004003d, 0x0000001d, 0x00000135, 0x00000136, 0x0008004f, 0x0000001f, 0x00000137, 0x00000135,
+	0x00000135, 0x00000000, 0x00000001, 0x00000002, 0x0004003d, 0x0000001f, 0x00000138, 0x00000035,
+	0x00050083, 0x0000001f, 0x00000139, 0x00000137, 0x00000138, 0x0003003e, 0x00000134, 0x00000139,
+	0x0004003d, 0x0000001f, 0x0000013b, 0x00000134, 0x0006000c, 0x0000000e, 0x0000013c, 0x000000a3,
+	0x00000042, 0x0000013b, 0x0003003e, 0x0000013a, 0x0000013c, 0x0004003d, 0x0000001f, 0x0000013e,
+	0x00000134, 0x0004003d, 0x0000000e, 0x0000013f, 0x0000013a, 0x00060050, 0x0000001f, 0x00000140,
+	0x0000013f, 0x0000013f, 0x0000013f, 0x00050088, 0x0000001f, 0x00000141, 0x0000013e, 0x00000140,
+	0x0003003e, 0x0000013d, 0x00000141, 0x00060041, 0x00000051, 0x00000144, 0x00000123, 0x0000000a,
+	0x00000006, 0x0004003d, 0x0000000e, 0x00000143, 0x00000144, 0x0004003d, 0x0000000e, 0x00000145,
+	0x0000013a, 0x00050088, 0x0000000e, 0x00000146, 0x00000143, 0x00000145, 0x00060041, 0x00000051,
+	0x00000148, 0x00000123, 0x0000000a, 0x00000008, 0x0004003d, 0x0000000e, 0x00000147, 0x00000148,
+	0x0007000c, 0x0000000e, 0x00000149, 0x000000a3, 0x0000001a, 0x00000146, 0x00000147, 0x0003003e,
+	0x00000142, 0x00000149, 0x0004003d, 0x0000000e, 0x0000014b, 0x0000013a, 0x00060041, 0x00000051,
+	0x0000014d, 0x00000123, 0x00000001, 0x0000000a, 0x0004003d, 0x0000000e, 0x0000014c, 0x0000014d,
+	0x00050088, 0x0000000e, 0x0000014e, 0x0000014b, 0x0000014c, 0x0007000c, 0x0000000e, 0x00000150,
+	0x000000a3, 0x0000001a, 0x0000014e, 0x0000014f, 0x00050083, 0x0000000e, 0x00000151, 0x00000048,
+	0x00000150, 0x0008000c, 0x0000000e, 0x00000152, 0x000000a3, 0x0000002b, 0x00000151, 0x00000065,
+	0x00000048, 0x0003003e, 0x0000014a, 0x00000152, 0x00050041, 0x00000043, 0x00000155, 0x00000123,
+	0x00000006, 0x0004003d, 0x0000001d, 0x00000154, 0x00000155, 0x0008004f, 0x0000001f, 0x00000156,
+	0x00000154, 0x00000154, 0x00000000, 0x00000001, 0x00000002, 0x0004003d, 0x0000000e, 0x00000157,
+	0x00000142, 0x0005008e, 0x0000001f, 0x00000158, 0x00000156, 0x00000157, 0x0004003d, 0x0000000e,
+	0x00000159, 0x0000014a, 0x0005008e, 0x0000001f, 0x0000015a, 0x00000158, 0x00000159, 0x0004003d,
+	0x0000000e, 0x0000015b, 0x0000014a, 0x0005008e, 0x0000001f, 0x0000015c, 0x0000015a, 0x0000015b,
+	0x0003003e, 0x00000153, 0x0000015c, 0x00060041, 0x00000051, 0x0000015e, 0x00000123, 0x00000006,
+	0x0000000a, 0x0004003d, 0x0000000e, 0x0000015d, 0x0000015e, 0x000500b4, 0x00000004, 0x0000015f,
+	0x0000015d, 0x00000048, 0x000300f7, 0x00000161, 0x00000000, 0x000400fa, 0x0000015f, 0x00000160,
+	0x00000161, 0x000200f8, 0x00000160, 0x00050041, 0x00000043, 0x00000164, 0x00000123, 0x00000008,
+	0x0004003d, 0x0000001d, 0x00000163, 0x00000164, 0x0008004f, 0x0000001f, 0x00000165, 0x00000163,
+	0x00000163, 0x00000000, 0x00000001, 0x00000002, 0x0004007f, 0x0000001f, 0x00000166, 0x00000165,
+	0x0004003d, 0x0000001f, 0x00000167, 0x0000013d, 0x00050094, 0x0000000e, 0x00000168, 0x00000166,
+	0x00000167, 0x00060041, 0x00000051, 0x0000016a, 0x00000123, 0x00000008, 0x0000000a, 0x0004003d,
+	0x0000000e, 0x00000169, 0x0000016a, 0x00050083, 0x0000000e, 0x0000016b, 0x00000168, 0x00000169,
+	0x00060041, 0x00000051, 0x0000016d, 0x00000123, 0x0000000a, 0x00000001, 0x0004003d, 0x0000000e,
+	0x0000016c, 0x0000016d, 0x00060041, 0x00000051, 0x0000016f, 0x00000123, 0x00000008, 0x0000000a,
+	0x0004003d, 0x0000000e, 0x0000016e, 0x0000016f, 0x00050083, 0x0000000e, 0x00000170, 0x0000016c,
+	0x0000016e, 0x00050088, 0x0000000e, 0x00000171, 0x0000016b, 0x00000170, 0x0008000c, 0x0000000e,
+	0x00000172, 0x000000a3, 0x0000002b, 0x00000171, 0x00000065, 0x00000048, 0x0003003e, 0x00000162,
+	0x00000172, 0x0004003d, 0x0000001f, 0x00000173, 0x00000153, 0x0004003d, 0x0000000e, 0x00000174,
+	0x00000162, 0x0005008e, 0x0000001f, 0x00000175, 0x00000173, 0x00000174, 0x0003003e, 0x00000153,
+	0x00000175, 0x000200f9, 0x00000161, 0x000200f8, 0x00000161, 0x00060041, 0x00000051, 0x00000177,
+	0x00000123, 0x0000000a, 0x0000000a, 0x0004003d, 0x0000000e, 0x00000176, 0x00000177, 0x000500b4,
+	0x00000004, 0x00000178, 0x00000176, 0x00000048, 0x000300f7, 0x0000017a, 0x00000000, 0x000400fa,
+	0x00000178, 0x00000179, 0x0000017a, 0x000200f8, 0x00000179, 0x0004003d, 0x0000001f, 0x0000017b,
+	0x00000153, 0x00040039, 0x0000000e, 0x0000017c, 0x0000003d, 0x0005008e, 0x0000001f, 0x0000017d,
+	0x0000017b, 0x0000017c, 0x0003003e, 0x00000153, 0x0000017d, 0x000200f9, 0x0000017a, 0x000200f8,
+	0x0000017a, 0x0004003d, 0x0000001f, 0x0000017f, 0x000000d8, 0x0004003d, 0x0000001f, 0x00000180,
+	0x000000ed, 0x0004003d, 0x0000001f, 0x00000181, 0x0000013d, 0x00050094, 0x0000000e, 0x00000182,
+	0x00000180, 0x00000181, 0x0007000c, 0x0000000e, 0x00000183, 0x000000a3, 0x00000028, 0x00000182,
+	0x00000065, 0x0005008e, 0x0000001f, 0x00000184, 0x0000017f, 0x00000183, 0x0003003e, 0x0000017e,
+	0x00000184, 0x0003003e, 0x00000185, 0x00000186, 0x000300f7, 0x00000188, 0x00000000, 0x000400fa,
+	0x00000009, 0x00000187, 0x00000188, 0x000200f8, 0x00000187, 0x0004003d, 0x0000001f, 0x0000018a,
+	0x0000013d, 0x0004003d, 0x0000001f, 0x0000018b, 0x000000ed, 0x0007000c, 0x0000001f, 0x0000018c,
+	0x000000a3, 0x00000047, 0x0000018a, 0x0000018b, 0x0004007f, 0x0000001f, 0x0000018d, 0x0000018c,
+	0x0003003e, 0x00000189, 0x0000018d, 0x0004003d, 0x0000001f, 0x0000018e, 0x000000f0, 0x0004003d,
+	0x0000001f, 0x0000018f, 0x00000189, 0x00050094, 0x0000000e, 0x00000190, 0x0000018e, 0x0000018f,
+	0x0007000c, 0x0000000e, 0x00000191, 0x000000a3, 0x00000028, 0x00000190, 0x00000065, 0x0007000c,
+	0x0000000e, 0x00000192, 0x000000a3, 0x0000001a, 0x00000191, 0x0000000f, 0x0005008e, 0x0000001f,
+	0x00000193, 0x000000ec, 0x00000192, 0x0003003e, 0x00000185, 0x00000193, 0x000200f9, 0x00000188,
+	0x000200f8, 0x00000188, 0x0004003d, 0x0000001f, 0x00000194, 0x0000010c, 0x0004003d, 0x0000001f,
+	0x00000195, 0x0000017e, 0x0004003d, 0x0000001f, 0x00000196, 0x00000185, 0x00050081, 0x0000001f,
+	0x00000197, 0x00000195, 0x00000196, 0x0004003d, 0x0000001f, 0x00000198, 0x000000f8, 0x00050081,
+	0x0000001f, 0x00000199, 0x00000197, 0x00000198, 0x0004003d, 0x0000001f, 0x0000019a, 0x00000153,
+	0x00050085, 0x0000001f, 0x0000019b, 0x00000199, 0x0000019a, 0x00050081, 0x0000001f, 0x0000019c,
+	0x00000194, 0x0000019b, 0x0003003e, 0x0000010c, 0x0000019c, 0x000200f9, 0x0000011d, 0x000200f8,
+	0x0000011d, 0x0004003d, 0x00000019, 0x0000019d, 0x00000118, 0x00050080, 0x00000019, 0x0000019e,
+	0x0000019d, 0x000000ab, 0x0003003e, 0x00000118, 0x0000019e, 0x000200f9, 0x0000011a, 0x000200f8,
+	0x0000011e, 0x000200f9, 0x00000112, 0x000200f8, 0x00000112, 0x0004003d, 0x0000001f, 0x0000019f,
+	0x0000010c, 0x0008000c, 0x0000001f, 0x000001a1, 0x000000a3, 0x0000002b, 0x0000019f, 0x00000186,
+	0x000001a0, 0x00060041, 0x000000a1, 0x000001a3, 0x00000033, 0x00000008, 0x0000000a, 0x0004003d,
+	0x0000000e, 0x000001a2, 0x000001a3, 0x00050050, 0x0000001d, 0x000001a4, 0x000001a1, 0x000001a2,
+	0x0003003e, 0x0000003b, 0x000001a4, 0x000100fd, 0x00010038,
+};
+
+constexpr uint32_t vert_spv[] = {
+	0x07230203, 0x00010000, 0x00000000, 0x00000041, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+	0x00000000, 0x00000001, 0x000c000f, 0x00000000, 0x0000001b, 0x6e69616d, 0x00000000, 0x0000000e,
+	0x00000011, 0x00000012, 0x00000016, 0x00000018, 0x00000019, 0x0000001f, 0x00030003, 0x00000002,
+	0x000001c2, 0x00090005, 0x00000004, 0x626f6c67, 0x6e556c61, 0x726f6669, 0x6675426d, 0x4f726566,
+	0x63656a62, 0x00000074, 0x00050006, 0x00000004, 0x00000000, 0x77656976, 0x00000000, 0x00050006,
+	0x00000004, 0x00000001, 0x6a6f7270, 0x00000000, 0x00040005, 0x00000005, 0x6f627567, 0x00000000,
+	0x00070005, 0x0000000a, 0x66696e55, 0x426d726f, 0x65666675, 0x6a624f72, 0x00746365, 0x00050006,
+	0x0000000a, 0x00000000, 0x65646f6d, 0x0000006c, 0x00070006, 0x0000000a, 0x00000001, 0x6d726f6e,
+	0x614d6c61, 0x78697274, 0x00000000, 0x00050006, 0x0000000a, 0x00000002, 0x6f6c6f63, 0x00000072,
+	0x00060006, 0x0000000a, 0x00000003, 0x656c6573, 0x64657463, 0x00000000, 0x00070006, 0x0000000a,
+	0x00000004, 0x74786574, 0x49657275, 0x7865646e, 0x00000000, 0x00030005, 0x0000000b, 0x006f6275,
+	0x00030005, 0x0000000e, 0x00736f70, 0x00040005, 0x00000011, 0x6d726f6e, 0x00000000, 0x00050005,
+	0x00000012, 0x43786574, 0x64726f6f, 0x00000000, 0x00040005, 0x00000016, 0x67617266, 0x00736f50,
+	0x00050005, 0x00000018, 0x67617266, 0x6d726f4e, 0x00000000, 0x00060005, 0x00000019, 0x67617266,
+	0x43786554, 0x64726f6f, 0x00000000, 0x00040005, 0x0000001b, 0x6e69616d, 0x00000000, 0x00050005,
+	0x0000001f, 0x505f6c67, 0x7469736f, 0x006e6f69, 0x00050048, 0x00000004, 0x00000000, 0x00000023,
+	0x00000000, 0x00040048, 0x00000004, 0x00000000, 0x00000005, 0x00050048, 0x00000004, 0x00000000,
+	0x00000007, 0x00000010, 0x00050048, 0x00000004, 0x00000001, 0x00000023, 0x00000040, 0x00040048,
+	0x00000004, 0x00000001, 0x00000005, 0x00050048, 0x00000004, 0x00000001, 0x00000007, 0x00000010,
+	0x00030047, 0x00000004, 0x00000002, 0x00040047, 0x00000005, 0x00000022, 0x00000000, 0x00040047,
+	0x00000005, 0x00000021, 0x00000000, 0x00050048, 0x0000000a, 0x00000000, 0x00000023, 0x00000000,
+	0x00040048, 0x0000000a, 0x00000000, 0x00000005, 0x00050048, 0x0000000a, 0x00000000, 0x00000007,
+	0x00000010, 0x00050048, 0x0000000a, 0x00000001, 0x00000023, 0x00000040, 0x00040048, 0x0000000a,
+	0x00000001, 0x00000005, 0x00050048, 0x0000000a, 0x00000001, 0x00000007, 0x00000010, 0x00050048,
+	0x0000000a, 0x00000002, 0x00000023, 0x00000080, 0x00050048, 0x0000000a, 0x00000003, 0x00000023,
+	0x00000090, 0x00050048, 0x0000000a, 0x00000004, 0x00000023, 0x00000094, 0x00030047, 0x0000000a,
+	0x00000002, 0x00040047, 0x0000000b, 0x00000022, 0x00000001, 0x00040047, 0x0000000b, 0x00000021,
+	0x00000000, 0x00040047, 0x0000000e, 0x0000001e, 0x00000000, 0x00040047, 0x00000011, 0x0000001e,
+	0x00000001, 0x00040047, 0x00000012, 0x0000001e, 0x00000002, 0x00040047, 0x00000016, 0x0000001e,
+	0x00000000, 0x00040047, 0x00000018, 0x0000001e, 0x00000001, 0x00040047, 0x00000019, 0x0000001e,
+	0x00000002, 0x00040047, 0x0000001f, 0x0000000b, 0x00000000, 0x00030016, 0x00000001, 0x00000020,
+	0x00040017, 0x00000002, 0x00000001, 0x00000004, 0x00040018, 0x00000003, 0x00000002, 0x00000004,
+	0x0004001e, 0x00000004, 0x00000003, 0x00000003, 0x00040020, 0x00000006, 0x00000002, 0x00000004,
+	0x0004003b, 0x00000006, 0x00000005, 0x00000002, 0x00040015, 0x00000008, 0x00000020, 0x00000001,
+	0x0004002b, 0x00000008, 0x00000007, 0x00000000, 0x00040015, 0x00000009, 0x00000020, 0x00000000,
+	0x0007001e, 0x0000000a, 0x00000003, 0x00000003, 0x00000002, 0x00000001, 0x00000009, 0x00040020,
+	0x0000000c, 0x00000002, 0x0000000a, 0x0004003b, 0x0000000c, 0x0000000b, 0x00000002, 0x0004002b,
+	0x00000008, 0x0000000d, 0x00000001, 0x00040017, 0x0000000f, 0x00000001, 0x00000003, 0x00040020,
+	0x00000010, 0x00000001, 0x0000000f, 0x0004003b, 0x00000010, 0x0000000e, 0x00000001, 0x0004003b,
+	0x00000010, 0x00000011, 0x00000001, 0x00040017, 0x00000013, 0x00000001, 0x00000002, 0x00040020,
+	0x00000014, 0x00000001, 0x00000013, 0x0004003b, 0x00000014, 0x00000012, 0x00000001, 0x0004002b,
+	0x00000008, 0x00000015, 0x00000002, 0x00040020, 0x00000017, 0x00000003, 0x0000000f, 0x0004003b,
+	0x00000017, 0x00000016, 0x00000003, 0x0004003b, 0x00000017, 0x00000018, 0x00000003, 0x00040020,
+	0x0000001a, 0x00000003, 0x00000013, 0x0004003b, 0x0000001a, 0x00000019, 0x00000003, 0x00020013,
+	0x0000001c, 0x00030021, 0x0000001d, 0x0000001c, 0x00040020, 0x00000020, 0x00000003, 0x00000002,
+	0x0004003b, 0x00000020, 0x0000001f, 0x00000003, 0x00040020, 0x00000023, 0x00000002, 0x00000003,
+	0x0004002b, 0x00000001, 0x0000002b, 0x3f800000, 0x00040018, 0x0000003d, 0x0000000f, 0x00000003,
+	0x00050036, 0x0000001c, 0x0000001b, 0x00000000, 0x0000001d, 0x000200f8, 0x0000001e, 0x00050041,
+	0x00000023, 0x00000022, 0x00000005, 0x0000000d, 0x0004003d, 0x00000003, 0x00000021, 0x00000022,
+	0x00050041, 0x00000023, 0x00000025, 0x00000005, 0x00000007, 0x0004003d, 0x00000003, 0x00000024,
+	0x00000025, 0x00050092, 0x00000003, 0x00000026, 0x00000021, 0x00000024, 0x00050041, 0x00000023,
+	0x00000028, 0x0000000b, 0x00000007, 0x0004003d, 0x00000003, 0x00000027, 0x00000028, 0x00050092,
+	0x00000003, 0x00000029, 0x00000026, 0x00000027, 0x0004003d, 0x0000000f, 0x0000002a, 0x0000000e,
+	0x00050050, 0x00000002, 0x0000002c, 0x0000002a, 0x0000002b, 0x00050091, 0x00000002, 0x0000002d,
+	0x00000029, 0x0000002c, 0x0003003e, 0x0000001f, 0x0000002d, 0x00050041, 0x00000023, 0x0000002f,
+	0x0000000b, 0x00000007, 0x0004003d, 0x00000003, 0x0000002e, 0x0000002f, 0x0004003d, 0x0000000f,
+	0x00000030, 0x0000000e, 0x00050050, 0x00000002, 0x00000031, 0x00000030, 0x0000002b, 0x00050091,
+	0x00000002, 0x00000032, 0x0000002e, 0x00000031, 0x0008004f, 0x0000000f, 0x00000033, 0x00000032,
+	0x00000032, 0x00000000, 0x00000001, 0x00000002, 0x0003003e, 0x00000016, 0x00000033, 0x00050041,
+	0x00000023, 0x00000035, 0x0000000b, 0x0000000d, 0x0004003d, 0x00000003, 0x00000034, 0x00000035,
+	0x00050051, 0x00000002, 0x00000036, 0x00000034, 0x00000000, 0x0008004f, 0x0000000f, 0x00000037,
+	0x00000036, 0x00000036, 0x00000000, 0x00000001, 0x00000002, 0x00050051, 0x00000002, 0x00000038,
+	0x00000034, 0x00000001, 0x0008004f, 0x0000000f, 0x00000039, 0x00000038, 0x00000038, 0x00000000,
+	0x00000001, 0x00000002, 0x00050051, 0x00000002, 0x0000003a, 0x00000034, 0x00000002, 0x0008004f,
+	0x0000000f, 0x0000003b, 0x0000003a, 0x0000003a, 0x00000000, 0x00000001, 0x00000002, 0x00060050,
+	0x0000003d, 0x0000003c, 0x00000037, 0x00000039, 0x0000003b, 0x0004003d, 0x0000000f, 0x0000003e,
+	0x00000011, 0x00050091, 0x0000000f, 0x0000003f, 0x0000003c, 0x0000003e, 0x0003003e, 0x00000018,
+	0x0000003f, 0x0004003d, 0x00000013, 0x00000040, 0x00000012, 0x0003003e, 0x00000019, 0x00000040,
+	0x000100fd, 0x00010038,
+};
+
+struct File {
+	const char *path;		// as passed to ReadAssetFile
+	const uint32_t *data;
+	size_t size;			// in bytes
+};
+
+constexpr File FILES[] = {
+	{ "shaders/HiZReduceComp.spv", HiZReduceComp_spv, sizeof(HiZReduceComp_spv) },
+	{ "shaders/OcclusionCullComp.spv", OcclusionCullComp_spv, sizeof(OcclusionCullComp_spv) },
+	{ "shaders/ShadowFrag.spv", ShadowFrag_spv, sizeof(ShadowFrag_spv) },
+	{ "shaders/ShadowVert.spv", ShadowVert_spv, sizeof(ShadowVert_spv) },
+	{ "shaders/SkyBoxFrag.spv", SkyBoxFrag_spv, sizeof(SkyBoxFrag_spv) },
+	{ "shaders/SkyBoxVert.spv", SkyBoxVert_spv, sizeof(SkyBoxVert_spv) },
+	{ "shaders/WireframeFrag.spv", WireframeFrag_spv, sizeof(WireframeFrag_spv) },
+	{ "shaders/WireframeVert.spv", WireframeVert_spv, sizeof(WireframeVert_spv) },
+	{ "shaders/frag.spv", frag_spv, sizeof(frag_spv) },
+	{ "shaders/vert.spv", vert_spv, sizeof(vert_spv) },
+};
+
+}
@@ -0,0 +1,5 @@
+#version 450
+
+// depth only: the shadow map has no color attachment
+void main() {
+}
@@ -0,0 +1,25 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform globalUniformBufferObject {
+	mat4 view;
+	mat4 proj;
+	vec3 ambientLight;
+	vec3 eyePos;
+	mat4 lightViewProj;
+} gubo;
+
+layout(set = 1, binding = 0) uniform UniformBufferObject {
+	mat4 model;
+	mat4 normalMatrix;
+	vec4 color;
+	float selected;
+	uint textureIndex;
+} ubo;
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec3 norm;
+layout(location = 2) in vec2 texCoord;
+
+void main() {
+	gl_Position = gubo.lightViewProj * ubo.model * vec4(pos, 1.0);
+}
@@ -10,13 +10,21 @@ layout(set = 1, binding = 0) uniform WireframeUniformBufferObject {
 	vec4 color;
 } ubo;
 
+// pixels on each side of an edge: the lines are 2 pixels wide between two triangles
+const float EDGE_HALF_WIDTH = 1.0;
 
 layout(location = 0) in vec3 fragPos;
-layout(location = 1) in vec3 fragNorm;
+layout(location = 1) in vec3 fragBarycentric;
 layout(location = 2) in vec2 fragTexCoord;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
+	// a coordinate is 0 on the opposite edge (hidden edges never get there):
+	// divided by its screen derivative it is the distance in pixels
+	vec3 pixels = fragBarycentric / max(fwidth(fragBarycentric), vec3(1e-6));
+	if (min(min(pixels.x, pixels.y), pixels.z) > EDGE_HALF_WIDTH) {
+		discard;
+	}
     outColor = ubo.color;
-}
\ No newline at end of file
+}
@@ -11,16 +11,16 @@ layout(set = 1, binding = 0) uniform WireframeUniformBufferObject {
 } ubo;
 
 layout(location = 0) in vec3 pos;
-layout(location = 1) in vec3 norm;
+layout(location = 1) in vec3 norm;		// barycentric coordinates, see MakeWireframeMesh
 layout(location = 2) in vec2 texCoord;
 
 layout(location = 0) out vec3 fragPos;
-layout(location = 1) out vec3 fragNorm;
+layout(location = 1) out vec3 fragBarycentric;
 layout(location = 2) out vec2 fragTexCoord;
 
 void main() {
 	gl_Position = gubo.proj * gubo.view * ubo.model * vec4(pos, 1.0);
 	fragPos  = (ubo.model * vec4(pos,  1.0)).xyz;
-	fragNorm     = (ubo.model * vec4(norm, 0.0)).xyz;
+	fragBarycentric = norm;
 	fragTexCoord = texCoord;
-}
\ No newline at end of file
+}
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""Compiles the GLSL shaders of this folder to the .spv files loaded by the game.
+
+Needs glslc and spirv-val (both from the Vulkan SDK) in the PATH, or in the
+GLSLC and SPIRV_VAL environment variables. Every module is validated before
+EmbeddedShaders.hpp is regenerated, so rebuild the game afterwards.
+Run it from any directory: python3 compile_shaders.py
+"""
+import os
+import subprocess
+import sys
+
+import embed_shaders
+
+# source -> SPIR-V file name, as referenced by MyProject.cpp
+SHADERS = {
+    "shader.vert": "vert.spv",
+    "shader.frag": "frag.spv",
+    "SkyBoxShader.vert": "SkyBoxVert.spv",
+    "SkyBoxShader.frag": "SkyBoxFrag.spv",
+    "WireframeShader.vert": "WireframeVert.spv",
+    "WireframeShader.frag": "WireframeFrag.spv",
+    "ShadowShader.vert": "ShadowVert.spv",
+    "ShadowShader.frag": "ShadowFrag.spv",
+    "HiZReduce.comp": "HiZReduceComp.spv",
+    "OcclusionCull.comp": "OcclusionCullComp.spv",
+}
+
+
+def main():
+    glslc = os.environ.get("GLSLC", "glslc")
+    spirv_val = os.environ.get("SPIRV_VAL", "spirv-val")
+    here = os.path.dirname(os.path.abspath(__file__))
+    failed = False
+    for source, output in SHADERS.items():
+        cmd = [glslc, "-O", os.path.join(here, source), "-o", os.path.join(here, output)]
+        print(" ".join(cmd))
+        if subprocess.call(cmd) != 0:
+            failed = True
+            continue
+        cmd = [spirv_val, "--target-env", "vulkan1.0", os.path.join(here, output)]
+        print(" ".join(cmd))
+        if subprocess.call(cmd) != 0:
+            failed = True
+    if failed:
+        return 1
+    # the game reads the embedded copies first
+    return embed_shaders.main()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
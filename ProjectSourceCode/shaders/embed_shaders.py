@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Writes EmbeddedShaders.hpp: the .spv files of this folder as constexpr
+uint32_t arrays, compiled into the game and found by ReadAssetFile before the
+files on disk. Run it after regenerating the .spv files (compile_shaders.py
+does it automatically).
+"""
+import os
+import struct
+import sys
+
+HEADER = "EmbeddedShaders.hpp"
+WORDS_PER_LINE = 8
+
+
+def identifier(file_name):
+    return "".join(c if c.isalnum() else "_" for c in file_name)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    spv_files = sorted(f for f in os.listdir(here) if f.endswith(".spv"))
+
+    out = [
+        "// Generated by shaders/embed_shaders.py from the .spv files of this folder, do not edit",
+        "#pragma once",
+        "",
+        "#include <cstddef>",
+        "#include <cstdint>",
+        "",
+        "namespace embedded {",
+        "",
+    ]
+    for f in spv_files:
+        with open(os.path.join(here, f), "rb") as spv:
+            data = spv.read()
+        if len(data) % 4 != 0:
+            print("%s: size is not a multiple of 4, not a SPIR-V module" % f)
+            return 1
+        words = struct.unpack("<%dI" % (len(data) // 4), data)
+        out.append("constexpr uint32_t %s[] = {" % identifier(f))
+        for i in range(0, len(words), WORDS_PER_LINE):
+            line = ", ".join("0x%08x" % w for w in words[i:i + WORDS_PER_LINE])
+            out.append("\t" + line + ",")
+        out.append("};")
+        out.append("")
+
+    out.append("struct File {")
+    out.append("\tconst char *path;\t\t// as passed to ReadAssetFile")
+    out.append("\tconst uint32_t *data;")
+    out.append("\tsize_t size;\t\t\t// in bytes")
+    out.append("};")
+    out.append("")
+    out.append("constexpr File FILES[] = {")
+    for f in spv_files:
+        out.append('\t{ "shaders/%s", %s, sizeof(%s) },' % (f, identifier(f), identifier(f)))
+    out.append("};")
+    out.append("")
+    out.append("}")
+    out.append("")
+
+    with open(os.path.join(here, HEADER), "w", newline="\n") as header:
+        header.write("\n".join(out))
+    print("Embedded %d shaders in %s" % (len(spv_files), HEADER))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,21 +1,54 @@
 #version 450
 
-layout(set = 1, binding = 1) uniform sampler2D texSampler;
+// Specialization constants: the lit pipeline variants (see LIT_VARIANTS)
+layout(constant_id = 0) const bool USE_TEXTURE = true;
+layout(constant_id = 1) const bool USE_LIGHTS = true;
+layout(constant_id = 2) const bool USE_SPECULAR = true;
+layout(constant_id = 3) const bool USE_HEMI_AMBIENT = true;
+layout(constant_id = 4) const float SPEC_POWER = 150.0f;
+
+layout(set = 0, binding = 1) uniform sampler2DShadow shadowMap;
+
+// every 2D texture, see MAX_TEXTURES; each object picks one with ubo.textureIndex
+const int MAX_TEXTURES = 16;
+layout(set = 0, binding = 5) uniform sampler2D textures[MAX_TEXTURES];
 
 layout(set = 0, binding = 0) uniform globalUniformBufferObject {
 	mat4 view;
 	mat4 proj;
 	vec3 ambientLight;
 	vec3 eyePos;
-	vec4 paramDecay;
-	vec3 spotlight_pos;
+	mat4 lightViewProj;
+	uvec4 clusterGrid;		// clusters along x, y, z; number of lights
+	vec4 clusterParams;		// near plane, depth slice scale, framebuffer size
 } gubo;
 
+// see GpuLight and LightClusters in ClusteredLighting.hpp
+struct Light {
+	vec4 positionRange;
+	vec4 colorType;
+	vec4 directionCosOuter;
+	vec4 params;
+};
+
+layout(std430, set = 0, binding = 2) readonly buffer LightBuffer {
+	Light lights[];
+};
+
+layout(std430, set = 0, binding = 3) readonly buffer ClusterBuffer {
+	uvec2 clusters[];		// offset and count in lightIndices
+};
+
+layout(std430, set = 0, binding = 4) readonly buffer LightIndexBuffer {
+	uint lightIndices[];
+};
+
 layout(set = 1, binding = 0) uniform UniformBufferObject {
 	mat4 model;
 	mat4 normalMatrix;
 	vec4 color;
 	float selected;
+	uint textureIndex;
 } ubo;
 
 
@@ -25,34 +58,75 @@ layout(location = 2) in vec2 fragTexCoord;
 
 layout(location = 0) out vec4 outColor;
 
-void main() {
-	vec3  diffColor = texture(texSampler, fragTexCoord).rgb * ubo.color.rgb;
-
-	vec3 lightColor_Spot = vec3(0.9f, 0.9f, 0.9f);
-	vec3 lightPos_Spot = gubo.spotlight_pos;
-	vec3 direction_Spot = - normalize(vec3(0.0f, -1.0f, 0.0f));
-
-	const vec3  specColor = vec3(0.3f, 0.3f, 0.3f);
-	const float specPower = 150.0f;
+// 1 where the spotlight reaches fragPos, 0 in shadow, 3x3 filtered
+float spotlightVisibility() {
+	vec4 lightClip = gubo.lightViewProj * vec4(fragPos, 1.0f);
+	vec3 lightNdc = lightClip.xyz / lightClip.w;
+	vec2 uv = lightNdc.xy * 0.5f + 0.5f;
+	vec2 texel = 1.0f / vec2(textureSize(shadowMap, 0));
+	float visibility = 0.0f;
+	for (int x = -1; x <= 1; x++) {
+		for (int y = -1; y <= 1; y++) {
+			visibility += texture(shadowMap, vec3(uv + vec2(x, y) * texel, lightNdc.z));
+		}
+	}
+	return visibility / 9.0f;
+}
 
+uint clusterIndex() {
+	float depth = -(gubo.view * vec4(fragPos, 1.0f)).z;
+	uint z = uint(clamp(log(depth / gubo.clusterParams.x) * gubo.clusterParams.y, 0.0f, float(gubo.clusterGrid.z - 1)));
+	uvec2 tile = min(uvec2(gl_FragCoord.xy / gubo.clusterParams.zw * vec2(gubo.clusterGrid.xy)), gubo.clusterGrid.xy - 1);
+	return (z * gubo.clusterGrid.y + tile.y) * gubo.clusterGrid.x + tile.x;
+}
 
-	vec3 lD = normalize(lightPos_Spot - fragPos); //light direction
+void main() {
+	vec3  diffColor = USE_TEXTURE ? texture(textures[ubo.textureIndex], fragTexCoord).rgb * ubo.color.rgb : ubo.color.rgb;
 
-	float decay = pow(gubo.paramDecay.x / length(lightPos_Spot - fragPos), gubo.paramDecay.y);
-	float spotlightConeFactor = clamp((dot(direction_Spot, lD) - gubo.paramDecay.w)/(gubo.paramDecay.z - gubo.paramDecay.w), 0, 1);
-	vec3 lightColor = (lightColor_Spot * decay * spotlightConeFactor) + gubo.ambientLight;
+	const vec3  specColor = vec3(0.3f, 0.3f, 0.3f);
+	const float specPower = SPEC_POWER;
 
 	vec3 N = normalize(fragNorm);
-	vec3 R = -reflect(lD, N);
-	// vec3 V = normalize(fragPos);
 	vec3 EyeDir = normalize(gubo.eyePos.xyz - fragPos);
-	
-	// Lambert diffuse
-	vec3 diffuse  = diffColor * max(dot(N,lD), 0.0f);
-	// Phong specular
-	vec3 specular = specColor * pow(max(dot(EyeDir, R), 0.0f), specPower);
+
 	// Hemispheric ambient
-	vec3 ambient  = (vec3(0.1f,0.1f, 0.1f) * (1.0f + N.y) + vec3(0.3f,0.3f,0.3f) * (1.0f - N.y)) * diffColor;
+	vec3 ambient  = USE_HEMI_AMBIENT ?
+		(vec3(0.1f,0.1f, 0.1f) * (1.0f + N.y) + vec3(0.3f,0.3f,0.3f) * (1.0f - N.y)) * diffColor :
+		vec3(0.2f) * diffColor;
+
+	vec3 color = ambient * gubo.ambientLight;
+	if (USE_LIGHTS) {
+		uvec2 cluster = clusters[clusterIndex()];
+		for (uint i = 0; i < cluster.y; i++) {
+			Light light = lights[lightIndices[cluster.x + i]];
+			vec3 toLight = light.positionRange.xyz - fragPos;
+			float distance = length(toLight);
+			vec3 lD = toLight / distance; //light direction
+
+			float decay = pow(light.params.y / distance, light.params.z);
+			// smooth cut at the range used to assign the lights to the clusters
+			float window = clamp(1.0f - pow(distance / light.positionRange.w, 4.0f), 0.0f, 1.0f);
+			vec3 lightColor = light.colorType.rgb * decay * window * window;
+			if (light.colorType.w == 1.0f) {
+				float spotlightConeFactor = clamp((dot(-light.directionCosOuter.xyz, lD) - light.directionCosOuter.w) /
+					(light.params.x - light.directionCosOuter.w), 0, 1);
+				lightColor *= spotlightConeFactor;
+			}
+			if (light.params.w == 1.0f) {
+				lightColor *= spotlightVisibility();
+			}
+
+			// Lambert diffuse
+			vec3 diffuse  = diffColor * max(dot(N,lD), 0.0f);
+			vec3 specular = vec3(0.0f);
+			if (USE_SPECULAR) {
+				vec3 R = -reflect(lD, N);
+				// Phong specular
+				specular = specColor * pow(max(dot(EyeDir, R), 0.0f), specPower);
+			}
+			color += (diffuse + specular + ambient) * lightColor;
+		}
+	}
 
-	outColor = vec4(clamp((diffuse + specular + ambient)*lightColor, vec3(0.0f), vec3(1.0f)), ubo.color.a);
-}
\ No newline at end of file
+	outColor = vec4(clamp(color, vec3(0.0f), vec3(1.0f)), ubo.color.a);
+}
@@ -10,6 +10,7 @@ layout(set = 1, binding = 0) uniform UniformBufferObject {
 	mat4 normalMatrix;
 	vec4 color;
 	float selected;
+	uint textureIndex;
 } ubo;
 
 layout(location = 0) in vec3 pos;